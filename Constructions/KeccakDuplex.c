@@ -14,6 +14,7 @@ http://creativecommons.org/publicdomain/zero/1.0/
 #include <string.h>
 #include "Constructions/KeccakDuplex.h"
 #include "KeccakF-1600/KeccakF-1600-interface.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
 #ifdef KeccakReference
 #include "Tests/displayIntermediateValues.h"
 #endif
@@ -25,85 +26,337 @@ int Keccak_DuplexInitialize(Keccak_DuplexInstance* instance,
   if ((rate <= 2) || (rate > 1600)) return 1;
   KeccakF1600_Initialize();
   instance->rate = rate;
+  instance->byteInputIndex = 0;
+  instance->byteOutputIndex = 0;
   KeccakF1600_StateInitialize(instance->state);
   return 0;
 }
 
-int Keccak_Duplexing(Keccak_DuplexInstance* instance,
-                     const unsigned char* sigmaBegin,
-                     unsigned int sigmaBeginByteLen,
-                     unsigned char* Z,
-                     unsigned int ZByteLen,
-                     unsigned char delimitedSigmaEnd) {
-  unsigned char delimitedSigmaEnd1[1];
+// XORs bytes into the state from any byte offset.
+static void Keccak_DuplexXORBytes(void* state,
+                                  const unsigned char* data,
+                                  unsigned int offset,
+                                  unsigned int length) {
+  while (length > 0) {
+    unsigned int offsetInLane = offset % KeccakF_laneInBytes;
+    unsigned int bytesInLane = KeccakF_laneInBytes - offsetInLane;
+    if (bytesInLane > length) bytesInLane = length;
+    KeccakF1600_StateXORBytesInLane(state,
+                                    offset / KeccakF_laneInBytes,
+                                    data,
+                                    offsetInLane,
+                                    bytesInLane);
+    data += bytesInLane;
+    offset += bytesInLane;
+    length -= bytesInLane;
+  }
+}
+
+// Retrieves bytes from the state from any byte offset, or XORs them into
+// data if XORFlag is set.
+static void Keccak_DuplexExtractBytes(const void* state,
+                                      unsigned char* data,
+                                      unsigned int offset,
+                                      unsigned int length,
+                                      int XORFlag) {
+  while (length > 0) {
+    unsigned int offsetInLane = offset % KeccakF_laneInBytes;
+    unsigned int bytesInLane = KeccakF_laneInBytes - offsetInLane;
+    if (bytesInLane > length) bytesInLane = length;
+    if (XORFlag)
+      KeccakF1600_StateExtractAndXORBytesInLane(state,
+                                                offset / KeccakF_laneInBytes,
+                                                data,
+                                                offsetInLane,
+                                                bytesInLane);
+    else
+      KeccakF1600_StateExtractBytesInLane(state,
+                                          offset / KeccakF_laneInBytes,
+                                          data,
+                                          offsetInLane,
+                                          bytesInLane);
+    data += bytesInLane;
+    offset += bytesInLane;
+    length -= bytesInLane;
+  }
+}
+
+// Checks the lengths and the delimited end of σ of a duplexing call, with
+// the input given since the last call with
+// Keccak_DuplexingFeedPartialInput().
+static int Keccak_DuplexingCheck(const Keccak_DuplexInstance* instance,
+                                 unsigned int sigmaBeginByteLen,
+                                 unsigned int ZByteLen,
+                                 unsigned char delimitedSigmaEnd) {
   const unsigned int rho_max = instance->rate - 2;
+  unsigned int sigmaByteLen = instance->byteInputIndex + sigmaBeginByteLen;
 
   if (delimitedSigmaEnd == 0) return 1;
-  if (sigmaBeginByteLen * 8 > rho_max) return 1;
-  if (rho_max - sigmaBeginByteLen * 8 < 7) {
-    unsigned int maxBitsInDelimitedSigmaEnd = rho_max - sigmaBeginByteLen * 8;
+  if (sigmaByteLen * 8 > rho_max) return 1;
+  if (rho_max - sigmaByteLen * 8 < 7) {
+    unsigned int maxBitsInDelimitedSigmaEnd = rho_max - sigmaByteLen * 8;
     if (delimitedSigmaEnd >= (1 << (maxBitsInDelimitedSigmaEnd + 1))) return 1;
   }
   if (ZByteLen > (instance->rate + 7) / 8)
     return 1;  // The output length must not be greater than the rate (rounded
                // up to a byte)
+  return 0;
+}
 
-  if ((sigmaBeginByteLen % KeccakF_laneInBytes) > 0) {
-    unsigned int offsetBeyondLane =
-        (sigmaBeginByteLen / KeccakF_laneInBytes) * KeccakF_laneInBytes;
-    unsigned int beyondLaneBytes = sigmaBeginByteLen % KeccakF_laneInBytes;
-    KeccakF1600_StateXORBytesInLane(instance->state,
-                                    sigmaBeginByteLen / KeccakF_laneInBytes,
-                                    sigmaBegin + offsetBeyondLane,
-                                    0,
-                                    beyondLaneBytes);
-  }
+// XORs σ and the padding into the state, except its first sigmaLaneCount
+// lanes, which the caller XORs with the permutation call.
+static void Keccak_DuplexingPad(Keccak_DuplexInstance* instance,
+                                const unsigned char* sigmaBegin,
+                                unsigned int sigmaBeginByteLen,
+                                unsigned char delimitedSigmaEnd,
+                                unsigned int sigmaLaneCount) {
+  unsigned char delimitedSigmaEnd1[1];
+  unsigned int sigmaByteLen = instance->byteInputIndex + sigmaBeginByteLen;
+
+  Keccak_DuplexXORBytes(
+      instance->state,
+      sigmaBegin + sigmaLaneCount * KeccakF_laneInBytes,
+      instance->byteInputIndex + sigmaLaneCount * KeccakF_laneInBytes,
+      sigmaBeginByteLen - sigmaLaneCount * KeccakF_laneInBytes);
 
 #ifdef KeccakReference
   {
+    // The bytes fed before were displayed by
+    // Keccak_DuplexingFeedPartialInput(), so only the rest of the block is.
     unsigned char block[KeccakF_width / 8];
-    memcpy(block, sigmaBegin, sigmaBeginByteLen);
-    block[sigmaBeginByteLen] = delimitedSigmaEnd;
-    memset(block + sigmaBeginByteLen + 1,
-           0,
-           ((instance->rate + 63) / 64) * 8 - sigmaBeginByteLen - 1);
+    unsigned int blockByteLen = (instance->rate + 7) / 8;
+    memset(block, 0, sizeof(block));
+    memcpy(block + instance->byteInputIndex, sigmaBegin, sigmaBeginByteLen);
+    block[sigmaByteLen] = delimitedSigmaEnd;
     block[(instance->rate - 1) / 8] |= 1 << ((instance->rate - 1) % 8);
-    displayBytes(1,
-                 "Block to be absorbed (after padding)",
-                 block,
-                 (instance->rate + 7) / 8);
+    if (instance->byteInputIndex == 0)
+      displayBytes(
+          1, "Block to be absorbed (after padding)", block, blockByteLen);
+    else
+      displayBytes(1,
+                   "Block to be absorbed (last part, after padding)",
+                   block + instance->byteInputIndex,
+                   blockByteLen - instance->byteInputIndex);
   }
 #endif
 
   delimitedSigmaEnd1[0] = delimitedSigmaEnd;
   // Last few bits, whose delimiter coincides with first bit of padding
   KeccakF1600_StateXORBytesInLane(instance->state,
-                                  sigmaBeginByteLen / KeccakF_laneInBytes,
+                                  sigmaByteLen / KeccakF_laneInBytes,
                                   delimitedSigmaEnd1,
-                                  sigmaBeginByteLen % KeccakF_laneInBytes,
+                                  sigmaByteLen % KeccakF_laneInBytes,
                                   1);
   // Second bit of padding
   KeccakF1600_StateComplementBit(instance->state, instance->rate - 1);
-  KeccakF1600_StateXORPermuteExtract(instance->state,
-                                     sigmaBegin,
-                                     sigmaBeginByteLen / KeccakF_laneInBytes,
-                                     Z,
-                                     ZByteLen / KeccakF_laneInBytes);
+}
+
+// Performs a duplexing call, Z receiving the output, or the output being
+// XORed into Z if ZXOR is set. The input σ starts with the bytes given
+// since the last call with Keccak_DuplexingFeedPartialInput().
+static int Keccak_DuplexingToZ(Keccak_DuplexInstance* instance,
+                               const unsigned char* sigmaBegin,
+                               unsigned int sigmaBeginByteLen,
+                               unsigned char* Z,
+                               unsigned int ZByteLen,
+                               unsigned char delimitedSigmaEnd,
+                               int ZXOR) {
+  unsigned char lastByte = 0;
+  unsigned int sigmaLaneCount;
+
+  if (Keccak_DuplexingCheck(
+          instance, sigmaBeginByteLen, ZByteLen, delimitedSigmaEnd))
+    return 1;
+
+  // Whole lanes of σ go with the permutation call if σ starts with them
+  sigmaLaneCount = (instance->byteInputIndex == 0)
+                       ? sigmaBeginByteLen / KeccakF_laneInBytes
+                       : 0;
+  Keccak_DuplexingPad(instance,
+                      sigmaBegin,
+                      sigmaBeginByteLen,
+                      delimitedSigmaEnd,
+                      sigmaLaneCount);
+  if (ZXOR) {
+    // The bits of Z beyond the rate must be left untouched
+    if (ZByteLen * 8 > instance->rate) lastByte = Z[ZByteLen - 1];
+    KeccakF1600_StateXORPermuteExtract(
+        instance->state, sigmaBegin, sigmaLaneCount, 0, 0);
+    KeccakF1600_StateExtractAndXORLanes(
+        instance->state, Z, ZByteLen / KeccakF_laneInBytes);
+  } else
+    KeccakF1600_StateXORPermuteExtract(instance->state,
+                                       sigmaBegin,
+                                       sigmaLaneCount,
+                                       Z,
+                                       ZByteLen / KeccakF_laneInBytes);
 
   if ((ZByteLen % KeccakF_laneInBytes) > 0) {
     unsigned int offsetBeyondLane =
         (ZByteLen / KeccakF_laneInBytes) * KeccakF_laneInBytes;
     unsigned int beyondLaneBytes = ZByteLen % KeccakF_laneInBytes;
-    KeccakF1600_StateExtractBytesInLane(instance->state,
-                                        ZByteLen / KeccakF_laneInBytes,
-                                        Z + offsetBeyondLane,
-                                        0,
-                                        beyondLaneBytes);
+    if (ZXOR)
+      KeccakF1600_StateExtractAndXORBytesInLane(instance->state,
+                                                ZByteLen / KeccakF_laneInBytes,
+                                                Z + offsetBeyondLane,
+                                                0,
+                                                beyondLaneBytes);
+    else
+      KeccakF1600_StateExtractBytesInLane(instance->state,
+                                          ZByteLen / KeccakF_laneInBytes,
+                                          Z + offsetBeyondLane,
+                                          0,
+                                          beyondLaneBytes);
   }
   if (ZByteLen * 8 > instance->rate) {
     unsigned char mask = (1 << (instance->rate % 8)) - 1;
-    Z[ZByteLen - 1] &= mask;
+    if (ZXOR)
+      Z[ZByteLen - 1] = lastByte ^ ((Z[ZByteLen - 1] ^ lastByte) & mask);
+    else
+      Z[ZByteLen - 1] &= mask;
+  }
+  instance->byteInputIndex = 0;
+  instance->byteOutputIndex = ZByteLen;
+
+  return 0;
+}
+
+// Gets further output bytes of the last duplexing call into data, or XORs
+// them into data if XORFlag is set.
+static int Keccak_DuplexingGetFurtherOutputToData(
+    Keccak_DuplexInstance* instance,
+    unsigned char* data,
+    unsigned int dataByteLen,
+    int XORFlag) {
+  unsigned char lastByte = 0;
+  unsigned int end = instance->byteOutputIndex + dataByteLen;
+
+  if (dataByteLen == 0) return 0;
+  if (end > (instance->rate + 7) / 8)
+    return 1;  // The output must not go beyond the rate (rounded up to a
+               // byte)
+  if (end * 8 > instance->rate) lastByte = data[dataByteLen - 1];
+  Keccak_DuplexExtractBytes(
+      instance->state, data, instance->byteOutputIndex, dataByteLen, XORFlag);
+  if (end * 8 > instance->rate) {
+    // Only the first bits of the last byte are within the rate
+    unsigned char mask = (1 << (instance->rate % 8)) - 1;
+    if (XORFlag)
+      data[dataByteLen - 1] =
+          lastByte ^ ((data[dataByteLen - 1] ^ lastByte) & mask);
+    else
+      data[dataByteLen - 1] &= mask;
   }
+  instance->byteOutputIndex = end;
+  return 0;
+}
+
+/* ---------------------------------------------------------------- */
+
+int Keccak_Duplexing(Keccak_DuplexInstance* instance,
+                     const unsigned char* sigmaBegin,
+                     unsigned int sigmaBeginByteLen,
+                     unsigned char* Z,
+                     unsigned int ZByteLen,
+                     unsigned char delimitedSigmaEnd) {
+  return Keccak_DuplexingToZ(instance,
+                             sigmaBegin,
+                             sigmaBeginByteLen,
+                             Z,
+                             ZByteLen,
+                             delimitedSigmaEnd,
+                             0);
+}
+
+int Keccak_DuplexingXOR(Keccak_DuplexInstance* instance,
+                        const unsigned char* sigmaBegin,
+                        unsigned int sigmaBeginByteLen,
+                        unsigned char* Z,
+                        unsigned int ZByteLen,
+                        unsigned char delimitedSigmaEnd) {
+  return Keccak_DuplexingToZ(instance,
+                             sigmaBegin,
+                             sigmaBeginByteLen,
+                             Z,
+                             ZByteLen,
+                             delimitedSigmaEnd,
+                             1);
+}
+
+int Keccak_DuplexingFeedPartialInput(Keccak_DuplexInstance* instance,
+                                     const unsigned char* input,
+                                     unsigned int inputByteLen) {
+  if ((instance->byteInputIndex + inputByteLen) * 8 > instance->rate - 2)
+    return 1;  // The input must leave room for the padding
+#ifdef KeccakReference
+  displayBytes(1, "Block to be absorbed (part)", input, inputByteLen);
+#endif
+  Keccak_DuplexXORBytes(
+      instance->state, input, instance->byteInputIndex, inputByteLen);
+  instance->byteInputIndex += inputByteLen;
+  return 0;
+}
+
+int Keccak_DuplexingGetFurtherOutput(Keccak_DuplexInstance* instance,
+                                     unsigned char* output,
+                                     unsigned int outputByteLen) {
+  return Keccak_DuplexingGetFurtherOutputToData(
+      instance, output, outputByteLen, 0);
+}
+
+int Keccak_DuplexingGetFurtherOutputAndXOR(Keccak_DuplexInstance* instance,
+                                           unsigned char* data,
+                                           unsigned int dataByteLen) {
+  return Keccak_DuplexingGetFurtherOutputToData(
+      instance, data, dataByteLen, 1);
+}
+
+int Keccak_DuplexingTimes4(Keccak_DuplexInstance* instances[4],
+                           const unsigned char* sigmaBegin[4],
+                           const unsigned int sigmaBeginByteLen[4],
+                           unsigned char* Z[4],
+                           const unsigned int ZByteLen[4],
+                           const unsigned char delimitedSigmaEnd[4]) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char lanes[4][KeccakF_width / 8];
+  unsigned int i;
 
+  // All calls are checked before any state is modified
+  for (i = 0; i < 4; i++)
+    if (Keccak_DuplexingCheck(instances[i],
+                              sigmaBeginByteLen[i],
+                              ZByteLen[i],
+                              delimitedSigmaEnd[i]))
+      return 1;
+
+  KeccakF1600times4_StateInitializeAll(states);
+  for (i = 0; i < 4; i++) {
+    unsigned int sigmaLaneCount =
+        (instances[i]->byteInputIndex == 0)
+            ? sigmaBeginByteLen[i] / KeccakF_laneInBytes
+            : 0;
+    Keccak_DuplexingPad(instances[i],
+                        sigmaBegin[i],
+                        sigmaBeginByteLen[i],
+                        delimitedSigmaEnd[i],
+                        sigmaLaneCount);
+    KeccakF1600_StateXORLanes(
+        instances[i]->state, sigmaBegin[i], sigmaLaneCount);
+    KeccakF1600_StateExtractLanes(instances[i]->state, lanes[i], 25);
+  }
+  // The four states are moved into the layout of KeccakF1600times4_*,
+  // permuted together and moved back
+  KeccakF1600times4_StateXORLanesAll(states, lanes[0], 25, KeccakF_width / 8);
+  KeccakF1600times4_StatePermuteAll(states);
+  KeccakF1600times4_StateExtractLanesAll(
+      states, lanes[0], 25, KeccakF_width / 8);
+  for (i = 0; i < 4; i++) {
+    KeccakF1600_StateOverwriteLanes(instances[i]->state, lanes[i], 25);
+    memcpy(Z[i], lanes[i], ZByteLen[i]);
+    if (ZByteLen[i] * 8 > instances[i]->rate)
+      Z[i][ZByteLen[i] - 1] &= (1 << (instances[i]->rate % 8)) - 1;
+    instances[i]->byteInputIndex = 0;
+    instances[i]->byteOutputIndex = ZByteLen[i];
+  }
   return 0;
 }
@@ -39,6 +39,12 @@ ALIGN typedef struct Keccak_DuplexInstanceStruct {
   ALIGN unsigned char state[KeccakF_width / 8];
   /** The value of the rate in bits.*/
   unsigned int rate;
+  /** The number of input bytes given with
+    * Keccak_DuplexingFeedPartialInput() since the last duplexing call. */
+  unsigned int byteInputIndex;
+  /** The number of output bytes of the last duplexing call already
+    * retrieved. */
+  unsigned int byteOutputIndex;
 } Keccak_DuplexInstance;
 
 /**
@@ -92,6 +98,9 @@ int Keccak_DuplexInitialize(Keccak_DuplexInstance* duplexInstance,
  * @a sigmaBegin
   *                     and the bits in @a delimitedSigmaEnd before the
  * delimiter.
+  * @note   If Keccak_DuplexingFeedPartialInput() was called since the last
+  *         duplexing call, σ starts with the bytes it was given, and the
+  *         preconditions below apply to the whole of σ.
   * @pre    @a delimitedSigmaEnd ≠ 0x00
   * @pre    @a sigmaBeginByteLen*8+<i>n</i> ≤ (r-2)
   * @pre    @a ZByteLen ≤ ceil(r/8)
@@ -104,4 +113,89 @@ int Keccak_Duplexing(Keccak_DuplexInstance* duplexInstance,
                      unsigned int ZByteLen,
                      unsigned char delimitedSigmaEnd);
 
+/**
+  * Function to make a duplexing call like Keccak_Duplexing(), except that
+  * the output is XORed into @a Z instead of being written to it, e.g., to
+  * encrypt with it as a keystream without an intermediate buffer.
+  * If @a ZByteLen*8 is greater than the rate r, the bits of the last byte
+  * of @a Z beyond the rate are left unchanged.
+  * The parameters and preconditions are the same as for Keccak_Duplexing().
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_DuplexingXOR(Keccak_DuplexInstance* duplexInstance,
+                        const unsigned char* sigmaBegin,
+                        unsigned int sigmaBeginByteLen,
+                        unsigned char* Z,
+                        unsigned int ZByteLen,
+                        unsigned char delimitedSigmaEnd);
+
+/**
+  * Function to give the first bytes of the input σ of the next duplexing
+  * call, e.g., when σ arrives in fragments. It can be called several times,
+  * the bytes being appended, and the duplexing call is then made with
+  * Keccak_Duplexing() with the remaining bytes, possibly none.
+  * @param  duplexInstance  Pointer to the duplex instance initialized
+  *                     by Keccak_DuplexInitialize().
+  * @param  input       Pointer to the input bytes.
+  * @param  inputByteLen    The number of input bytes.
+  * @pre    The total number of input bytes times 8 must be at most r-2.
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_DuplexingFeedPartialInput(Keccak_DuplexInstance* duplexInstance,
+                                     const unsigned char* input,
+                                     unsigned int inputByteLen);
+
+/**
+  * Function to retrieve further output bytes of the last duplexing call,
+  * after the bytes already given in Z and the ones retrieved by previous
+  * calls to this function.
+  * @param  duplexInstance  Pointer to the duplex instance initialized
+  *                     by Keccak_DuplexInitialize().
+  * @param  output      Pointer to the buffer where to store the output.
+  * @param  outputByteLen   The number of output bytes desired.
+  *                     If the output reaches beyond the rate r, the last
+  *                     byte contains only r modulo 8 bits, as for Z.
+  * @pre    The total number of output bytes must be at most ceil(r/8).
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_DuplexingGetFurtherOutput(Keccak_DuplexInstance* duplexInstance,
+                                     unsigned char* output,
+                                     unsigned int outputByteLen);
+
+/**
+  * Same as Keccak_DuplexingGetFurtherOutput(), except that the output is
+  * XORed into @a data.
+  */
+int Keccak_DuplexingGetFurtherOutputAndXOR(
+    Keccak_DuplexInstance* duplexInstance,
+    unsigned char* data,
+    unsigned int dataByteLen);
+
+/**
+  * Function to make a duplexing call on four distinct duplex instances at
+  * once, their states being permuted together with
+  * KeccakF1600times4_StatePermuteAll(). Each instance has its own input σ,
+  * output Z and delimited end of σ, and the effect on each is the same as
+  * that of Keccak_Duplexing(), including with respect to the input given
+  * with Keccak_DuplexingFeedPartialInput().
+  * @param  duplexInstances Array of pointers to four distinct duplex
+  *                     instances initialized by Keccak_DuplexInitialize().
+  *                     Their rates may differ.
+  * @param  sigmaBegin  Array of the first parts of the inputs σ.
+  * @param  sigmaBeginByteLen   Array of the numbers of input bytes provided
+  *                     in @a sigmaBegin.
+  * @param  Z           Array of the buffers where to store the outputs Z.
+  * @param  ZByteLen    Array of the numbers of output bytes desired.
+  * @param  delimitedSigmaEnd   Array of the delimited ends of the inputs σ.
+  * @pre    The preconditions of Keccak_Duplexing() hold for each instance.
+  * @return Zero if successful, 1 otherwise, in which case no instance is
+  *         modified.
+  */
+int Keccak_DuplexingTimes4(Keccak_DuplexInstance* duplexInstances[4],
+                           const unsigned char* sigmaBegin[4],
+                           const unsigned int sigmaBeginByteLen[4],
+                           unsigned char* Z[4],
+                           const unsigned int ZByteLen[4],
+                           const unsigned char delimitedSigmaEnd[4]);
+
 #endif
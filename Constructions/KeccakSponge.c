@@ -20,9 +20,47 @@ http://creativecommons.org/publicdomain/zero/1.0/
 
 /* ---------------------------------------------------------------- */
 
+// Applies the permutation selected by instance->rounds.
+static void Keccak_SpongePermute(Keccak_SpongeInstance* instance) {
+  if (instance->rounds == 12)
+    KeccakP1600_StatePermute12rounds(instance->state);
+  else if (instance->rounds == 14)
+    KeccakP1600_StatePermute14rounds(instance->state);
+  else
+    KeccakF1600_StatePermute(instance->state);
+}
+
+// Same as KeccakF1600_StateXORPermuteExtract(), with the permutation selected
+// by instance->rounds.
+static void Keccak_SpongeXORPermuteExtract(Keccak_SpongeInstance* instance,
+                                           const unsigned char* inData,
+                                           unsigned int inLaneCount,
+                                           unsigned char* outData,
+                                           unsigned int outLaneCount) {
+  if (instance->rounds == 12)
+    KeccakP1600_StateXORPermuteExtract12rounds(
+        instance->state, inData, inLaneCount, outData, outLaneCount);
+  else if (instance->rounds == 14)
+    KeccakP1600_StateXORPermuteExtract14rounds(
+        instance->state, inData, inLaneCount, outData, outLaneCount);
+  else
+    KeccakF1600_StateXORPermuteExtract(
+        instance->state, inData, inLaneCount, outData, outLaneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
 int Keccak_SpongeInitialize(Keccak_SpongeInstance* instance,
                             unsigned int rate,
                             unsigned int capacity) {
+  return Keccak_SpongeInitializeWithRounds(instance, rate, capacity, 24);
+}
+
+int Keccak_SpongeInitializeWithRounds(Keccak_SpongeInstance* instance,
+                                      unsigned int rate,
+                                      unsigned int capacity,
+                                      unsigned int rounds) {
+  if ((rounds != 24) && (rounds != 14) && (rounds != 12)) return 1;
   if (rate + capacity != 1600) return 1;
   if ((rate <= 0) || (rate > 1600) || ((rate % 8) != 0)) return 1;
   KeccakF1600_Initialize();
@@ -30,6 +68,7 @@ int Keccak_SpongeInitialize(Keccak_SpongeInstance* instance,
   instance->rate = rate;
   instance->byteIOIndex = 0;
   instance->squeezing = 0;
+  instance->rounds = rounds;
 
   return 0;
 }
@@ -63,8 +102,8 @@ int Keccak_SpongeAbsorb(Keccak_SpongeInstance* instance,
                   (rateInBytes / KeccakF_laneInBytes) * KeccakF_laneInBytes,
               0,
               rateInBytes % KeccakF_laneInBytes);
-        KeccakF1600_StateXORPermuteExtract(
-            instance->state, curData, rateInBytes / KeccakF_laneInBytes, 0, 0);
+        Keccak_SpongeXORPermuteExtract(
+            instance, curData, rateInBytes / KeccakF_laneInBytes, 0, 0);
         curData += rateInBytes;
       }
       i = dataByteLen - j;
@@ -102,7 +141,7 @@ int Keccak_SpongeAbsorb(Keccak_SpongeInstance* instance,
         partialBlock -= bytesInLane;
       }
       if (instance->byteIOIndex == rateInBytes) {
-        KeccakF1600_StatePermute(instance->state);
+        Keccak_SpongePermute(instance);
         instance->byteIOIndex = 0;
       }
     }
@@ -136,7 +175,7 @@ int Keccak_SpongeAbsorbLastFewBits(Keccak_SpongeInstance* instance,
   // If the first bit of padding is at position rate-1, we need a whole new
   // block for the second bit of padding
   if ((delimitedData >= 0x80) && (instance->byteIOIndex == (rateInBytes - 1)))
-    KeccakF1600_StatePermute(instance->state);
+    Keccak_SpongePermute(instance);
   // Second bit of padding
   KeccakF1600_StateComplementBit(instance->state, rateInBytes * 8 - 1);
 #ifdef KeccakReference
@@ -147,7 +186,7 @@ int Keccak_SpongeAbsorbLastFewBits(Keccak_SpongeInstance* instance,
     displayBytes(1, "Second bit of padding", block, rateInBytes);
   }
 #endif
-  KeccakF1600_StatePermute(instance->state);
+  Keccak_SpongePermute(instance);
   instance->byteIOIndex = 0;
   instance->squeezing = 1;
 #ifdef KeccakReference
@@ -175,8 +214,8 @@ int Keccak_SpongeSqueeze(Keccak_SpongeInstance* instance,
         (dataByteLen >= (i + rateInBytes))) {
       // fast lane: processing whole blocks first
       for (j = dataByteLen - i; j >= rateInBytes; j -= rateInBytes) {
-        KeccakF1600_StateXORPermuteExtract(
-            instance->state, 0, 0, curData, rateInBytes / KeccakF_laneInBytes);
+        Keccak_SpongeXORPermuteExtract(
+            instance, 0, 0, curData, rateInBytes / KeccakF_laneInBytes);
         if ((rateInBytes % KeccakF_laneInBytes) > 0)
           KeccakF1600_StateExtractBytesInLane(
               instance->state,
@@ -194,7 +233,7 @@ int Keccak_SpongeSqueeze(Keccak_SpongeInstance* instance,
     } else {
       // normal lane: using the message queue
       if (instance->byteIOIndex == rateInBytes) {
-        KeccakF1600_StatePermute(instance->state);
+        Keccak_SpongePermute(instance);
         instance->byteIOIndex = 0;
       }
       partialBlock = (unsigned int)(dataByteLen - i);
@@ -239,3 +278,159 @@ int Keccak_SpongeSqueeze(Keccak_SpongeInstance* instance,
   }
   return 0;
 }
+
+/* ---------------------------------------------------------------- */
+
+int Keccak_SpongeSqueezeXOR(Keccak_SpongeInstance* instance,
+                            unsigned char* data,
+                            unsigned long long dataByteLen) {
+  unsigned int partialBlock;
+  unsigned int rateInBytes = instance->rate / 8;
+
+  if (!instance->squeezing) Keccak_SpongeAbsorbLastFewBits(instance, 0x01);
+
+  while (dataByteLen > 0) {
+    if (instance->byteIOIndex == rateInBytes) {
+      Keccak_SpongePermute(instance);
+      instance->byteIOIndex = 0;
+    }
+    partialBlock = rateInBytes - instance->byteIOIndex;
+    if (partialBlock > dataByteLen) partialBlock = (unsigned int)dataByteLen;
+    dataByteLen -= partialBlock;
+    // Whole lanes from the start of a block, then bytes up to the end of the
+    // block or of the output
+    if ((instance->byteIOIndex == 0) &&
+        (partialBlock >= KeccakF_laneInBytes)) {
+      unsigned int laneCount = partialBlock / KeccakF_laneInBytes;
+      KeccakF1600_StateExtractAndXORLanes(instance->state, data, laneCount);
+      data += laneCount * KeccakF_laneInBytes;
+      instance->byteIOIndex += laneCount * KeccakF_laneInBytes;
+      partialBlock -= laneCount * KeccakF_laneInBytes;
+    }
+    while (partialBlock > 0) {
+      unsigned int offsetInLane = instance->byteIOIndex % KeccakF_laneInBytes;
+      unsigned int bytesInLane = KeccakF_laneInBytes - offsetInLane;
+      if (bytesInLane > partialBlock) bytesInLane = partialBlock;
+      KeccakF1600_StateExtractAndXORBytesInLane(
+          instance->state,
+          instance->byteIOIndex / KeccakF_laneInBytes,
+          data,
+          offsetInLane,
+          bytesInLane);
+      data += bytesInLane;
+      instance->byteIOIndex += bytesInLane;
+      partialBlock -= bytesInLane;
+    }
+  }
+  return 0;
+}
+
+/* ---------------------------------------------------------------- */
+
+int Keccak_SpongeAbsorbIov(Keccak_SpongeInstance* instance,
+                           const Keccak_Iovec* fragments,
+                           unsigned int fragmentCount) {
+  ALIGN unsigned char block[KeccakF_width / 8];
+  unsigned int blockByteLen = 0;
+  unsigned int rateInBytes = instance->rate / 8;
+  unsigned int f;
+
+  if (instance->squeezing) return 1;  // Too late for additional input
+
+  for (f = 0; f < fragmentCount; f++) {
+    const unsigned char* curData = fragments[f].data;
+    unsigned long long dataByteLen = fragments[f].dataByteLen;
+    while (dataByteLen > 0) {
+      unsigned long long length;
+      if (instance->byteIOIndex != 0) {
+        // Completing the block started before this call
+        length = rateInBytes - instance->byteIOIndex;
+        if (length > dataByteLen) length = dataByteLen;
+        Keccak_SpongeAbsorb(instance, curData, length);
+      } else if ((blockByteLen == 0) && (dataByteLen >= rateInBytes)) {
+        // Whole blocks within the fragment
+        length = dataByteLen - dataByteLen % rateInBytes;
+        Keccak_SpongeAbsorb(instance, curData, length);
+      } else {
+        // Gathering a block that straddles fragments
+        length = rateInBytes - blockByteLen;
+        if (length > dataByteLen) length = dataByteLen;
+        memcpy(block + blockByteLen, curData, (size_t)length);
+        blockByteLen += (unsigned int)length;
+        if (blockByteLen == rateInBytes) {
+          Keccak_SpongeAbsorb(instance, block, rateInBytes);
+          blockByteLen = 0;
+        }
+      }
+      curData += length;
+      dataByteLen -= length;
+    }
+  }
+  return Keccak_SpongeAbsorb(instance, block, blockByteLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+// Offsets of the fields in a serialized sponge instance.
+#define Keccak_SpongeSerializedVersion 1
+#define Keccak_SpongeSerializedState 1
+#define Keccak_SpongeSerializedRate 201
+#define Keccak_SpongeSerializedByteIOIndex 205
+#define Keccak_SpongeSerializedSqueezing 209
+#define Keccak_SpongeSerializedRounds 210
+
+static void Keccak_SpongeStore32(unsigned char* data, unsigned int value) {
+  unsigned int i;
+
+  for (i = 0; i < 4; i++)
+    data[i] = (unsigned char)(value >> (8 * i));
+}
+
+static unsigned int Keccak_SpongeLoad32(const unsigned char* data) {
+  unsigned int value = 0;
+  unsigned int i;
+
+  for (i = 0; i < 4; i++)
+    value |= (unsigned int)data[i] << (8 * i);
+  return value;
+}
+
+int Keccak_SpongeSerialize(const Keccak_SpongeInstance* instance,
+                           unsigned char* data) {
+  data[0] = Keccak_SpongeSerializedVersion;
+  KeccakF1600_StateExtractLanes(
+      instance->state, data + Keccak_SpongeSerializedState, 25);
+  Keccak_SpongeStore32(data + Keccak_SpongeSerializedRate, instance->rate);
+  Keccak_SpongeStore32(data + Keccak_SpongeSerializedByteIOIndex,
+                       instance->byteIOIndex);
+  data[Keccak_SpongeSerializedSqueezing] = instance->squeezing ? 1 : 0;
+  data[Keccak_SpongeSerializedRounds] = (unsigned char)instance->rounds;
+  return 0;
+}
+
+int Keccak_SpongeDeserialize(Keccak_SpongeInstance* instance,
+                             const unsigned char* data) {
+  unsigned int rate = Keccak_SpongeLoad32(data + Keccak_SpongeSerializedRate);
+  unsigned int byteIOIndex =
+      Keccak_SpongeLoad32(data + Keccak_SpongeSerializedByteIOIndex);
+  unsigned int squeezing = data[Keccak_SpongeSerializedSqueezing];
+  unsigned int rounds = data[Keccak_SpongeSerializedRounds];
+
+  if (data[0] != Keccak_SpongeSerializedVersion) return 1;
+  if ((rate == 0) || (rate > 1600) || ((rate % 8) != 0)) return 1;
+  if (squeezing > 1) return 1;
+  // The position can only reach the end of the block when squeezing
+  if (byteIOIndex > rate / 8) return 1;
+  if ((byteIOIndex == rate / 8) && !squeezing) return 1;
+  if ((rounds != 24) && (rounds != 14) && (rounds != 12)) return 1;
+
+  KeccakF1600_Initialize();
+  KeccakF1600_StateInitialize(instance->state);
+  KeccakF1600_StateXORLanes(
+      instance->state, data + Keccak_SpongeSerializedState, 25);
+  instance->rate = rate;
+  instance->byteIOIndex = byteIOIndex;
+  instance->squeezing = (int)squeezing;
+  instance->rounds = rounds;
+  return 0;
+}
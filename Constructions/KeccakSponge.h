@@ -47,6 +47,9 @@ ALIGN typedef struct Keccak_SpongeInstanceStruct {
   unsigned int byteIOIndex;
   /** If set to 0, in the absorbing phase; otherwise, in the squeezing phase. */
   int squeezing;
+  /** The number of rounds of the permutation: 24 for Keccak-f[1600], or
+   * fewer for Keccak-p[1600, rounds]. */
+  unsigned int rounds;
 } Keccak_SpongeInstance;
 
 /**
@@ -63,6 +66,21 @@ int Keccak_SpongeInitialize(Keccak_SpongeInstance* spongeInstance,
                             unsigned int rate,
                             unsigned int capacity);
 
+/**
+  * Function to initialize the state of a sponge function on top of
+  * Keccak-p[1600, rounds], the last @a rounds rounds of Keccak-f[1600].
+  * Same as Keccak_SpongeInitialize() otherwise.
+  * @param  spongeInstance  Pointer to the sponge instance to be initialized.
+  * @param  rate        The value of the rate r.
+  * @param  capacity    The value of the capacity c.
+  * @param  rounds      The number of rounds, 24 (Keccak-f[1600]), 14 or 12.
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_SpongeInitializeWithRounds(Keccak_SpongeInstance* spongeInstance,
+                                      unsigned int rate,
+                                      unsigned int capacity,
+                                      unsigned int rounds);
+
 /**
   * Function to give input data bytes for the sponge function to absorb.
   * @param  spongeInstance  Pointer to the sponge instance initialized by
@@ -125,4 +143,85 @@ int Keccak_SpongeSqueeze(Keccak_SpongeInstance* spongeInstance,
                          unsigned char* data,
                          unsigned long long dataByteLen);
 
+/**
+  * Function to squeeze output data from the sponge function and XOR it into
+  * a buffer, e.g., to use the output as a keystream.
+  * It is equivalent to Keccak_SpongeSqueeze() into a separate buffer
+  * followed by XORing that buffer into @a data, and both can be mixed on the
+  * same output stream.
+  * @param  spongeInstance  Pointer to the sponge instance initialized by
+  *                         Keccak_SpongeInitialize().
+  * @param  data        Pointer to the buffer into which to XOR the output
+  *                     data.
+  * @param  dataByteLen The number of output bytes desired.
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_SpongeSqueezeXOR(Keccak_SpongeInstance* spongeInstance,
+                            unsigned char* data,
+                            unsigned long long dataByteLen);
+
+/**
+  * Structure that describes one fragment of a message given in several
+  * fragments, as an iovec does.
+  */
+typedef struct {
+  /** Pointer to the bytes of the fragment. */
+  const unsigned char* data;
+  /** The number of bytes in the fragment. */
+  unsigned long long dataByteLen;
+} Keccak_Iovec;
+
+/**
+  * Function to give input data to be absorbed as a sequence of fragments,
+  * with the same effect as calling Keccak_SpongeAbsorb() on each of them in
+  * turn. Blocks that straddle fragments are gathered in a local buffer, so
+  * that all whole blocks go through the same fast path as contiguous data,
+  * whatever the sizes of the fragments.
+  * @param  spongeInstance  Pointer to the sponge instance initialized by
+  *                         Keccak_SpongeInitialize().
+  * @param  fragments   Pointer to the array of fragments.
+  * @param  fragmentCount   The number of fragments.
+  * @pre    The sponge function must be in the absorbing phase.
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_SpongeAbsorbIov(Keccak_SpongeInstance* spongeInstance,
+                           const Keccak_Iovec* fragments,
+                           unsigned int fragmentCount);
+
+/** The length in bytes of a serialized sponge instance. */
+#define Keccak_SpongeSerializedByteLen 211
+
+/**
+  * Function to write a snapshot of a sponge instance in a portable format,
+  * e.g., to suspend a long computation and to resume it in another process
+  * or on another machine, possibly with another implementation of
+  * Keccak-f[1600]. The snapshot consists of:
+  * - a format version byte, currently 1;
+  * - the 200 bytes of the state in the canonical order, as given by
+  *   KeccakF1600_StateExtractLanes(), whatever the representation of the
+  *   state in memory (e.g., lane complementing or bit interleaving);
+  * - the rate and the position of the next input/output byte, each on 4
+  *   bytes in little-endian order;
+  * - one byte for the phase (0 for absorbing, 1 for squeezing) and one
+  *   byte for the number of rounds.
+  * @param  spongeInstance  Pointer to the sponge instance.
+  * @param  data        Pointer to the buffer where to store the
+  *                     Keccak_SpongeSerializedByteLen bytes of the snapshot.
+  * @return Zero if successful, 1 otherwise.
+  */
+int Keccak_SpongeSerialize(const Keccak_SpongeInstance* spongeInstance,
+                           unsigned char* data);
+
+/**
+  * Function to restore a sponge instance from a snapshot written by
+  * Keccak_SpongeSerialize().
+  * @param  spongeInstance  Pointer to the sponge instance to be restored.
+  * @param  data        Pointer to the Keccak_SpongeSerializedByteLen bytes
+  *                     of the snapshot.
+  * @return Zero if successful, 1 otherwise, e.g., if the snapshot is not
+  *         consistent, in which case the instance is not modified.
+  */
+int Keccak_SpongeDeserialize(Keccak_SpongeInstance* spongeInstance,
+                             const unsigned char* data);
+
 #endif
@@ -139,6 +139,26 @@ void KeccakF1600_StateXORLanes(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateOverwriteBytesInLane(void* argState,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length) {
+  memcpy((unsigned char*)argState + lanePosition * sizeof(tKeccakLane) + offset,
+         data,
+         length);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount) {
+  memcpy(state, data, laneCount * sizeof(tKeccakLane));
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
   tKeccakLane lane = (tKeccakLane)1 << (position % 64);
   ((tKeccakLane*)state)[position / 64] ^= lane;
@@ -146,7 +166,9 @@ void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
 
 /* ---------------------------------------------------------------- */
 
-void KeccakF1600_StatePermute(void* argState) {
+// Applies the last @a nrRounds rounds of Keccak-f[1600].
+static void KeccakP1600_StatePermuteRounds(void* argState,
+                                           tSmallUInt nrRounds) {
   tSmallUInt x, y, round;
   tKeccakLane temp;
   tKeccakLane BC[5];
@@ -155,7 +177,9 @@ void KeccakF1600_StatePermute(void* argState) {
 
   state = argState;
   LFSRstate = 0x01;
-  round = cKeccakNumberOfRounds;
+  for (round = nrRounds; round < cKeccakNumberOfRounds; ++round)
+    KeccakF1600_GetNextRoundConstant(&LFSRstate);
+  round = nrRounds;
   do {
     // Theta
     for (x = 0; x < 5; ++x) {
@@ -200,6 +224,22 @@ void KeccakF1600_StatePermute(void* argState) {
   } while (--round != 0);
 }
 
+void KeccakF1600_StatePermute(void* argState) {
+  KeccakP1600_StatePermuteRounds(argState, cKeccakNumberOfRounds);
+}
+
+void KeccakP1600_StatePermute12rounds(void* argState) {
+  KeccakP1600_StatePermuteRounds(argState, 12);
+}
+
+void KeccakP1600_StatePermute14rounds(void* argState) {
+  KeccakP1600_StatePermuteRounds(argState, 14);
+}
+
+void KeccakP1600_StatePermute6rounds(void* argState) {
+  KeccakP1600_StatePermuteRounds(argState, 6);
+}
+
 /* ---------------------------------------------------------------- */
 
 void KeccakF1600_StateExtractBytesInLane(const void* state,
@@ -220,6 +260,32 @@ void KeccakF1600_StateExtractLanes(const void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length) {
+  unsigned int i;
+  const unsigned char* laneAsBytes =
+      (const unsigned char*)state + lanePosition * sizeof(tKeccakLane) + offset;
+  for (i = 0; i < length; i++)
+    data[i] ^= laneAsBytes[i];
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount) {
+  tSmallUInt i;
+  laneCount *= sizeof(tKeccakLane);
+  for (i = 0; i < laneCount; ++i) {
+    data[i] ^= ((const unsigned char*)state)[i];
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateXORPermuteExtract(void* state,
                                         const unsigned char* inData,
                                         unsigned int inLaneCount,
@@ -231,3 +297,25 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
 }
 
 /* ---------------------------------------------------------------- */
+
+void KeccakP1600_StateXORPermuteExtract12rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakF1600_StateXORLanes(state, inData, inLaneCount);
+  KeccakP1600_StatePermute12rounds(state);
+  KeccakF1600_StateExtractLanes(state, outData, outLaneCount);
+}
+
+void KeccakP1600_StateXORPermuteExtract14rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakF1600_StateXORLanes(state, inData, inLaneCount);
+  KeccakP1600_StatePermute14rounds(state);
+  KeccakF1600_StateExtractLanes(state, outData, outLaneCount);
+}
+
+/* ---------------------------------------------------------------- */
@@ -0,0 +1,80 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+// Generic versions of the state management functions that the ARM and AVR
+// assembly implementations in KeccakF-1600/Optimized/*.s do not provide,
+// built on the functions they do provide. Link this file with one of them;
+// the C implementations have their own versions.
+
+#include "KeccakF-1600/KeccakF-1600-interface.h"
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteBytesInLane(void* state,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length) {
+  unsigned char bytes[KeccakF_laneInBytes];
+  unsigned int i;
+
+  KeccakF1600_StateExtractBytesInLane(
+      state, lanePosition, bytes, offset, length);
+  for (i = 0; i < length; i++)
+    bytes[i] ^= data[i];
+  KeccakF1600_StateXORBytesInLane(state, lanePosition, bytes, offset, length);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount) {
+  unsigned int i;
+  for (i = 0; i < laneCount; i++)
+    KeccakF1600_StateOverwriteBytesInLane(state,
+                                          i,
+                                          data + i * KeccakF_laneInBytes,
+                                          0,
+                                          KeccakF_laneInBytes);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length) {
+  unsigned char bytes[KeccakF_laneInBytes];
+  unsigned int i;
+
+  KeccakF1600_StateExtractBytesInLane(
+      state, lanePosition, bytes, offset, length);
+  for (i = 0; i < length; i++)
+    data[i] ^= bytes[i];
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount) {
+  unsigned int i;
+  for (i = 0; i < laneCount; i++)
+    KeccakF1600_StateExtractAndXORBytesInLane(state,
+                                              i,
+                                              data + i * KeccakF_laneInBytes,
+                                              0,
+                                              KeccakF_laneInBytes);
+}
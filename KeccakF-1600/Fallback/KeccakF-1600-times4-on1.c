@@ -0,0 +1,190 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+// Fallback for platforms without a parallel permutation: the four states are
+// stored one after the other and processed by the single-state functions of
+// KeccakF-1600-interface.h, whichever implementation provides them.
+
+#include "KeccakF-1600/KeccakF-1600-interface.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#define stateOf(states, instanceIndex) \
+  ((unsigned char*)(states) + (instanceIndex) * (KeccakF_width / 8))
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateInitializeAll(void* states) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakF1600_StateInitialize(stateOf(states, i));
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateXORBytes(void* states,
+                                     unsigned int instanceIndex,
+                                     const unsigned char* data,
+                                     unsigned int offset,
+                                     unsigned int length) {
+  unsigned char* state = stateOf(states, instanceIndex);
+
+  while (length > 0) {
+    unsigned int offsetInLane = offset % KeccakF_laneInBytes;
+    unsigned int bytesInLane = KeccakF_laneInBytes - offsetInLane;
+    if (bytesInLane > length) bytesInLane = length;
+    KeccakF1600_StateXORBytesInLane(
+        state, offset / KeccakF_laneInBytes, data, offsetInLane, bytesInLane);
+    data += bytesInLane;
+    offset += bytesInLane;
+    length -= bytesInLane;
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateXORLanesAll(void* states,
+                                        const unsigned char* data,
+                                        unsigned int laneCount,
+                                        unsigned long long instanceStride) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakF1600_StateXORLanes(
+        stateOf(states, i), data + i * instanceStride, laneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StatePermuteAll(void* states) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakF1600_StatePermute(stateOf(states, i));
+}
+
+void KeccakP1600times4_StatePermuteAll12rounds(void* states) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakP1600_StatePermute12rounds(stateOf(states, i));
+}
+
+void KeccakP1600times4_StatePermuteAll14rounds(void* states) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakP1600_StatePermute14rounds(stateOf(states, i));
+}
+
+void KeccakP1600times4_StatePermuteAll6rounds(void* states) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakP1600_StatePermute6rounds(stateOf(states, i));
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateExtractBytes(const void* states,
+                                         unsigned int instanceIndex,
+                                         unsigned char* data,
+                                         unsigned int offset,
+                                         unsigned int length) {
+  const unsigned char* state = stateOf(states, instanceIndex);
+
+  while (length > 0) {
+    unsigned int offsetInLane = offset % KeccakF_laneInBytes;
+    unsigned int bytesInLane = KeccakF_laneInBytes - offsetInLane;
+    if (bytesInLane > length) bytesInLane = length;
+    KeccakF1600_StateExtractBytesInLane(
+        state, offset / KeccakF_laneInBytes, data, offsetInLane, bytesInLane);
+    data += bytesInLane;
+    offset += bytesInLane;
+    length -= bytesInLane;
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateExtractLanesAll(const void* states,
+                                            unsigned char* data,
+                                            unsigned int laneCount,
+                                            unsigned long long instanceStride) {
+  unsigned int i;
+  for (i = 0; i < 4; i++)
+    KeccakF1600_StateExtractLanes(
+        stateOf(states, i), data + i * instanceStride, laneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
+unsigned long long KeccakF1600times4_StateAbsorbBlocksAll(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen) {
+  unsigned long long blockByteLen = laneCount * KeccakF_laneInBytes;
+  unsigned long long blockCount = dataByteLen / blockByteLen;
+  unsigned long long j;
+  unsigned int i;
+
+  for (i = 0; i < 4; i++) {
+    const unsigned char* curData = data + i * instanceStride;
+    for (j = 0; j < blockCount; j++) {
+      KeccakF1600_StateXORPermuteExtract(
+          stateOf(states, i), curData, laneCount, 0, 0);
+      curData += blockByteLen;
+    }
+  }
+  return blockCount * blockByteLen;
+}
+
+unsigned long long KeccakP1600times4_StateAbsorbBlocksAll12rounds(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen) {
+  unsigned long long blockByteLen = laneCount * KeccakF_laneInBytes;
+  unsigned long long blockCount = dataByteLen / blockByteLen;
+  unsigned long long j;
+  unsigned int i;
+
+  for (i = 0; i < 4; i++) {
+    const unsigned char* curData = data + i * instanceStride;
+    for (j = 0; j < blockCount; j++) {
+      KeccakF1600_StateXORLanes(stateOf(states, i), curData, laneCount);
+      KeccakP1600_StatePermute12rounds(stateOf(states, i));
+      curData += blockByteLen;
+    }
+  }
+  return blockCount * blockByteLen;
+}
+
+unsigned long long KeccakP1600times4_StateAbsorbBlocksAll14rounds(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen) {
+  unsigned long long blockByteLen = laneCount * KeccakF_laneInBytes;
+  unsigned long long blockCount = dataByteLen / blockByteLen;
+  unsigned long long j;
+  unsigned int i;
+
+  for (i = 0; i < 4; i++) {
+    const unsigned char* curData = data + i * instanceStride;
+    for (j = 0; j < blockCount; j++) {
+      KeccakF1600_StateXORLanes(stateOf(states, i), curData, laneCount);
+      KeccakP1600_StatePermute14rounds(stateOf(states, i));
+      curData += blockByteLen;
+    }
+  }
+  return blockCount * blockByteLen;
+}
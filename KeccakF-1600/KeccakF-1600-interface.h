@@ -17,6 +17,17 @@ http://creativecommons.org/publicdomain/zero/1.0/
 #define KeccakF_width 1600
 #define KeccakF_laneInBytes 8
 
+// The ARM and AVR assembly implementations in KeccakF-1600/Optimized/*.s do
+// not provide KeccakF1600_StateOverwriteBytesInLane(),
+// KeccakF1600_StateOverwriteLanes(),
+// KeccakF1600_StateExtractAndXORBytesInLane() and
+// KeccakF1600_StateExtractAndXORLanes(). Link them with
+// KeccakF-1600/Fallback/KeccakF-1600-StateMgt-generic.c, which builds these
+// functions on the ones they do provide.
+// They do not provide the KeccakP1600_* functions on 6, 12 and 14 rounds
+// either, which have no generic version. As KeccakSponge.c calls them, the
+// sponge and the modes on top of it do not link with these implementations.
+
 /** Function called at least once before any use of the other KeccakF1600_*
   * functions, possibly to initialize global variables.
   */
@@ -64,6 +75,40 @@ void KeccakF1600_StateXORLanes(void* state,
                                const unsigned char* data,
                                unsigned int laneCount);
 
+/** Function to overwrite bytes of the state with data given as bytes.
+  * The bits to modify are restricted to be consecutive and to be in the same
+  * lane, as for KeccakF1600_StateXORBytesInLane().
+  * This function is typically used by duplex-based authenticated decryption,
+  * where the ciphertext replaces the rate part of the state.
+  * @param  state   Pointer to the state.
+  * @param  lanePosition    Index of the lane to be modified (x+5*y,
+  *                         or bit position divided by 64).
+  * @param  data    Pointer to the input data.
+  * @param  offset  Offset in bytes within the lane.
+  * @param  length  Number of bytes.
+  * @pre    0 ≤ @a lanePosition < 25
+  * @pre    0 ≤ @a offset < 8
+  * @pre    0 ≤ @a offset + @a length ≤ 8
+  */
+void KeccakF1600_StateOverwriteBytesInLane(void* state,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length);
+
+/** Function to overwrite whole lanes of the state with data given as bytes.
+  * The bits to modify are restricted to start from the bit position 0 and
+  * to span a whole number of lanes (i.e., multiple of 8 bytes).
+  * @param  state   Pointer to the state.
+  * @param  data    Pointer to the input data.
+  * @param  laneCount   The number of lanes, i.e., the length of the data
+  *                     divided by 64 bits.
+  * @pre    0 ≤ @a laneCount ≤ 25
+  */
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount);
+
 /** Function to complement the value of a given bit in the state.
   * This function is typically used to XOR the second bit of the multi-rate
   * padding into the state.
@@ -78,6 +123,24 @@ void KeccakF1600_StateComplementBit(void* state, unsigned int position);
   */
 void KeccakF1600_StatePermute(void* state);
 
+/** Function to apply Keccak-p[1600, 12] on the state, i.e., the last 12
+  * rounds of Keccak-f[1600], as used by KangarooTwelve.
+  * @param  state   Pointer to the state.
+  */
+void KeccakP1600_StatePermute12rounds(void* state);
+
+/** Function to apply Keccak-p[1600, 14] on the state, i.e., the last 14
+  * rounds of Keccak-f[1600], as used by MarsupilamiFourteen.
+  * @param  state   Pointer to the state.
+  */
+void KeccakP1600_StatePermute14rounds(void* state);
+
+/** Function to apply Keccak-p[1600, 6] on the state, i.e., the last 6
+  * rounds of Keccak-f[1600], as used by Kravatte.
+  * @param  state   Pointer to the state.
+  */
+void KeccakP1600_StatePermute6rounds(void* state);
+
 /** Function to retrieve data from the state into bytes.
   * The bits to output are restricted to be consecutive and to be in the same
  * lane.
@@ -115,6 +178,40 @@ void KeccakF1600_StateExtractLanes(const void* state,
                                    unsigned char* data,
                                    unsigned int laneCount);
 
+/** Function to retrieve data from the state and XOR it into bytes.
+  * The bits to output are restricted to be consecutive and to be in the same
+  * lane, as for KeccakF1600_StateExtractBytesInLane().
+  * This function is typically used to apply a keystream to a buffer without
+  * squeezing it into a separate buffer first.
+  * @param  state   Pointer to the state.
+  * @param  lanePosition    Index of the lane to be read (x+5*y,
+  *                         or bit position divided by 64).
+  * @param  data    Pointer to the data into which to XOR the output.
+  * @param  offset  Offset in byte within the lane.
+  * @param  length  Number of bytes.
+  * @pre    0 ≤ @a lanePosition < 25
+  * @pre    0 ≤ @a offset < 8
+  * @pre    0 ≤ @a offset + @a length ≤ 8
+  */
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length);
+
+/** Function to retrieve whole lanes from the state and XOR them into bytes.
+  * The bits to output are restricted to start from the bit position 0 and
+  * to span a whole number of lanes (i.e., multiple of 8 bytes).
+  * @param  state   Pointer to the state.
+  * @param  data    Pointer to the data into which to XOR the output.
+  * @param  laneCount   The number of lanes, i.e., the length of the data
+  *                     divided by 64 bits.
+  * @pre    0 ≤ @a laneCount ≤ 25
+  */
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount);
+
 /** Function to sequentially XOR data bytes, apply the Keccak-f[1600]
   * permutation and retrieve data bytes from the state.
   * The bits to modify and to output are restricted to start from the bit
@@ -140,4 +237,22 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
                                         unsigned char* outData,
                                         unsigned int outLaneCount);
 
+/** Same as KeccakF1600_StateXORPermuteExtract(), but with Keccak-p[1600, 12]
+  * instead of Keccak-f[1600].
+  */
+void KeccakP1600_StateXORPermuteExtract12rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount);
+
+/** Same as KeccakF1600_StateXORPermuteExtract(), but with Keccak-p[1600, 14]
+  * instead of Keccak-f[1600].
+  */
+void KeccakP1600_StateXORPermuteExtract14rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount);
+
 #endif
@@ -0,0 +1,166 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KeccakF1600times4Interface_h_
+#define _KeccakF1600times4Interface_h_
+
+#include "KeccakF-1600/KeccakF-1600-interface.h"
+
+/** The number of Keccak-f[1600] instances processed in parallel. */
+#define KeccakF1600times4_parallelism 4
+
+/** The size in bytes of the memory holding the four states. The layout of
+  * the states within this memory is implementation-defined and must only be
+  * accessed through the KeccakF1600times4_* functions.
+  */
+#define KeccakF1600times4_statesSizeInBytes (4 * KeccakF_width / 8)
+
+/** Function to initialize the four states to the logical value 0^1600.
+  * KeccakF1600_Initialize() must have been called before.
+  * @param  states  Pointer to the states to initialize, 32-byte aligned.
+  */
+void KeccakF1600times4_StateInitializeAll(void* states);
+
+/** Function to XOR data given as bytes into one of the states.
+  * Unlike KeccakF1600_StateXORBytesInLane(), the bytes may span several
+  * lanes.
+  * @param  states  Pointer to the states.
+  * @param  instanceIndex   Index of the state to be modified.
+  * @param  data    Pointer to the input data.
+  * @param  offset  Offset in bytes within the state.
+  * @param  length  Number of bytes.
+  * @pre    0 ≤ @a instanceIndex < 4
+  * @pre    0 ≤ @a offset + @a length ≤ 200
+  */
+void KeccakF1600times4_StateXORBytes(void* states,
+                                     unsigned int instanceIndex,
+                                     const unsigned char* data,
+                                     unsigned int offset,
+                                     unsigned int length);
+
+/** Function to XOR whole lanes into all four states.
+  * The input for the state of index i starts at @a data + i*@a instanceStride.
+  * @param  states  Pointer to the states.
+  * @param  data    Pointer to the input data.
+  * @param  laneCount   The number of lanes to XOR into each state.
+  * @param  instanceStride  The distance in bytes between the inputs of two
+  *                         consecutive states.
+  * @pre    0 ≤ @a laneCount ≤ 25
+  */
+void KeccakF1600times4_StateXORLanesAll(void* states,
+                                        const unsigned char* data,
+                                        unsigned int laneCount,
+                                        unsigned long long instanceStride);
+
+/** Function to apply Keccak-f[1600] on the four states.
+  * @param  states  Pointer to the states.
+  */
+void KeccakF1600times4_StatePermuteAll(void* states);
+
+/** Function to apply Keccak-p[1600, 12] on the four states.
+  * @param  states  Pointer to the states.
+  */
+void KeccakP1600times4_StatePermuteAll12rounds(void* states);
+
+/** Function to apply Keccak-p[1600, 14] on the four states.
+  * @param  states  Pointer to the states.
+  */
+void KeccakP1600times4_StatePermuteAll14rounds(void* states);
+
+/** Function to apply Keccak-p[1600, 6] on the four states.
+  * @param  states  Pointer to the states.
+  */
+void KeccakP1600times4_StatePermuteAll6rounds(void* states);
+
+/** Function to retrieve data from one of the states into bytes.
+  * Unlike KeccakF1600_StateExtractBytesInLane(), the bytes may span several
+  * lanes.
+  * @param  states  Pointer to the states.
+  * @param  instanceIndex   Index of the state to be read.
+  * @param  data    Pointer to the area where to store output data.
+  * @param  offset  Offset in bytes within the state.
+  * @param  length  Number of bytes.
+  * @pre    0 ≤ @a instanceIndex < 4
+  * @pre    0 ≤ @a offset + @a length ≤ 200
+  */
+void KeccakF1600times4_StateExtractBytes(const void* states,
+                                         unsigned int instanceIndex,
+                                         unsigned char* data,
+                                         unsigned int offset,
+                                         unsigned int length);
+
+/** Function to retrieve whole lanes from all four states.
+  * The output of the state of index i is written at
+  * @a data + i*@a instanceStride.
+  * @param  states  Pointer to the states.
+  * @param  data    Pointer to the area where to store output data.
+  * @param  laneCount   The number of lanes to extract from each state.
+  * @param  instanceStride  The distance in bytes between the outputs of two
+  *                         consecutive states.
+  * @pre    0 ≤ @a laneCount ≤ 25
+  */
+void KeccakF1600times4_StateExtractLanesAll(const void* states,
+                                            unsigned char* data,
+                                            unsigned int laneCount,
+                                            unsigned long long instanceStride);
+
+/** Function to absorb whole blocks into all four states in parallel.
+  * Each state absorbs its own stream of consecutive blocks of @a laneCount
+  * lanes, the stream of the state of index i starting at
+  * @a data + i*@a instanceStride. As many whole blocks as fit in
+  * @a dataByteLen bytes are absorbed into each state, each block being
+  * followed by an application of Keccak-f[1600].
+  * Its effect should be functionally identical to calling, as long as a
+  * whole block remains:
+  * - KeccakF1600times4_StateXORLanesAll(states, data, laneCount,
+  *   instanceStride);
+  * - KeccakF1600times4_StatePermuteAll(states);
+  * - data += laneCount*8;
+  * @param  states  Pointer to the states.
+  * @param  laneCount   The number of lanes per block, i.e., the rate divided
+  *                     by 64 bits.
+  * @param  data    Pointer to the input data.
+  * @param  instanceStride  The distance in bytes between the streams of two
+  *                         consecutive states.
+  * @param  dataByteLen The number of bytes available in each stream.
+  * @pre    0 < @a laneCount ≤ 25
+  * @return The number of bytes absorbed into each state.
+  */
+unsigned long long KeccakF1600times4_StateAbsorbBlocksAll(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen);
+
+/** Same as KeccakF1600times4_StateAbsorbBlocksAll(), but with Keccak-p[1600,
+  * 12] instead of Keccak-f[1600].
+  */
+unsigned long long KeccakP1600times4_StateAbsorbBlocksAll12rounds(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen);
+
+/** Same as KeccakF1600times4_StateAbsorbBlocksAll(), but with Keccak-p[1600,
+  * 14] instead of Keccak-f[1600].
+  */
+unsigned long long KeccakP1600times4_StateAbsorbBlocksAll14rounds(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen);
+
+#endif
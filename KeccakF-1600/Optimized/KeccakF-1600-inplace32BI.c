@@ -124,6 +124,50 @@ void KeccakF1600_StateXORLanes(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateOverwriteBytesInLane(void* state,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length) {
+  uint8_t laneAsBytes[8];
+  uint32_t low, high;
+  uint32_t temp, temp0, temp1;
+  uint32_t* stateAsHalfLanes = (uint32_t*)state;
+
+  fromBitInterleaving(stateAsHalfLanes[lanePosition * 2],
+                      stateAsHalfLanes[lanePosition * 2 + 1],
+                      low,
+                      high,
+                      temp,
+                      temp0,
+                      temp1);
+  memcpy(laneAsBytes + 0, &low, 4);
+  memcpy(laneAsBytes + 4, &high, 4);
+  memcpy(laneAsBytes + offset, data, length);
+  memcpy(&low, laneAsBytes + 0, 4);
+  memcpy(&high, laneAsBytes + 4, 4);
+  stateAsHalfLanes[lanePosition * 2 + 0] = 0;
+  stateAsHalfLanes[lanePosition * 2 + 1] = 0;
+  toBitInterleavingAndXOR(low,
+                          high,
+                          stateAsHalfLanes[lanePosition * 2 + 0],
+                          stateAsHalfLanes[lanePosition * 2 + 1],
+                          temp,
+                          temp0,
+                          temp1);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount) {
+  memset(state, 0, laneCount * 8);
+  KeccakF1600_StateXORLanes(state, data, laneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
   uint32_t* stateAsHalfLanes = (uint32_t*)state;
   unsigned int lanePosition = position / 64;
@@ -181,6 +225,52 @@ void KeccakF1600_StateExtractLanes(const void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length) {
+  uint32_t* stateAsHalfLanes = (uint32_t*)state;
+  uint32_t low, high, temp, temp0, temp1;
+  uint8_t laneAsBytes[8];
+  unsigned int i;
+
+  fromBitInterleaving(stateAsHalfLanes[lanePosition * 2],
+                      stateAsHalfLanes[lanePosition * 2 + 1],
+                      low,
+                      high,
+                      temp,
+                      temp0,
+                      temp1);
+  memcpy(laneAsBytes + 0, &low, 4);
+  memcpy(laneAsBytes + 4, &high, 4);
+  for (i = 0; i < length; i++)
+    data[i] ^= laneAsBytes[offset + i];
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount) {
+  const uint32_t* pS = state;
+  uint32_t t, x0, x1;
+  int i;
+  for (i = laneCount - 1; i >= 0; --i) {
+    uint32_t low, high, in;
+    fromBitInterleaving(*(pS++), *(pS++), low, high, t, x0, x1);
+    memcpy(&in, data, 4);
+    low ^= in;
+    memcpy(data, &low, 4);
+    memcpy(&in, data + 4, 4);
+    high ^= in;
+    memcpy(data + 4, &high, 4);
+    data += 8;
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
 static const uint32_t KeccakF1600RoundConstants_int2[2 * 24 + 1] = {
     0x00000001UL, 0x00000000UL, 0x00000000UL, 0x00000089UL, 0x00000000UL,
     0x8000008bUL, 0x00000000UL, 0x80008080UL, 0x00000001UL, 0x0000008bUL,
@@ -193,6 +283,30 @@ static const uint32_t KeccakF1600RoundConstants_int2[2 * 24 + 1] = {
     0x00000001UL, 0x80008088UL, 0x00000000UL, 0x80000088UL, 0x00000001UL,
     0x00008000UL, 0x00000000UL, 0x80008082UL, 0x000000FFUL};
 
+// The loop below does not store the lanes at their nominal position between
+// its rounds. This gives, for each half-lane position, the half-lane that is
+// stored there after the first two rounds of the loop. As this mapping is an
+// involution, swapping the pairs it defines brings a state in the nominal
+// layout to the one expected by the third round of the loop.
+static const unsigned char KeccakP1600_halfLanesAfter2Rounds[50] = {
+    0,  1,  33, 32, 15, 14, 47, 46, 29, 28, 41, 40, 23, 22, 5,  4,  37,
+    36, 18, 19, 31, 30, 13, 12, 45, 44, 26, 27, 9,  8,  21, 20, 3,  2,
+    34, 35, 17, 16, 49, 48, 11, 10, 42, 43, 25, 24, 7,  6,  39, 38};
+
+static void KeccakP1600_ToLayoutAfter2Rounds(uint32_t* stateAsHalfLanes) {
+  unsigned int i, j;
+  uint32_t t;
+
+  for (i = 0; i < 50; i++) {
+    j = KeccakP1600_halfLanesAfter2Rounds[i];
+    if (j > i) {
+      t = stateAsHalfLanes[i];
+      stateAsHalfLanes[i] = stateAsHalfLanes[j];
+      stateAsHalfLanes[j] = t;
+    }
+  }
+}
+
 #define KeccakAtoD_round0()               \
   Cx = Abu0 ^ Agu0 ^ Aku0 ^ Amu0 ^ Asu0;  \
   Du1 = Abe1 ^ Age1 ^ Ake1 ^ Ame1 ^ Ase1; \
@@ -297,11 +411,474 @@ static const uint32_t KeccakF1600RoundConstants_int2[2 * 24 + 1] = {
   Du0 = Cw ^ ROL32(Cz, 1);                \
   Du1 = Cy ^ Cx;
 
-void KeccakF1600_StateXORPermuteExtract(void* state,
-                                        const unsigned char* inData,
-                                        unsigned int inLaneCount,
-                                        unsigned char* outData,
-                                        unsigned int outLaneCount) {
+#define KeccakRounds0and1()     \
+  KeccakAtoD_round0();          \
+                                \
+  Ba = (Aba0 ^ Da0);            \
+  Be = ROL32((Age0 ^ De0), 22); \
+  Bi = ROL32((Aki1 ^ Di1), 22); \
+  Bo = ROL32((Amo1 ^ Do1), 11); \
+  Bu = ROL32((Asu0 ^ Du0), 7);  \
+  Aba0 = Ba ^ ((~Be) & Bi);     \
+  Aba0 ^= *(pRoundConstants++); \
+  Age0 = Be ^ ((~Bi) & Bo);     \
+  Aki1 = Bi ^ ((~Bo) & Bu);     \
+  Amo1 = Bo ^ ((~Bu) & Ba);     \
+  Asu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Ba = (Aba1 ^ Da1);            \
+  Be = ROL32((Age1 ^ De1), 22); \
+  Bi = ROL32((Aki0 ^ Di0), 21); \
+  Bo = ROL32((Amo0 ^ Do0), 10); \
+  Bu = ROL32((Asu1 ^ Du1), 7);  \
+  Aba1 = Ba ^ ((~Be) & Bi);     \
+  Aba1 ^= *(pRoundConstants++); \
+  Age1 = Be ^ ((~Bi) & Bo);     \
+  Aki0 = Bi ^ ((~Bo) & Bu);     \
+  Amo0 = Bo ^ ((~Bu) & Ba);     \
+  Asu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Aka1 ^ Da1), 2);  \
+  Bo = ROL32((Ame1 ^ De1), 23); \
+  Bu = ROL32((Asi1 ^ Di1), 31); \
+  Ba = ROL32((Abo0 ^ Do0), 14); \
+  Be = ROL32((Agu0 ^ Du0), 10); \
+  Aka1 = Ba ^ ((~Be) & Bi);     \
+  Ame1 = Be ^ ((~Bi) & Bo);     \
+  Asi1 = Bi ^ ((~Bo) & Bu);     \
+  Abo0 = Bo ^ ((~Bu) & Ba);     \
+  Agu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Aka0 ^ Da0), 1);  \
+  Bo = ROL32((Ame0 ^ De0), 22); \
+  Bu = ROL32((Asi0 ^ Di0), 30); \
+  Ba = ROL32((Abo1 ^ Do1), 14); \
+  Be = ROL32((Agu1 ^ Du1), 10); \
+  Aka0 = Ba ^ ((~Be) & Bi);     \
+  Ame0 = Be ^ ((~Bi) & Bo);     \
+  Asi0 = Bi ^ ((~Bo) & Bu);     \
+  Abo1 = Bo ^ ((~Bu) & Ba);     \
+  Agu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Asa0 ^ Da0), 9);  \
+  Ba = ROL32((Abe1 ^ De1), 1);  \
+  Be = ROL32((Agi0 ^ Di0), 3);  \
+  Bi = ROL32((Ako1 ^ Do1), 13); \
+  Bo = ROL32((Amu0 ^ Du0), 4);  \
+  Asa0 = Ba ^ ((~Be) & Bi);     \
+  Abe1 = Be ^ ((~Bi) & Bo);     \
+  Agi0 = Bi ^ ((~Bo) & Bu);     \
+  Ako1 = Bo ^ ((~Bu) & Ba);     \
+  Amu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Asa1 ^ Da1), 9);  \
+  Ba = (Abe0 ^ De0);            \
+  Be = ROL32((Agi1 ^ Di1), 3);  \
+  Bi = ROL32((Ako0 ^ Do0), 12); \
+  Bo = ROL32((Amu1 ^ Du1), 4);  \
+  Asa1 = Ba ^ ((~Be) & Bi);     \
+  Abe0 = Be ^ ((~Bi) & Bo);     \
+  Agi1 = Bi ^ ((~Bo) & Bu);     \
+  Ako0 = Bo ^ ((~Bu) & Ba);     \
+  Amu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Aga0 ^ Da0), 18); \
+  Bi = ROL32((Ake0 ^ De0), 5);  \
+  Bo = ROL32((Ami1 ^ Di1), 8);  \
+  Bu = ROL32((Aso0 ^ Do0), 28); \
+  Ba = ROL32((Abu1 ^ Du1), 14); \
+  Aga0 = Ba ^ ((~Be) & Bi);     \
+  Ake0 = Be ^ ((~Bi) & Bo);     \
+  Ami1 = Bi ^ ((~Bo) & Bu);     \
+  Aso0 = Bo ^ ((~Bu) & Ba);     \
+  Abu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Aga1 ^ Da1), 18); \
+  Bi = ROL32((Ake1 ^ De1), 5);  \
+  Bo = ROL32((Ami0 ^ Di0), 7);  \
+  Bu = ROL32((Aso1 ^ Do1), 28); \
+  Ba = ROL32((Abu0 ^ Du0), 13); \
+  Aga1 = Ba ^ ((~Be) & Bi);     \
+  Ake1 = Be ^ ((~Bi) & Bo);     \
+  Ami0 = Bi ^ ((~Bo) & Bu);     \
+  Aso1 = Bo ^ ((~Bu) & Ba);     \
+  Abu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Ama1 ^ Da1), 21); \
+  Bu = ROL32((Ase0 ^ De0), 1);  \
+  Ba = ROL32((Abi0 ^ Di0), 31); \
+  Be = ROL32((Ago1 ^ Do1), 28); \
+  Bi = ROL32((Aku1 ^ Du1), 20); \
+  Ama1 = Ba ^ ((~Be) & Bi);     \
+  Ase0 = Be ^ ((~Bi) & Bo);     \
+  Abi0 = Bi ^ ((~Bo) & Bu);     \
+  Ago1 = Bo ^ ((~Bu) & Ba);     \
+  Aku1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Ama0 ^ Da0), 20); \
+  Bu = ROL32((Ase1 ^ De1), 1);  \
+  Ba = ROL32((Abi1 ^ Di1), 31); \
+  Be = ROL32((Ago0 ^ Do0), 27); \
+  Bi = ROL32((Aku0 ^ Du0), 19); \
+  Ama0 = Ba ^ ((~Be) & Bi);     \
+  Ase1 = Be ^ ((~Bi) & Bo);     \
+  Abi1 = Bi ^ ((~Bo) & Bu);     \
+  Ago0 = Bo ^ ((~Bu) & Ba);     \
+  Aku0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  KeccakAtoD_round1();          \
+                                \
+  Ba = (Aba0 ^ Da0);            \
+  Be = ROL32((Ame1 ^ De0), 22); \
+  Bi = ROL32((Agi1 ^ Di1), 22); \
+  Bo = ROL32((Aso1 ^ Do1), 11); \
+  Bu = ROL32((Aku1 ^ Du0), 7);  \
+  Aba0 = Ba ^ ((~Be) & Bi);     \
+  Aba0 ^= *(pRoundConstants++); \
+  Ame1 = Be ^ ((~Bi) & Bo);     \
+  Agi1 = Bi ^ ((~Bo) & Bu);     \
+  Aso1 = Bo ^ ((~Bu) & Ba);     \
+  Aku1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Ba = (Aba1 ^ Da1);            \
+  Be = ROL32((Ame0 ^ De1), 22); \
+  Bi = ROL32((Agi0 ^ Di0), 21); \
+  Bo = ROL32((Aso0 ^ Do0), 10); \
+  Bu = ROL32((Aku0 ^ Du1), 7);  \
+  Aba1 = Ba ^ ((~Be) & Bi);     \
+  Aba1 ^= *(pRoundConstants++); \
+  Ame0 = Be ^ ((~Bi) & Bo);     \
+  Agi0 = Bi ^ ((~Bo) & Bu);     \
+  Aso0 = Bo ^ ((~Bu) & Ba);     \
+  Aku0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Asa1 ^ Da1), 2);  \
+  Bo = ROL32((Ake1 ^ De1), 23); \
+  Bu = ROL32((Abi1 ^ Di1), 31); \
+  Ba = ROL32((Amo1 ^ Do0), 14); \
+  Be = ROL32((Agu0 ^ Du0), 10); \
+  Asa1 = Ba ^ ((~Be) & Bi);     \
+  Ake1 = Be ^ ((~Bi) & Bo);     \
+  Abi1 = Bi ^ ((~Bo) & Bu);     \
+  Amo1 = Bo ^ ((~Bu) & Ba);     \
+  Agu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Asa0 ^ Da0), 1);  \
+  Bo = ROL32((Ake0 ^ De0), 22); \
+  Bu = ROL32((Abi0 ^ Di0), 30); \
+  Ba = ROL32((Amo0 ^ Do1), 14); \
+  Be = ROL32((Agu1 ^ Du1), 10); \
+  Asa0 = Ba ^ ((~Be) & Bi);     \
+  Ake0 = Be ^ ((~Bi) & Bo);     \
+  Abi0 = Bi ^ ((~Bo) & Bu);     \
+  Amo0 = Bo ^ ((~Bu) & Ba);     \
+  Agu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Ama1 ^ Da0), 9);  \
+  Ba = ROL32((Age1 ^ De1), 1);  \
+  Be = ROL32((Asi1 ^ Di0), 3);  \
+  Bi = ROL32((Ako0 ^ Do1), 13); \
+  Bo = ROL32((Abu1 ^ Du0), 4);  \
+  Ama1 = Ba ^ ((~Be) & Bi);     \
+  Age1 = Be ^ ((~Bi) & Bo);     \
+  Asi1 = Bi ^ ((~Bo) & Bu);     \
+  Ako0 = Bo ^ ((~Bu) & Ba);     \
+  Abu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Ama0 ^ Da1), 9);  \
+  Ba = (Age0 ^ De0);            \
+  Be = ROL32((Asi0 ^ Di1), 3);  \
+  Bi = ROL32((Ako1 ^ Do0), 12); \
+  Bo = ROL32((Abu0 ^ Du1), 4);  \
+  Ama0 = Ba ^ ((~Be) & Bi);     \
+  Age0 = Be ^ ((~Bi) & Bo);     \
+  Asi0 = Bi ^ ((~Bo) & Bu);     \
+  Ako1 = Bo ^ ((~Bu) & Ba);     \
+  Abu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Aka1 ^ Da0), 18); \
+  Bi = ROL32((Abe1 ^ De0), 5);  \
+  Bo = ROL32((Ami0 ^ Di1), 8);  \
+  Bu = ROL32((Ago1 ^ Do0), 28); \
+  Ba = ROL32((Asu1 ^ Du1), 14); \
+  Aka1 = Ba ^ ((~Be) & Bi);     \
+  Abe1 = Be ^ ((~Bi) & Bo);     \
+  Ami0 = Bi ^ ((~Bo) & Bu);     \
+  Ago1 = Bo ^ ((~Bu) & Ba);     \
+  Asu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Aka0 ^ Da1), 18); \
+  Bi = ROL32((Abe0 ^ De1), 5);  \
+  Bo = ROL32((Ami1 ^ Di0), 7);  \
+  Bu = ROL32((Ago0 ^ Do1), 28); \
+  Ba = ROL32((Asu0 ^ Du0), 13); \
+  Aka0 = Ba ^ ((~Be) & Bi);     \
+  Abe0 = Be ^ ((~Bi) & Bo);     \
+  Ami1 = Bi ^ ((~Bo) & Bu);     \
+  Ago0 = Bo ^ ((~Bu) & Ba);     \
+  Asu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Aga1 ^ Da1), 21); \
+  Bu = ROL32((Ase0 ^ De0), 1);  \
+  Ba = ROL32((Aki1 ^ Di0), 31); \
+  Be = ROL32((Abo1 ^ Do1), 28); \
+  Bi = ROL32((Amu1 ^ Du1), 20); \
+  Aga1 = Ba ^ ((~Be) & Bi);     \
+  Ase0 = Be ^ ((~Bi) & Bo);     \
+  Aki1 = Bi ^ ((~Bo) & Bu);     \
+  Abo1 = Bo ^ ((~Bu) & Ba);     \
+  Amu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Aga0 ^ Da0), 20); \
+  Bu = ROL32((Ase1 ^ De1), 1);  \
+  Ba = ROL32((Aki0 ^ Di1), 31); \
+  Be = ROL32((Abo0 ^ Do0), 27); \
+  Bi = ROL32((Amu0 ^ Du0), 19); \
+  Aga0 = Ba ^ ((~Be) & Bi);     \
+  Ase1 = Be ^ ((~Bi) & Bo);     \
+  Aki0 = Bi ^ ((~Bo) & Bu);     \
+  Abo0 = Bo ^ ((~Bu) & Ba);     \
+  Amu0 = Bu ^ ((~Ba) & Be);
+
+#define KeccakRounds2and3()     \
+  KeccakAtoD_round2();          \
+                                \
+  Ba = (Aba0 ^ Da0);            \
+  Be = ROL32((Ake1 ^ De0), 22); \
+  Bi = ROL32((Asi0 ^ Di1), 22); \
+  Bo = ROL32((Ago0 ^ Do1), 11); \
+  Bu = ROL32((Amu1 ^ Du0), 7);  \
+  Aba0 = Ba ^ ((~Be) & Bi);     \
+  Aba0 ^= *(pRoundConstants++); \
+  Ake1 = Be ^ ((~Bi) & Bo);     \
+  Asi0 = Bi ^ ((~Bo) & Bu);     \
+  Ago0 = Bo ^ ((~Bu) & Ba);     \
+  Amu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Ba = (Aba1 ^ Da1);            \
+  Be = ROL32((Ake0 ^ De1), 22); \
+  Bi = ROL32((Asi1 ^ Di0), 21); \
+  Bo = ROL32((Ago1 ^ Do0), 10); \
+  Bu = ROL32((Amu0 ^ Du1), 7);  \
+  Aba1 = Ba ^ ((~Be) & Bi);     \
+  Aba1 ^= *(pRoundConstants++); \
+  Ake0 = Be ^ ((~Bi) & Bo);     \
+  Asi1 = Bi ^ ((~Bo) & Bu);     \
+  Ago1 = Bo ^ ((~Bu) & Ba);     \
+  Amu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Ama0 ^ Da1), 2);  \
+  Bo = ROL32((Abe0 ^ De1), 23); \
+  Bu = ROL32((Aki0 ^ Di1), 31); \
+  Ba = ROL32((Aso1 ^ Do0), 14); \
+  Be = ROL32((Agu0 ^ Du0), 10); \
+  Ama0 = Ba ^ ((~Be) & Bi);     \
+  Abe0 = Be ^ ((~Bi) & Bo);     \
+  Aki0 = Bi ^ ((~Bo) & Bu);     \
+  Aso1 = Bo ^ ((~Bu) & Ba);     \
+  Agu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Ama1 ^ Da0), 1);  \
+  Bo = ROL32((Abe1 ^ De0), 22); \
+  Bu = ROL32((Aki1 ^ Di0), 30); \
+  Ba = ROL32((Aso0 ^ Do1), 14); \
+  Be = ROL32((Agu1 ^ Du1), 10); \
+  Ama1 = Ba ^ ((~Be) & Bi);     \
+  Abe1 = Be ^ ((~Bi) & Bo);     \
+  Aki1 = Bi ^ ((~Bo) & Bu);     \
+  Aso0 = Bo ^ ((~Bu) & Ba);     \
+  Agu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Aga1 ^ Da0), 9);  \
+  Ba = ROL32((Ame0 ^ De1), 1);  \
+  Be = ROL32((Abi1 ^ Di0), 3);  \
+  Bi = ROL32((Ako1 ^ Do1), 13); \
+  Bo = ROL32((Asu1 ^ Du0), 4);  \
+  Aga1 = Ba ^ ((~Be) & Bi);     \
+  Ame0 = Be ^ ((~Bi) & Bo);     \
+  Abi1 = Bi ^ ((~Bo) & Bu);     \
+  Ako1 = Bo ^ ((~Bu) & Ba);     \
+  Asu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Aga0 ^ Da1), 9);  \
+  Ba = (Ame1 ^ De0);            \
+  Be = ROL32((Abi0 ^ Di1), 3);  \
+  Bi = ROL32((Ako0 ^ Do0), 12); \
+  Bo = ROL32((Asu0 ^ Du1), 4);  \
+  Aga0 = Ba ^ ((~Be) & Bi);     \
+  Ame1 = Be ^ ((~Bi) & Bo);     \
+  Abi0 = Bi ^ ((~Bo) & Bu);     \
+  Ako0 = Bo ^ ((~Bu) & Ba);     \
+  Asu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Asa1 ^ Da0), 18); \
+  Bi = ROL32((Age1 ^ De0), 5);  \
+  Bo = ROL32((Ami1 ^ Di1), 8);  \
+  Bu = ROL32((Abo1 ^ Do0), 28); \
+  Ba = ROL32((Aku0 ^ Du1), 14); \
+  Asa1 = Ba ^ ((~Be) & Bi);     \
+  Age1 = Be ^ ((~Bi) & Bo);     \
+  Ami1 = Bi ^ ((~Bo) & Bu);     \
+  Abo1 = Bo ^ ((~Bu) & Ba);     \
+  Aku0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Asa0 ^ Da1), 18); \
+  Bi = ROL32((Age0 ^ De1), 5);  \
+  Bo = ROL32((Ami0 ^ Di0), 7);  \
+  Bu = ROL32((Abo0 ^ Do1), 28); \
+  Ba = ROL32((Aku1 ^ Du0), 13); \
+  Asa0 = Ba ^ ((~Be) & Bi);     \
+  Age0 = Be ^ ((~Bi) & Bo);     \
+  Ami0 = Bi ^ ((~Bo) & Bu);     \
+  Abo0 = Bo ^ ((~Bu) & Ba);     \
+  Aku1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Aka0 ^ Da1), 21); \
+  Bu = ROL32((Ase0 ^ De0), 1);  \
+  Ba = ROL32((Agi1 ^ Di0), 31); \
+  Be = ROL32((Amo0 ^ Do1), 28); \
+  Bi = ROL32((Abu0 ^ Du1), 20); \
+  Aka0 = Ba ^ ((~Be) & Bi);     \
+  Ase0 = Be ^ ((~Bi) & Bo);     \
+  Agi1 = Bi ^ ((~Bo) & Bu);     \
+  Amo0 = Bo ^ ((~Bu) & Ba);     \
+  Abu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Aka1 ^ Da0), 20); \
+  Bu = ROL32((Ase1 ^ De1), 1);  \
+  Ba = ROL32((Agi0 ^ Di1), 31); \
+  Be = ROL32((Amo1 ^ Do0), 27); \
+  Bi = ROL32((Abu1 ^ Du0), 19); \
+  Aka1 = Ba ^ ((~Be) & Bi);     \
+  Ase1 = Be ^ ((~Bi) & Bo);     \
+  Agi0 = Bi ^ ((~Bo) & Bu);     \
+  Amo1 = Bo ^ ((~Bu) & Ba);     \
+  Abu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  KeccakAtoD_round3();          \
+                                \
+  Ba = (Aba0 ^ Da0);            \
+  Be = ROL32((Abe0 ^ De0), 22); \
+  Bi = ROL32((Abi0 ^ Di1), 22); \
+  Bo = ROL32((Abo0 ^ Do1), 11); \
+  Bu = ROL32((Abu0 ^ Du0), 7);  \
+  Aba0 = Ba ^ ((~Be) & Bi);     \
+  Aba0 ^= *(pRoundConstants++); \
+  Abe0 = Be ^ ((~Bi) & Bo);     \
+  Abi0 = Bi ^ ((~Bo) & Bu);     \
+  Abo0 = Bo ^ ((~Bu) & Ba);     \
+  Abu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Ba = (Aba1 ^ Da1);            \
+  Be = ROL32((Abe1 ^ De1), 22); \
+  Bi = ROL32((Abi1 ^ Di0), 21); \
+  Bo = ROL32((Abo1 ^ Do0), 10); \
+  Bu = ROL32((Abu1 ^ Du1), 7);  \
+  Aba1 = Ba ^ ((~Be) & Bi);     \
+  Aba1 ^= *(pRoundConstants++); \
+  Abe1 = Be ^ ((~Bi) & Bo);     \
+  Abi1 = Bi ^ ((~Bo) & Bu);     \
+  Abo1 = Bo ^ ((~Bu) & Ba);     \
+  Abu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Aga0 ^ Da1), 2);  \
+  Bo = ROL32((Age0 ^ De1), 23); \
+  Bu = ROL32((Agi0 ^ Di1), 31); \
+  Ba = ROL32((Ago0 ^ Do0), 14); \
+  Be = ROL32((Agu0 ^ Du0), 10); \
+  Aga0 = Ba ^ ((~Be) & Bi);     \
+  Age0 = Be ^ ((~Bi) & Bo);     \
+  Agi0 = Bi ^ ((~Bo) & Bu);     \
+  Ago0 = Bo ^ ((~Bu) & Ba);     \
+  Agu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bi = ROL32((Aga1 ^ Da0), 1);  \
+  Bo = ROL32((Age1 ^ De0), 22); \
+  Bu = ROL32((Agi1 ^ Di0), 30); \
+  Ba = ROL32((Ago1 ^ Do1), 14); \
+  Be = ROL32((Agu1 ^ Du1), 10); \
+  Aga1 = Ba ^ ((~Be) & Bi);     \
+  Age1 = Be ^ ((~Bi) & Bo);     \
+  Agi1 = Bi ^ ((~Bo) & Bu);     \
+  Ago1 = Bo ^ ((~Bu) & Ba);     \
+  Agu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Aka0 ^ Da0), 9);  \
+  Ba = ROL32((Ake0 ^ De1), 1);  \
+  Be = ROL32((Aki0 ^ Di0), 3);  \
+  Bi = ROL32((Ako0 ^ Do1), 13); \
+  Bo = ROL32((Aku0 ^ Du0), 4);  \
+  Aka0 = Ba ^ ((~Be) & Bi);     \
+  Ake0 = Be ^ ((~Bi) & Bo);     \
+  Aki0 = Bi ^ ((~Bo) & Bu);     \
+  Ako0 = Bo ^ ((~Bu) & Ba);     \
+  Aku0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bu = ROL32((Aka1 ^ Da1), 9);  \
+  Ba = (Ake1 ^ De0);            \
+  Be = ROL32((Aki1 ^ Di1), 3);  \
+  Bi = ROL32((Ako1 ^ Do0), 12); \
+  Bo = ROL32((Aku1 ^ Du1), 4);  \
+  Aka1 = Ba ^ ((~Be) & Bi);     \
+  Ake1 = Be ^ ((~Bi) & Bo);     \
+  Aki1 = Bi ^ ((~Bo) & Bu);     \
+  Ako1 = Bo ^ ((~Bu) & Ba);     \
+  Aku1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Ama0 ^ Da0), 18); \
+  Bi = ROL32((Ame0 ^ De0), 5);  \
+  Bo = ROL32((Ami0 ^ Di1), 8);  \
+  Bu = ROL32((Amo0 ^ Do0), 28); \
+  Ba = ROL32((Amu0 ^ Du1), 14); \
+  Ama0 = Ba ^ ((~Be) & Bi);     \
+  Ame0 = Be ^ ((~Bi) & Bo);     \
+  Ami0 = Bi ^ ((~Bo) & Bu);     \
+  Amo0 = Bo ^ ((~Bu) & Ba);     \
+  Amu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Be = ROL32((Ama1 ^ Da1), 18); \
+  Bi = ROL32((Ame1 ^ De1), 5);  \
+  Bo = ROL32((Ami1 ^ Di0), 7);  \
+  Bu = ROL32((Amo1 ^ Do1), 28); \
+  Ba = ROL32((Amu1 ^ Du0), 13); \
+  Ama1 = Ba ^ ((~Be) & Bi);     \
+  Ame1 = Be ^ ((~Bi) & Bo);     \
+  Ami1 = Bi ^ ((~Bo) & Bu);     \
+  Amo1 = Bo ^ ((~Bu) & Ba);     \
+  Amu1 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Asa0 ^ Da1), 21); \
+  Bu = ROL32((Ase0 ^ De0), 1);  \
+  Ba = ROL32((Asi0 ^ Di0), 31); \
+  Be = ROL32((Aso0 ^ Do1), 28); \
+  Bi = ROL32((Asu0 ^ Du1), 20); \
+  Asa0 = Ba ^ ((~Be) & Bi);     \
+  Ase0 = Be ^ ((~Bi) & Bo);     \
+  Asi0 = Bi ^ ((~Bo) & Bu);     \
+  Aso0 = Bo ^ ((~Bu) & Ba);     \
+  Asu0 = Bu ^ ((~Ba) & Be);     \
+                                \
+  Bo = ROL32((Asa1 ^ Da0), 20); \
+  Bu = ROL32((Ase1 ^ De1), 1);  \
+  Ba = ROL32((Asi1 ^ Di1), 31); \
+  Be = ROL32((Aso1 ^ Do0), 27); \
+  Bi = ROL32((Asu1 ^ Du0), 19); \
+  Asa1 = Ba ^ ((~Be) & Bi);     \
+  Ase1 = Be ^ ((~Bi) & Bo);     \
+  Asi1 = Bi ^ ((~Bo) & Bu);     \
+  Aso1 = Bo ^ ((~Bu) & Ba);     \
+  Asu1 = Bu ^ ((~Ba) & Be);
+
+// Applies the rounds from the one whose constants are at @a roundConstants
+// up to the last one. The number of rounds must be even; if it is not a
+// multiple of 4, the second half of the loop body is first applied alone.
+static void KeccakP1600_StateXORPermuteExtractRounds(
+    void* state,
+    const unsigned char* inData,
+    unsigned int inLaneCount,
+    unsigned char* outData,
+    unsigned int outLaneCount,
+    const uint32_t* roundConstants) {
   {
     const uint32_t* pI = (const uint32_t*)inData;
     uint32_t* pS = state;
@@ -326,7 +903,7 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
 #define Bi Ci0
 #define Bo Co0
 #define Bu Cu0
-    const uint32_t* pRoundConstants = KeccakF1600RoundConstants_int2;
+    const uint32_t* pRoundConstants = roundConstants;
     uint32_t* stateAsHalfLanes = (uint32_t*)state;
 #define Aba0 stateAsHalfLanes[0]
 #define Aba1 stateAsHalfLanes[1]
@@ -379,464 +956,17 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
 #define Asu0 stateAsHalfLanes[48]
 #define Asu1 stateAsHalfLanes[49]
 
+    if ((roundConstants - KeccakF1600RoundConstants_int2) % 8 == 4) {
+      // --- Last 2 rounds of the 4-round code below, so that the loop
+      // --- then starts on a multiple of 4 rounds
+      KeccakP1600_ToLayoutAfter2Rounds(stateAsHalfLanes);
+      KeccakRounds2and3();
+    }
     do {
       // --- Code for 4 rounds
       // --- using factor 2 interleaving, 64-bit lanes mapped to 32-bit words
-      KeccakAtoD_round0();
-
-      Ba = (Aba0 ^ Da0);
-      Be = ROL32((Age0 ^ De0), 22);
-      Bi = ROL32((Aki1 ^ Di1), 22);
-      Bo = ROL32((Amo1 ^ Do1), 11);
-      Bu = ROL32((Asu0 ^ Du0), 7);
-      Aba0 = Ba ^ ((~Be) & Bi);
-      Aba0 ^= *(pRoundConstants++);
-      Age0 = Be ^ ((~Bi) & Bo);
-      Aki1 = Bi ^ ((~Bo) & Bu);
-      Amo1 = Bo ^ ((~Bu) & Ba);
-      Asu0 = Bu ^ ((~Ba) & Be);
-
-      Ba = (Aba1 ^ Da1);
-      Be = ROL32((Age1 ^ De1), 22);
-      Bi = ROL32((Aki0 ^ Di0), 21);
-      Bo = ROL32((Amo0 ^ Do0), 10);
-      Bu = ROL32((Asu1 ^ Du1), 7);
-      Aba1 = Ba ^ ((~Be) & Bi);
-      Aba1 ^= *(pRoundConstants++);
-      Age1 = Be ^ ((~Bi) & Bo);
-      Aki0 = Bi ^ ((~Bo) & Bu);
-      Amo0 = Bo ^ ((~Bu) & Ba);
-      Asu1 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Aka1 ^ Da1), 2);
-      Bo = ROL32((Ame1 ^ De1), 23);
-      Bu = ROL32((Asi1 ^ Di1), 31);
-      Ba = ROL32((Abo0 ^ Do0), 14);
-      Be = ROL32((Agu0 ^ Du0), 10);
-      Aka1 = Ba ^ ((~Be) & Bi);
-      Ame1 = Be ^ ((~Bi) & Bo);
-      Asi1 = Bi ^ ((~Bo) & Bu);
-      Abo0 = Bo ^ ((~Bu) & Ba);
-      Agu0 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Aka0 ^ Da0), 1);
-      Bo = ROL32((Ame0 ^ De0), 22);
-      Bu = ROL32((Asi0 ^ Di0), 30);
-      Ba = ROL32((Abo1 ^ Do1), 14);
-      Be = ROL32((Agu1 ^ Du1), 10);
-      Aka0 = Ba ^ ((~Be) & Bi);
-      Ame0 = Be ^ ((~Bi) & Bo);
-      Asi0 = Bi ^ ((~Bo) & Bu);
-      Abo1 = Bo ^ ((~Bu) & Ba);
-      Agu1 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Asa0 ^ Da0), 9);
-      Ba = ROL32((Abe1 ^ De1), 1);
-      Be = ROL32((Agi0 ^ Di0), 3);
-      Bi = ROL32((Ako1 ^ Do1), 13);
-      Bo = ROL32((Amu0 ^ Du0), 4);
-      Asa0 = Ba ^ ((~Be) & Bi);
-      Abe1 = Be ^ ((~Bi) & Bo);
-      Agi0 = Bi ^ ((~Bo) & Bu);
-      Ako1 = Bo ^ ((~Bu) & Ba);
-      Amu0 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Asa1 ^ Da1), 9);
-      Ba = (Abe0 ^ De0);
-      Be = ROL32((Agi1 ^ Di1), 3);
-      Bi = ROL32((Ako0 ^ Do0), 12);
-      Bo = ROL32((Amu1 ^ Du1), 4);
-      Asa1 = Ba ^ ((~Be) & Bi);
-      Abe0 = Be ^ ((~Bi) & Bo);
-      Agi1 = Bi ^ ((~Bo) & Bu);
-      Ako0 = Bo ^ ((~Bu) & Ba);
-      Amu1 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Aga0 ^ Da0), 18);
-      Bi = ROL32((Ake0 ^ De0), 5);
-      Bo = ROL32((Ami1 ^ Di1), 8);
-      Bu = ROL32((Aso0 ^ Do0), 28);
-      Ba = ROL32((Abu1 ^ Du1), 14);
-      Aga0 = Ba ^ ((~Be) & Bi);
-      Ake0 = Be ^ ((~Bi) & Bo);
-      Ami1 = Bi ^ ((~Bo) & Bu);
-      Aso0 = Bo ^ ((~Bu) & Ba);
-      Abu1 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Aga1 ^ Da1), 18);
-      Bi = ROL32((Ake1 ^ De1), 5);
-      Bo = ROL32((Ami0 ^ Di0), 7);
-      Bu = ROL32((Aso1 ^ Do1), 28);
-      Ba = ROL32((Abu0 ^ Du0), 13);
-      Aga1 = Ba ^ ((~Be) & Bi);
-      Ake1 = Be ^ ((~Bi) & Bo);
-      Ami0 = Bi ^ ((~Bo) & Bu);
-      Aso1 = Bo ^ ((~Bu) & Ba);
-      Abu0 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Ama1 ^ Da1), 21);
-      Bu = ROL32((Ase0 ^ De0), 1);
-      Ba = ROL32((Abi0 ^ Di0), 31);
-      Be = ROL32((Ago1 ^ Do1), 28);
-      Bi = ROL32((Aku1 ^ Du1), 20);
-      Ama1 = Ba ^ ((~Be) & Bi);
-      Ase0 = Be ^ ((~Bi) & Bo);
-      Abi0 = Bi ^ ((~Bo) & Bu);
-      Ago1 = Bo ^ ((~Bu) & Ba);
-      Aku1 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Ama0 ^ Da0), 20);
-      Bu = ROL32((Ase1 ^ De1), 1);
-      Ba = ROL32((Abi1 ^ Di1), 31);
-      Be = ROL32((Ago0 ^ Do0), 27);
-      Bi = ROL32((Aku0 ^ Du0), 19);
-      Ama0 = Ba ^ ((~Be) & Bi);
-      Ase1 = Be ^ ((~Bi) & Bo);
-      Abi1 = Bi ^ ((~Bo) & Bu);
-      Ago0 = Bo ^ ((~Bu) & Ba);
-      Aku0 = Bu ^ ((~Ba) & Be);
-
-      KeccakAtoD_round1();
-
-      Ba = (Aba0 ^ Da0);
-      Be = ROL32((Ame1 ^ De0), 22);
-      Bi = ROL32((Agi1 ^ Di1), 22);
-      Bo = ROL32((Aso1 ^ Do1), 11);
-      Bu = ROL32((Aku1 ^ Du0), 7);
-      Aba0 = Ba ^ ((~Be) & Bi);
-      Aba0 ^= *(pRoundConstants++);
-      Ame1 = Be ^ ((~Bi) & Bo);
-      Agi1 = Bi ^ ((~Bo) & Bu);
-      Aso1 = Bo ^ ((~Bu) & Ba);
-      Aku1 = Bu ^ ((~Ba) & Be);
-
-      Ba = (Aba1 ^ Da1);
-      Be = ROL32((Ame0 ^ De1), 22);
-      Bi = ROL32((Agi0 ^ Di0), 21);
-      Bo = ROL32((Aso0 ^ Do0), 10);
-      Bu = ROL32((Aku0 ^ Du1), 7);
-      Aba1 = Ba ^ ((~Be) & Bi);
-      Aba1 ^= *(pRoundConstants++);
-      Ame0 = Be ^ ((~Bi) & Bo);
-      Agi0 = Bi ^ ((~Bo) & Bu);
-      Aso0 = Bo ^ ((~Bu) & Ba);
-      Aku0 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Asa1 ^ Da1), 2);
-      Bo = ROL32((Ake1 ^ De1), 23);
-      Bu = ROL32((Abi1 ^ Di1), 31);
-      Ba = ROL32((Amo1 ^ Do0), 14);
-      Be = ROL32((Agu0 ^ Du0), 10);
-      Asa1 = Ba ^ ((~Be) & Bi);
-      Ake1 = Be ^ ((~Bi) & Bo);
-      Abi1 = Bi ^ ((~Bo) & Bu);
-      Amo1 = Bo ^ ((~Bu) & Ba);
-      Agu0 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Asa0 ^ Da0), 1);
-      Bo = ROL32((Ake0 ^ De0), 22);
-      Bu = ROL32((Abi0 ^ Di0), 30);
-      Ba = ROL32((Amo0 ^ Do1), 14);
-      Be = ROL32((Agu1 ^ Du1), 10);
-      Asa0 = Ba ^ ((~Be) & Bi);
-      Ake0 = Be ^ ((~Bi) & Bo);
-      Abi0 = Bi ^ ((~Bo) & Bu);
-      Amo0 = Bo ^ ((~Bu) & Ba);
-      Agu1 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Ama1 ^ Da0), 9);
-      Ba = ROL32((Age1 ^ De1), 1);
-      Be = ROL32((Asi1 ^ Di0), 3);
-      Bi = ROL32((Ako0 ^ Do1), 13);
-      Bo = ROL32((Abu1 ^ Du0), 4);
-      Ama1 = Ba ^ ((~Be) & Bi);
-      Age1 = Be ^ ((~Bi) & Bo);
-      Asi1 = Bi ^ ((~Bo) & Bu);
-      Ako0 = Bo ^ ((~Bu) & Ba);
-      Abu1 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Ama0 ^ Da1), 9);
-      Ba = (Age0 ^ De0);
-      Be = ROL32((Asi0 ^ Di1), 3);
-      Bi = ROL32((Ako1 ^ Do0), 12);
-      Bo = ROL32((Abu0 ^ Du1), 4);
-      Ama0 = Ba ^ ((~Be) & Bi);
-      Age0 = Be ^ ((~Bi) & Bo);
-      Asi0 = Bi ^ ((~Bo) & Bu);
-      Ako1 = Bo ^ ((~Bu) & Ba);
-      Abu0 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Aka1 ^ Da0), 18);
-      Bi = ROL32((Abe1 ^ De0), 5);
-      Bo = ROL32((Ami0 ^ Di1), 8);
-      Bu = ROL32((Ago1 ^ Do0), 28);
-      Ba = ROL32((Asu1 ^ Du1), 14);
-      Aka1 = Ba ^ ((~Be) & Bi);
-      Abe1 = Be ^ ((~Bi) & Bo);
-      Ami0 = Bi ^ ((~Bo) & Bu);
-      Ago1 = Bo ^ ((~Bu) & Ba);
-      Asu1 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Aka0 ^ Da1), 18);
-      Bi = ROL32((Abe0 ^ De1), 5);
-      Bo = ROL32((Ami1 ^ Di0), 7);
-      Bu = ROL32((Ago0 ^ Do1), 28);
-      Ba = ROL32((Asu0 ^ Du0), 13);
-      Aka0 = Ba ^ ((~Be) & Bi);
-      Abe0 = Be ^ ((~Bi) & Bo);
-      Ami1 = Bi ^ ((~Bo) & Bu);
-      Ago0 = Bo ^ ((~Bu) & Ba);
-      Asu0 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Aga1 ^ Da1), 21);
-      Bu = ROL32((Ase0 ^ De0), 1);
-      Ba = ROL32((Aki1 ^ Di0), 31);
-      Be = ROL32((Abo1 ^ Do1), 28);
-      Bi = ROL32((Amu1 ^ Du1), 20);
-      Aga1 = Ba ^ ((~Be) & Bi);
-      Ase0 = Be ^ ((~Bi) & Bo);
-      Aki1 = Bi ^ ((~Bo) & Bu);
-      Abo1 = Bo ^ ((~Bu) & Ba);
-      Amu1 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Aga0 ^ Da0), 20);
-      Bu = ROL32((Ase1 ^ De1), 1);
-      Ba = ROL32((Aki0 ^ Di1), 31);
-      Be = ROL32((Abo0 ^ Do0), 27);
-      Bi = ROL32((Amu0 ^ Du0), 19);
-      Aga0 = Ba ^ ((~Be) & Bi);
-      Ase1 = Be ^ ((~Bi) & Bo);
-      Aki0 = Bi ^ ((~Bo) & Bu);
-      Abo0 = Bo ^ ((~Bu) & Ba);
-      Amu0 = Bu ^ ((~Ba) & Be);
-
-      KeccakAtoD_round2();
-
-      Ba = (Aba0 ^ Da0);
-      Be = ROL32((Ake1 ^ De0), 22);
-      Bi = ROL32((Asi0 ^ Di1), 22);
-      Bo = ROL32((Ago0 ^ Do1), 11);
-      Bu = ROL32((Amu1 ^ Du0), 7);
-      Aba0 = Ba ^ ((~Be) & Bi);
-      Aba0 ^= *(pRoundConstants++);
-      Ake1 = Be ^ ((~Bi) & Bo);
-      Asi0 = Bi ^ ((~Bo) & Bu);
-      Ago0 = Bo ^ ((~Bu) & Ba);
-      Amu1 = Bu ^ ((~Ba) & Be);
-
-      Ba = (Aba1 ^ Da1);
-      Be = ROL32((Ake0 ^ De1), 22);
-      Bi = ROL32((Asi1 ^ Di0), 21);
-      Bo = ROL32((Ago1 ^ Do0), 10);
-      Bu = ROL32((Amu0 ^ Du1), 7);
-      Aba1 = Ba ^ ((~Be) & Bi);
-      Aba1 ^= *(pRoundConstants++);
-      Ake0 = Be ^ ((~Bi) & Bo);
-      Asi1 = Bi ^ ((~Bo) & Bu);
-      Ago1 = Bo ^ ((~Bu) & Ba);
-      Amu0 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Ama0 ^ Da1), 2);
-      Bo = ROL32((Abe0 ^ De1), 23);
-      Bu = ROL32((Aki0 ^ Di1), 31);
-      Ba = ROL32((Aso1 ^ Do0), 14);
-      Be = ROL32((Agu0 ^ Du0), 10);
-      Ama0 = Ba ^ ((~Be) & Bi);
-      Abe0 = Be ^ ((~Bi) & Bo);
-      Aki0 = Bi ^ ((~Bo) & Bu);
-      Aso1 = Bo ^ ((~Bu) & Ba);
-      Agu0 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Ama1 ^ Da0), 1);
-      Bo = ROL32((Abe1 ^ De0), 22);
-      Bu = ROL32((Aki1 ^ Di0), 30);
-      Ba = ROL32((Aso0 ^ Do1), 14);
-      Be = ROL32((Agu1 ^ Du1), 10);
-      Ama1 = Ba ^ ((~Be) & Bi);
-      Abe1 = Be ^ ((~Bi) & Bo);
-      Aki1 = Bi ^ ((~Bo) & Bu);
-      Aso0 = Bo ^ ((~Bu) & Ba);
-      Agu1 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Aga1 ^ Da0), 9);
-      Ba = ROL32((Ame0 ^ De1), 1);
-      Be = ROL32((Abi1 ^ Di0), 3);
-      Bi = ROL32((Ako1 ^ Do1), 13);
-      Bo = ROL32((Asu1 ^ Du0), 4);
-      Aga1 = Ba ^ ((~Be) & Bi);
-      Ame0 = Be ^ ((~Bi) & Bo);
-      Abi1 = Bi ^ ((~Bo) & Bu);
-      Ako1 = Bo ^ ((~Bu) & Ba);
-      Asu1 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Aga0 ^ Da1), 9);
-      Ba = (Ame1 ^ De0);
-      Be = ROL32((Abi0 ^ Di1), 3);
-      Bi = ROL32((Ako0 ^ Do0), 12);
-      Bo = ROL32((Asu0 ^ Du1), 4);
-      Aga0 = Ba ^ ((~Be) & Bi);
-      Ame1 = Be ^ ((~Bi) & Bo);
-      Abi0 = Bi ^ ((~Bo) & Bu);
-      Ako0 = Bo ^ ((~Bu) & Ba);
-      Asu0 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Asa1 ^ Da0), 18);
-      Bi = ROL32((Age1 ^ De0), 5);
-      Bo = ROL32((Ami1 ^ Di1), 8);
-      Bu = ROL32((Abo1 ^ Do0), 28);
-      Ba = ROL32((Aku0 ^ Du1), 14);
-      Asa1 = Ba ^ ((~Be) & Bi);
-      Age1 = Be ^ ((~Bi) & Bo);
-      Ami1 = Bi ^ ((~Bo) & Bu);
-      Abo1 = Bo ^ ((~Bu) & Ba);
-      Aku0 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Asa0 ^ Da1), 18);
-      Bi = ROL32((Age0 ^ De1), 5);
-      Bo = ROL32((Ami0 ^ Di0), 7);
-      Bu = ROL32((Abo0 ^ Do1), 28);
-      Ba = ROL32((Aku1 ^ Du0), 13);
-      Asa0 = Ba ^ ((~Be) & Bi);
-      Age0 = Be ^ ((~Bi) & Bo);
-      Ami0 = Bi ^ ((~Bo) & Bu);
-      Abo0 = Bo ^ ((~Bu) & Ba);
-      Aku1 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Aka0 ^ Da1), 21);
-      Bu = ROL32((Ase0 ^ De0), 1);
-      Ba = ROL32((Agi1 ^ Di0), 31);
-      Be = ROL32((Amo0 ^ Do1), 28);
-      Bi = ROL32((Abu0 ^ Du1), 20);
-      Aka0 = Ba ^ ((~Be) & Bi);
-      Ase0 = Be ^ ((~Bi) & Bo);
-      Agi1 = Bi ^ ((~Bo) & Bu);
-      Amo0 = Bo ^ ((~Bu) & Ba);
-      Abu0 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Aka1 ^ Da0), 20);
-      Bu = ROL32((Ase1 ^ De1), 1);
-      Ba = ROL32((Agi0 ^ Di1), 31);
-      Be = ROL32((Amo1 ^ Do0), 27);
-      Bi = ROL32((Abu1 ^ Du0), 19);
-      Aka1 = Ba ^ ((~Be) & Bi);
-      Ase1 = Be ^ ((~Bi) & Bo);
-      Agi0 = Bi ^ ((~Bo) & Bu);
-      Amo1 = Bo ^ ((~Bu) & Ba);
-      Abu1 = Bu ^ ((~Ba) & Be);
-
-      KeccakAtoD_round3();
-
-      Ba = (Aba0 ^ Da0);
-      Be = ROL32((Abe0 ^ De0), 22);
-      Bi = ROL32((Abi0 ^ Di1), 22);
-      Bo = ROL32((Abo0 ^ Do1), 11);
-      Bu = ROL32((Abu0 ^ Du0), 7);
-      Aba0 = Ba ^ ((~Be) & Bi);
-      Aba0 ^= *(pRoundConstants++);
-      Abe0 = Be ^ ((~Bi) & Bo);
-      Abi0 = Bi ^ ((~Bo) & Bu);
-      Abo0 = Bo ^ ((~Bu) & Ba);
-      Abu0 = Bu ^ ((~Ba) & Be);
-
-      Ba = (Aba1 ^ Da1);
-      Be = ROL32((Abe1 ^ De1), 22);
-      Bi = ROL32((Abi1 ^ Di0), 21);
-      Bo = ROL32((Abo1 ^ Do0), 10);
-      Bu = ROL32((Abu1 ^ Du1), 7);
-      Aba1 = Ba ^ ((~Be) & Bi);
-      Aba1 ^= *(pRoundConstants++);
-      Abe1 = Be ^ ((~Bi) & Bo);
-      Abi1 = Bi ^ ((~Bo) & Bu);
-      Abo1 = Bo ^ ((~Bu) & Ba);
-      Abu1 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Aga0 ^ Da1), 2);
-      Bo = ROL32((Age0 ^ De1), 23);
-      Bu = ROL32((Agi0 ^ Di1), 31);
-      Ba = ROL32((Ago0 ^ Do0), 14);
-      Be = ROL32((Agu0 ^ Du0), 10);
-      Aga0 = Ba ^ ((~Be) & Bi);
-      Age0 = Be ^ ((~Bi) & Bo);
-      Agi0 = Bi ^ ((~Bo) & Bu);
-      Ago0 = Bo ^ ((~Bu) & Ba);
-      Agu0 = Bu ^ ((~Ba) & Be);
-
-      Bi = ROL32((Aga1 ^ Da0), 1);
-      Bo = ROL32((Age1 ^ De0), 22);
-      Bu = ROL32((Agi1 ^ Di0), 30);
-      Ba = ROL32((Ago1 ^ Do1), 14);
-      Be = ROL32((Agu1 ^ Du1), 10);
-      Aga1 = Ba ^ ((~Be) & Bi);
-      Age1 = Be ^ ((~Bi) & Bo);
-      Agi1 = Bi ^ ((~Bo) & Bu);
-      Ago1 = Bo ^ ((~Bu) & Ba);
-      Agu1 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Aka0 ^ Da0), 9);
-      Ba = ROL32((Ake0 ^ De1), 1);
-      Be = ROL32((Aki0 ^ Di0), 3);
-      Bi = ROL32((Ako0 ^ Do1), 13);
-      Bo = ROL32((Aku0 ^ Du0), 4);
-      Aka0 = Ba ^ ((~Be) & Bi);
-      Ake0 = Be ^ ((~Bi) & Bo);
-      Aki0 = Bi ^ ((~Bo) & Bu);
-      Ako0 = Bo ^ ((~Bu) & Ba);
-      Aku0 = Bu ^ ((~Ba) & Be);
-
-      Bu = ROL32((Aka1 ^ Da1), 9);
-      Ba = (Ake1 ^ De0);
-      Be = ROL32((Aki1 ^ Di1), 3);
-      Bi = ROL32((Ako1 ^ Do0), 12);
-      Bo = ROL32((Aku1 ^ Du1), 4);
-      Aka1 = Ba ^ ((~Be) & Bi);
-      Ake1 = Be ^ ((~Bi) & Bo);
-      Aki1 = Bi ^ ((~Bo) & Bu);
-      Ako1 = Bo ^ ((~Bu) & Ba);
-      Aku1 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Ama0 ^ Da0), 18);
-      Bi = ROL32((Ame0 ^ De0), 5);
-      Bo = ROL32((Ami0 ^ Di1), 8);
-      Bu = ROL32((Amo0 ^ Do0), 28);
-      Ba = ROL32((Amu0 ^ Du1), 14);
-      Ama0 = Ba ^ ((~Be) & Bi);
-      Ame0 = Be ^ ((~Bi) & Bo);
-      Ami0 = Bi ^ ((~Bo) & Bu);
-      Amo0 = Bo ^ ((~Bu) & Ba);
-      Amu0 = Bu ^ ((~Ba) & Be);
-
-      Be = ROL32((Ama1 ^ Da1), 18);
-      Bi = ROL32((Ame1 ^ De1), 5);
-      Bo = ROL32((Ami1 ^ Di0), 7);
-      Bu = ROL32((Amo1 ^ Do1), 28);
-      Ba = ROL32((Amu1 ^ Du0), 13);
-      Ama1 = Ba ^ ((~Be) & Bi);
-      Ame1 = Be ^ ((~Bi) & Bo);
-      Ami1 = Bi ^ ((~Bo) & Bu);
-      Amo1 = Bo ^ ((~Bu) & Ba);
-      Amu1 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Asa0 ^ Da1), 21);
-      Bu = ROL32((Ase0 ^ De0), 1);
-      Ba = ROL32((Asi0 ^ Di0), 31);
-      Be = ROL32((Aso0 ^ Do1), 28);
-      Bi = ROL32((Asu0 ^ Du1), 20);
-      Asa0 = Ba ^ ((~Be) & Bi);
-      Ase0 = Be ^ ((~Bi) & Bo);
-      Asi0 = Bi ^ ((~Bo) & Bu);
-      Aso0 = Bo ^ ((~Bu) & Ba);
-      Asu0 = Bu ^ ((~Ba) & Be);
-
-      Bo = ROL32((Asa1 ^ Da0), 20);
-      Bu = ROL32((Ase1 ^ De1), 1);
-      Ba = ROL32((Asi1 ^ Di1), 31);
-      Be = ROL32((Aso1 ^ Do0), 27);
-      Bi = ROL32((Asu1 ^ Du0), 19);
-      Asa1 = Ba ^ ((~Be) & Bi);
-      Ase1 = Be ^ ((~Bi) & Bo);
-      Asi1 = Bi ^ ((~Bo) & Bu);
-      Aso1 = Bo ^ ((~Bu) & Ba);
-      Asu1 = Bu ^ ((~Ba) & Be);
+      KeccakRounds0and1();
+      KeccakRounds2and3();
     } while (*pRoundConstants != 0xFF);
 
 #undef Aba0
@@ -905,3 +1035,59 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
     }
   }
 }
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateXORPermuteExtract(void* state,
+                                        const unsigned char* inData,
+                                        unsigned int inLaneCount,
+                                        unsigned char* outData,
+                                        unsigned int outLaneCount) {
+  KeccakP1600_StateXORPermuteExtractRounds(state,
+                                           inData,
+                                           inLaneCount,
+                                           outData,
+                                           outLaneCount,
+                                           KeccakF1600RoundConstants_int2);
+}
+
+void KeccakP1600_StatePermute12rounds(void* state) {
+  KeccakP1600_StateXORPermuteExtract12rounds(state, 0, 0, 0, 0);
+}
+
+void KeccakP1600_StateXORPermuteExtract12rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakP1600_StateXORPermuteExtractRounds(
+      state,
+      inData,
+      inLaneCount,
+      outData,
+      outLaneCount,
+      KeccakF1600RoundConstants_int2 + 2 * 12);
+}
+
+void KeccakP1600_StatePermute14rounds(void* state) {
+  KeccakP1600_StateXORPermuteExtract14rounds(state, 0, 0, 0, 0);
+}
+
+void KeccakP1600_StatePermute6rounds(void* state) {
+  KeccakP1600_StateXORPermuteExtractRounds(
+      state, 0, 0, 0, 0, KeccakF1600RoundConstants_int2 + 2 * 18);
+}
+
+void KeccakP1600_StateXORPermuteExtract14rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakP1600_StateXORPermuteExtractRounds(
+      state,
+      inData,
+      inLaneCount,
+      outData,
+      outLaneCount,
+      KeccakF1600RoundConstants_int2 + 2 * 10);
+}
@@ -123,6 +123,53 @@ void KeccakF1600_StateXORLanes(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateOverwriteBytesInLane(void* state,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length) {
+  unsigned char* laneAsBytes = (unsigned char*)state + lanePosition * 8;
+
+  memcpy(laneAsBytes + offset, data, length);
+#ifdef UseLaneComplementing
+  if ((lanePosition == 1) || (lanePosition == 2) || (lanePosition == 8) ||
+      (lanePosition == 12) || (lanePosition == 17) || (lanePosition == 20)) {
+    unsigned int i;
+    for (i = 0; i < length; i++) laneAsBytes[offset + i] ^= 0xFF;
+  }
+#endif
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount) {
+  memcpy(state, data, laneCount * 8);
+#ifdef UseLaneComplementing
+  if (laneCount > 1) {
+    ((uint64_t*)state)[1] = ~((uint64_t*)state)[1];
+    if (laneCount > 2) {
+      ((uint64_t*)state)[2] = ~((uint64_t*)state)[2];
+      if (laneCount > 8) {
+        ((uint64_t*)state)[8] = ~((uint64_t*)state)[8];
+        if (laneCount > 12) {
+          ((uint64_t*)state)[12] = ~((uint64_t*)state)[12];
+          if (laneCount > 17) {
+            ((uint64_t*)state)[17] = ~((uint64_t*)state)[17];
+            if (laneCount > 20) {
+              ((uint64_t*)state)[20] = ~((uint64_t*)state)[20];
+            }
+          }
+        }
+      }
+    }
+  }
+#endif
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
   uint64_t lane = (uint64_t)1 << (position % 64);
   ((uint64_t*)state)[position / 64] ^= lane;
@@ -134,6 +181,23 @@ void KeccakF1600_StatePermute(void* state) {
   KeccakF1600_StateXORPermuteExtract(state, 0, 0, 0, 0);
 }
 
+void KeccakP1600_StatePermute12rounds(void* state) {
+  KeccakP1600_StateXORPermuteExtract12rounds(state, 0, 0, 0, 0);
+}
+
+void KeccakP1600_StatePermute14rounds(void* state) {
+  KeccakP1600_StateXORPermuteExtract14rounds(state, 0, 0, 0, 0);
+}
+
+void KeccakP1600_StatePermute6rounds(void* state) {
+  declareABCDE
+  uint64_t* stateAsLanes = (uint64_t*)state;
+
+  copyFromState(A, stateAsLanes)
+  rounds6
+  copyToState(stateAsLanes, A)
+}
+
 /* ---------------------------------------------------------------- */
 
 void KeccakF1600_StateExtractBytesInLane(const void* state,
@@ -184,6 +248,49 @@ void KeccakF1600_StateExtractLanes(const void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length) {
+  uint64_t lane = ((uint64_t*)state)[lanePosition];
+  unsigned int i;
+#ifdef UseLaneComplementing
+  if ((lanePosition == 1) || (lanePosition == 2) || (lanePosition == 8) ||
+      (lanePosition == 12) || (lanePosition == 17) || (lanePosition == 20))
+    lane = ~lane;
+#endif
+  {
+    uint8_t laneAsBytes[8];
+    memcpy(laneAsBytes, &lane, 8);
+    for (i = 0; i < length; i++)
+      data[i] ^= laneAsBytes[offset + i];
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount) {
+  unsigned int i;
+  uint64_t lane;
+
+  for (i = 0; i < laneCount; i++) {
+    memcpy(&lane, data + i * 8, 8);
+#ifdef UseLaneComplementing
+    if ((i == 1) || (i == 2) || (i == 8) || (i == 12) || (i == 17) ||
+        (i == 20))
+      lane ^= ~((const uint64_t*)state)[i];
+    else
+#endif
+      lane ^= ((const uint64_t*)state)[i];
+    memcpy(data + i * 8, &lane, 8);
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateXORPermuteExtract(void* state,
                                         const unsigned char* inData,
                                         unsigned int inLaneCount,
@@ -204,3 +311,45 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
 }
 
 /* ---------------------------------------------------------------- */
+
+void KeccakP1600_StateXORPermuteExtract12rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  {
+    declareABCDE
+#if (Unrolling != 24)
+        unsigned int i;
+#endif
+    uint64_t* stateAsLanes = (uint64_t*)state;
+    uint64_t* inDataAsLanes = (uint64_t*)inData;
+    uint64_t* outDataAsLanes = (uint64_t*)outData;
+
+    copyFromStateAndXOR(A, stateAsLanes, inDataAsLanes, inLaneCount)
+    rounds12
+    copyToStateAndOutput(A, stateAsLanes, outDataAsLanes, outLaneCount)
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakP1600_StateXORPermuteExtract14rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  {
+    declareABCDE
+#if (Unrolling != 24)
+        unsigned int i;
+#endif
+    uint64_t* stateAsLanes = (uint64_t*)state;
+    uint64_t* inDataAsLanes = (uint64_t*)inData;
+    uint64_t* outDataAsLanes = (uint64_t*)outData;
+
+    copyFromStateAndXOR(A, stateAsLanes, inDataAsLanes, inLaneCount)
+    rounds14
+    copyToStateAndOutput(A, stateAsLanes, outDataAsLanes, outLaneCount)
+  }
+}
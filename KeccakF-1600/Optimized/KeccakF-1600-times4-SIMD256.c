@@ -0,0 +1,476 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+// Four Keccak-f[1600] instances in parallel using AVX2. Lane i of the
+// instance j is stored as the 64-bit word j of the 256-bit word i.
+// Without AVX2, the on1 fallback is compiled instead.
+
+#if !defined(__AVX2__)
+
+#include "KeccakF-1600/Fallback/KeccakF-1600-times4-on1.c"
+
+#else
+
+#include "KeccakF-1600/KeccakF-1600-interface.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef __m256i V256;
+
+#define XOR256(a, b) _mm256_xor_si256(a, b)
+#define ANDnu256(a, b) _mm256_andnot_si256(a, b)
+#define CONST256_64(a) _mm256_set1_epi64x((long long)(a))
+#define ROL64in256(a, o) \
+  _mm256_or_si256(_mm256_slli_epi64(a, o), _mm256_srli_epi64(a, 64 - (o)))
+#define ROL64in256_8(a) _mm256_shuffle_epi8(a, rho8)
+#define ROL64in256_56(a) _mm256_shuffle_epi8(a, rho56)
+#define LOADLANES(input, i, stride)                           \
+  _mm256_set_epi64x(load64((input) + 3 * (stride) + 8 * (i)), \
+                    load64((input) + 2 * (stride) + 8 * (i)), \
+                    load64((input) + 1 * (stride) + 8 * (i)), \
+                    load64((input) + 8 * (i)))
+
+static inline long long load64(const unsigned char* x) {
+  long long v;
+  memcpy(&v, x, 8);
+  return v;
+}
+
+static const uint64_t KeccakF1600times4RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+
+#define declareABCDE            \
+  V256 Aba, Abe, Abi, Abo, Abu; \
+  V256 Aga, Age, Agi, Ago, Agu; \
+  V256 Aka, Ake, Aki, Ako, Aku; \
+  V256 Ama, Ame, Ami, Amo, Amu; \
+  V256 Asa, Ase, Asi, Aso, Asu; \
+  V256 Bba, Bbe, Bbi, Bbo, Bbu; \
+  V256 Bga, Bge, Bgi, Bgo, Bgu; \
+  V256 Bka, Bke, Bki, Bko, Bku; \
+  V256 Bma, Bme, Bmi, Bmo, Bmu; \
+  V256 Bsa, Bse, Bsi, Bso, Bsu; \
+  V256 Ca, Ce, Ci, Co, Cu;      \
+  V256 Da, De, Di, Do, Du;      \
+  V256 Eba, Ebe, Ebi, Ebo, Ebu; \
+  V256 Ega, Ege, Egi, Ego, Egu; \
+  V256 Eka, Eke, Eki, Eko, Eku; \
+  V256 Ema, Eme, Emi, Emo, Emu; \
+  V256 Esa, Ese, Esi, Eso, Esu;
+
+#define prepareTheta                                            \
+  Ca = XOR256(Aba, XOR256(Aga, XOR256(Aka, XOR256(Ama, Asa)))); \
+  Ce = XOR256(Abe, XOR256(Age, XOR256(Ake, XOR256(Ame, Ase)))); \
+  Ci = XOR256(Abi, XOR256(Agi, XOR256(Aki, XOR256(Ami, Asi)))); \
+  Co = XOR256(Abo, XOR256(Ago, XOR256(Ako, XOR256(Amo, Aso)))); \
+  Cu = XOR256(Abu, XOR256(Agu, XOR256(Aku, XOR256(Amu, Asu))));
+
+// --- Code for round, with prepare-theta
+// --- 64-bit lanes mapped to 64-bit words, four instances per 256-bit word
+#define thetaRhoPiChiIotaPrepareTheta(i, A, E)                            \
+  Da = XOR256(Cu, ROL64in256(Ce, 1));                                     \
+  De = XOR256(Ca, ROL64in256(Ci, 1));                                     \
+  Di = XOR256(Ce, ROL64in256(Co, 1));                                     \
+  Do = XOR256(Ci, ROL64in256(Cu, 1));                                     \
+  Du = XOR256(Co, ROL64in256(Ca, 1));                                     \
+                                                                          \
+  A##ba = XOR256(A##ba, Da);                                              \
+  Bba = A##ba;                                                            \
+  A##ge = XOR256(A##ge, De);                                              \
+  Bbe = ROL64in256(A##ge, 44);                                            \
+  A##ki = XOR256(A##ki, Di);                                              \
+  Bbi = ROL64in256(A##ki, 43);                                            \
+  A##mo = XOR256(A##mo, Do);                                              \
+  Bbo = ROL64in256(A##mo, 21);                                            \
+  A##su = XOR256(A##su, Du);                                              \
+  Bbu = ROL64in256(A##su, 14);                                            \
+  E##ba = XOR256(Bba, ANDnu256(Bbe, Bbi));                                \
+  E##ba = XOR256(E##ba, CONST256_64(KeccakF1600times4RoundConstants[i])); \
+  Ca = E##ba;                                                             \
+  E##be = XOR256(Bbe, ANDnu256(Bbi, Bbo));                                \
+  Ce = E##be;                                                             \
+  E##bi = XOR256(Bbi, ANDnu256(Bbo, Bbu));                                \
+  Ci = E##bi;                                                             \
+  E##bo = XOR256(Bbo, ANDnu256(Bbu, Bba));                                \
+  Co = E##bo;                                                             \
+  E##bu = XOR256(Bbu, ANDnu256(Bba, Bbe));                                \
+  Cu = E##bu;                                                             \
+                                                                          \
+  A##bo = XOR256(A##bo, Do);                                              \
+  Bga = ROL64in256(A##bo, 28);                                            \
+  A##gu = XOR256(A##gu, Du);                                              \
+  Bge = ROL64in256(A##gu, 20);                                            \
+  A##ka = XOR256(A##ka, Da);                                              \
+  Bgi = ROL64in256(A##ka, 3);                                             \
+  A##me = XOR256(A##me, De);                                              \
+  Bgo = ROL64in256(A##me, 45);                                            \
+  A##si = XOR256(A##si, Di);                                              \
+  Bgu = ROL64in256(A##si, 61);                                            \
+  E##ga = XOR256(Bga, ANDnu256(Bge, Bgi));                                \
+  Ca = XOR256(Ca, E##ga);                                                 \
+  E##ge = XOR256(Bge, ANDnu256(Bgi, Bgo));                                \
+  Ce = XOR256(Ce, E##ge);                                                 \
+  E##gi = XOR256(Bgi, ANDnu256(Bgo, Bgu));                                \
+  Ci = XOR256(Ci, E##gi);                                                 \
+  E##go = XOR256(Bgo, ANDnu256(Bgu, Bga));                                \
+  Co = XOR256(Co, E##go);                                                 \
+  E##gu = XOR256(Bgu, ANDnu256(Bga, Bge));                                \
+  Cu = XOR256(Cu, E##gu);                                                 \
+                                                                          \
+  A##be = XOR256(A##be, De);                                              \
+  Bka = ROL64in256(A##be, 1);                                             \
+  A##gi = XOR256(A##gi, Di);                                              \
+  Bke = ROL64in256(A##gi, 6);                                             \
+  A##ko = XOR256(A##ko, Do);                                              \
+  Bki = ROL64in256(A##ko, 25);                                            \
+  A##mu = XOR256(A##mu, Du);                                              \
+  Bko = ROL64in256_8(A##mu);                                              \
+  A##sa = XOR256(A##sa, Da);                                              \
+  Bku = ROL64in256(A##sa, 18);                                            \
+  E##ka = XOR256(Bka, ANDnu256(Bke, Bki));                                \
+  Ca = XOR256(Ca, E##ka);                                                 \
+  E##ke = XOR256(Bke, ANDnu256(Bki, Bko));                                \
+  Ce = XOR256(Ce, E##ke);                                                 \
+  E##ki = XOR256(Bki, ANDnu256(Bko, Bku));                                \
+  Ci = XOR256(Ci, E##ki);                                                 \
+  E##ko = XOR256(Bko, ANDnu256(Bku, Bka));                                \
+  Co = XOR256(Co, E##ko);                                                 \
+  E##ku = XOR256(Bku, ANDnu256(Bka, Bke));                                \
+  Cu = XOR256(Cu, E##ku);                                                 \
+                                                                          \
+  A##bu = XOR256(A##bu, Du);                                              \
+  Bma = ROL64in256(A##bu, 27);                                            \
+  A##ga = XOR256(A##ga, Da);                                              \
+  Bme = ROL64in256(A##ga, 36);                                            \
+  A##ke = XOR256(A##ke, De);                                              \
+  Bmi = ROL64in256(A##ke, 10);                                            \
+  A##mi = XOR256(A##mi, Di);                                              \
+  Bmo = ROL64in256(A##mi, 15);                                            \
+  A##so = XOR256(A##so, Do);                                              \
+  Bmu = ROL64in256_56(A##so);                                             \
+  E##ma = XOR256(Bma, ANDnu256(Bme, Bmi));                                \
+  Ca = XOR256(Ca, E##ma);                                                 \
+  E##me = XOR256(Bme, ANDnu256(Bmi, Bmo));                                \
+  Ce = XOR256(Ce, E##me);                                                 \
+  E##mi = XOR256(Bmi, ANDnu256(Bmo, Bmu));                                \
+  Ci = XOR256(Ci, E##mi);                                                 \
+  E##mo = XOR256(Bmo, ANDnu256(Bmu, Bma));                                \
+  Co = XOR256(Co, E##mo);                                                 \
+  E##mu = XOR256(Bmu, ANDnu256(Bma, Bme));                                \
+  Cu = XOR256(Cu, E##mu);                                                 \
+                                                                          \
+  A##bi = XOR256(A##bi, Di);                                              \
+  Bsa = ROL64in256(A##bi, 62);                                            \
+  A##go = XOR256(A##go, Do);                                              \
+  Bse = ROL64in256(A##go, 55);                                            \
+  A##ku = XOR256(A##ku, Du);                                              \
+  Bsi = ROL64in256(A##ku, 39);                                            \
+  A##ma = XOR256(A##ma, Da);                                              \
+  Bso = ROL64in256(A##ma, 41);                                            \
+  A##se = XOR256(A##se, De);                                              \
+  Bsu = ROL64in256(A##se, 2);                                             \
+  E##sa = XOR256(Bsa, ANDnu256(Bse, Bsi));                                \
+  Ca = XOR256(Ca, E##sa);                                                 \
+  E##se = XOR256(Bse, ANDnu256(Bsi, Bso));                                \
+  Ce = XOR256(Ce, E##se);                                                 \
+  E##si = XOR256(Bsi, ANDnu256(Bso, Bsu));                                \
+  Ci = XOR256(Ci, E##si);                                                 \
+  E##so = XOR256(Bso, ANDnu256(Bsu, Bsa));                                \
+  Co = XOR256(Co, E##so);                                                 \
+  E##su = XOR256(Bsu, ANDnu256(Bsa, Bse));                                \
+  Cu = XOR256(Cu, E##su);
+
+#define copyFromState(X, state) \
+  X##ba = state[0];             \
+  X##be = state[1];             \
+  X##bi = state[2];             \
+  X##bo = state[3];             \
+  X##bu = state[4];             \
+  X##ga = state[5];             \
+  X##ge = state[6];             \
+  X##gi = state[7];             \
+  X##go = state[8];             \
+  X##gu = state[9];             \
+  X##ka = state[10];            \
+  X##ke = state[11];            \
+  X##ki = state[12];            \
+  X##ko = state[13];            \
+  X##ku = state[14];            \
+  X##ma = state[15];            \
+  X##me = state[16];            \
+  X##mi = state[17];            \
+  X##mo = state[18];            \
+  X##mu = state[19];            \
+  X##sa = state[20];            \
+  X##se = state[21];            \
+  X##si = state[22];            \
+  X##so = state[23];            \
+  X##su = state[24];
+
+#define copyToState(state, X) \
+  state[0] = X##ba;           \
+  state[1] = X##be;           \
+  state[2] = X##bi;           \
+  state[3] = X##bo;           \
+  state[4] = X##bu;           \
+  state[5] = X##ga;           \
+  state[6] = X##ge;           \
+  state[7] = X##gi;           \
+  state[8] = X##go;           \
+  state[9] = X##gu;           \
+  state[10] = X##ka;          \
+  state[11] = X##ke;          \
+  state[12] = X##ki;          \
+  state[13] = X##ko;          \
+  state[14] = X##ku;          \
+  state[15] = X##ma;          \
+  state[16] = X##me;          \
+  state[17] = X##mi;          \
+  state[18] = X##mo;          \
+  state[19] = X##mu;          \
+  state[20] = X##sa;          \
+  state[21] = X##se;          \
+  state[22] = X##si;          \
+  state[23] = X##so;          \
+  state[24] = X##su;
+
+#define XORLanes(X, input, laneCount, stride)            \
+  if (laneCount > 0)                                     \
+    X##ba = XOR256(X##ba, LOADLANES(input, 0, stride));  \
+  if (laneCount > 1)                                     \
+    X##be = XOR256(X##be, LOADLANES(input, 1, stride));  \
+  if (laneCount > 2)                                     \
+    X##bi = XOR256(X##bi, LOADLANES(input, 2, stride));  \
+  if (laneCount > 3)                                     \
+    X##bo = XOR256(X##bo, LOADLANES(input, 3, stride));  \
+  if (laneCount > 4)                                     \
+    X##bu = XOR256(X##bu, LOADLANES(input, 4, stride));  \
+  if (laneCount > 5)                                     \
+    X##ga = XOR256(X##ga, LOADLANES(input, 5, stride));  \
+  if (laneCount > 6)                                     \
+    X##ge = XOR256(X##ge, LOADLANES(input, 6, stride));  \
+  if (laneCount > 7)                                     \
+    X##gi = XOR256(X##gi, LOADLANES(input, 7, stride));  \
+  if (laneCount > 8)                                     \
+    X##go = XOR256(X##go, LOADLANES(input, 8, stride));  \
+  if (laneCount > 9)                                     \
+    X##gu = XOR256(X##gu, LOADLANES(input, 9, stride));  \
+  if (laneCount > 10)                                    \
+    X##ka = XOR256(X##ka, LOADLANES(input, 10, stride)); \
+  if (laneCount > 11)                                    \
+    X##ke = XOR256(X##ke, LOADLANES(input, 11, stride)); \
+  if (laneCount > 12)                                    \
+    X##ki = XOR256(X##ki, LOADLANES(input, 12, stride)); \
+  if (laneCount > 13)                                    \
+    X##ko = XOR256(X##ko, LOADLANES(input, 13, stride)); \
+  if (laneCount > 14)                                    \
+    X##ku = XOR256(X##ku, LOADLANES(input, 14, stride)); \
+  if (laneCount > 15)                                    \
+    X##ma = XOR256(X##ma, LOADLANES(input, 15, stride)); \
+  if (laneCount > 16)                                    \
+    X##me = XOR256(X##me, LOADLANES(input, 16, stride)); \
+  if (laneCount > 17)                                    \
+    X##mi = XOR256(X##mi, LOADLANES(input, 17, stride)); \
+  if (laneCount > 18)                                    \
+    X##mo = XOR256(X##mo, LOADLANES(input, 18, stride)); \
+  if (laneCount > 19)                                    \
+    X##mu = XOR256(X##mu, LOADLANES(input, 19, stride)); \
+  if (laneCount > 20)                                    \
+    X##sa = XOR256(X##sa, LOADLANES(input, 20, stride)); \
+  if (laneCount > 21)                                    \
+    X##se = XOR256(X##se, LOADLANES(input, 21, stride)); \
+  if (laneCount > 22)                                    \
+    X##si = XOR256(X##si, LOADLANES(input, 22, stride)); \
+  if (laneCount > 23)                                    \
+    X##so = XOR256(X##so, LOADLANES(input, 23, stride)); \
+  if (laneCount > 24)                                    \
+    X##su = XOR256(X##su, LOADLANES(input, 24, stride));
+
+#define declareRhoMasks                                      \
+  const V256 rho8 = _mm256_set_epi64x(0x0E0D0C0B0A09080FLL,  \
+                                      0x0605040302010007LL,  \
+                                      0x0E0D0C0B0A09080FLL,  \
+                                      0x0605040302010007LL); \
+  const V256 rho56 = _mm256_set_epi64x(0x080F0E0D0C0B0A09LL, \
+                                       0x0007060504030201LL, \
+                                       0x080F0E0D0C0B0A09LL, \
+                                       0x0007060504030201LL);
+
+// The rounds of Keccak-f[1600] from @a firstRound (even) up to the last one
+#define roundsFrom(firstRound)                          \
+  prepareTheta for (i = (firstRound); i < 24; i += 2) { \
+    thetaRhoPiChiIotaPrepareTheta(i, A, E)              \
+    thetaRhoPiChiIotaPrepareTheta(i + 1, E, A)          \
+  }
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateInitializeAll(void* states) {
+  memset(states, 0, KeccakF1600times4_statesSizeInBytes);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateXORBytes(void* states,
+                                     unsigned int instanceIndex,
+                                     const unsigned char* data,
+                                     unsigned int offset,
+                                     unsigned int length) {
+  unsigned char* statesAsBytes = (unsigned char*)states;
+  unsigned int i;
+
+  for (i = 0; i < length; i++, offset++)
+    statesAsBytes[(offset / 8) * 32 + instanceIndex * 8 + offset % 8] ^=
+        data[i];
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateXORLanesAll(void* states,
+                                        const unsigned char* data,
+                                        unsigned int laneCount,
+                                        unsigned long long instanceStride) {
+  V256* statesAsLanes = (V256*)states;
+  unsigned int i;
+
+  for (i = 0; i < laneCount; i++)
+    statesAsLanes[i] =
+        XOR256(statesAsLanes[i], LOADLANES(data, i, instanceStride));
+}
+
+/* ---------------------------------------------------------------- */
+
+static void KeccakP1600times4_StatePermuteAllFrom(void* states,
+                                                  unsigned int firstRound) {
+  V256* statesAsLanes = (V256*)states;
+  declareABCDE
+  declareRhoMasks
+  unsigned int i;
+
+  copyFromState(A, statesAsLanes)
+  roundsFrom(firstRound)
+  copyToState(statesAsLanes, A)
+}
+
+void KeccakF1600times4_StatePermuteAll(void* states) {
+  KeccakP1600times4_StatePermuteAllFrom(states, 0);
+}
+
+void KeccakP1600times4_StatePermuteAll12rounds(void* states) {
+  KeccakP1600times4_StatePermuteAllFrom(states, 12);
+}
+
+void KeccakP1600times4_StatePermuteAll14rounds(void* states) {
+  KeccakP1600times4_StatePermuteAllFrom(states, 10);
+}
+
+void KeccakP1600times4_StatePermuteAll6rounds(void* states) {
+  KeccakP1600times4_StatePermuteAllFrom(states, 18);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateExtractBytes(const void* states,
+                                         unsigned int instanceIndex,
+                                         unsigned char* data,
+                                         unsigned int offset,
+                                         unsigned int length) {
+  const unsigned char* statesAsBytes = (const unsigned char*)states;
+  unsigned int i;
+
+  for (i = 0; i < length; i++, offset++)
+    data[i] = statesAsBytes[(offset / 8) * 32 + instanceIndex * 8 + offset % 8];
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600times4_StateExtractLanesAll(const void* states,
+                                            unsigned char* data,
+                                            unsigned int laneCount,
+                                            unsigned long long instanceStride) {
+  const uint64_t* statesAsWords = (const uint64_t*)states;
+  unsigned int i, j;
+
+  for (i = 0; i < laneCount; i++)
+    for (j = 0; j < 4; j++)
+      memcpy(data + j * instanceStride + 8 * i, &statesAsWords[4 * i + j], 8);
+}
+
+/* ---------------------------------------------------------------- */
+
+static unsigned long long KeccakP1600times4_StateAbsorbBlocksAllFrom(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen,
+    unsigned int firstRound) {
+  V256* statesAsLanes = (V256*)states;
+  unsigned long long blockByteLen = laneCount * 8;
+  unsigned long long absorbed = 0;
+  declareABCDE
+  declareRhoMasks
+  unsigned int i;
+
+  copyFromState(A, statesAsLanes)
+  while (dataByteLen - absorbed >= blockByteLen) {
+    XORLanes(A, data, laneCount, instanceStride)
+    roundsFrom(firstRound)
+    data += blockByteLen;
+    absorbed += blockByteLen;
+  }
+  copyToState(statesAsLanes, A)
+  return absorbed;
+}
+
+unsigned long long KeccakF1600times4_StateAbsorbBlocksAll(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen) {
+  return KeccakP1600times4_StateAbsorbBlocksAllFrom(
+      states, laneCount, data, instanceStride, dataByteLen, 0);
+}
+
+unsigned long long KeccakP1600times4_StateAbsorbBlocksAll12rounds(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen) {
+  return KeccakP1600times4_StateAbsorbBlocksAllFrom(
+      states, laneCount, data, instanceStride, dataByteLen, 12);
+}
+
+unsigned long long KeccakP1600times4_StateAbsorbBlocksAll14rounds(
+    void* states,
+    unsigned int laneCount,
+    const unsigned char* data,
+    unsigned long long instanceStride,
+    unsigned long long dataByteLen) {
+  return KeccakP1600times4_StateAbsorbBlocksAllFrom(
+      states, laneCount, data, instanceStride, dataByteLen, 10);
+}
+
+#endif
@@ -107,6 +107,24 @@ void KeccakF1600_StateXORLanes(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateOverwriteBytesInLane(void* state,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length) {
+  memcpy((unsigned char*)state + lanePosition * 8 + offset, data, length);
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount) {
+  memcpy(state, data, laneCount * 8);
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
   if (position < 1600) {
     unsigned int bytePosition = position / 8;
@@ -121,20 +139,37 @@ void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
 void fromBytesToWords(uint64_t* stateAsWords, const unsigned char* state);
 void fromWordsToBytes(unsigned char* state, const uint64_t* stateAsWords);
 void KeccakF1600OnWords(uint64_t* state);
+void KeccakP1600OnWords(uint64_t* state, unsigned int nrRoundsToApply);
 void theta(uint64_t* A);
 void rho(uint64_t* A);
 void pi(uint64_t* A);
 void chi(uint64_t* A);
 void iota(uint64_t* A, unsigned int indexRound);
 
-void KeccakF1600_StatePermute(void* state) {
-
+static void KeccakP1600_StatePermuteRounds(void* state,
+                                           unsigned int nrRoundsToApply) {
   displayStateAsBytes(1, "Input of permutation", (const unsigned char*)state);
-  KeccakF1600OnWords((uint64_t*)state);
+  KeccakP1600OnWords((uint64_t*)state, nrRoundsToApply);
   displayStateAsBytes(
       1, "State after permutation", (const unsigned char*)state);
 }
 
+void KeccakF1600_StatePermute(void* state) {
+  KeccakP1600_StatePermuteRounds(state, nrRounds);
+}
+
+void KeccakP1600_StatePermute12rounds(void* state) {
+  KeccakP1600_StatePermuteRounds(state, 12);
+}
+
+void KeccakP1600_StatePermute14rounds(void* state) {
+  KeccakP1600_StatePermuteRounds(state, 14);
+}
+
+void KeccakP1600_StatePermute6rounds(void* state) {
+  KeccakP1600_StatePermuteRounds(state, 6);
+}
+
 void fromBytesToWords(uint64_t* stateAsWords, const unsigned char* state) {
   unsigned int i, j;
 
@@ -154,11 +189,16 @@ void fromWordsToBytes(unsigned char* state, const uint64_t* stateAsWords) {
 }
 
 void KeccakF1600OnWords(uint64_t* state) {
+  KeccakP1600OnWords(state, nrRounds);
+}
+
+// Keccak-p[1600, n_r] consists of the last n_r rounds of Keccak-f[1600].
+void KeccakP1600OnWords(uint64_t* state, unsigned int nrRoundsToApply) {
   unsigned int i;
 
   displayStateAs64bitWords(3, "Same, with lanes as 64-bit words", state);
 
-  for (i = 0; i < nrRounds; i++) {
+  for (i = nrRounds - nrRoundsToApply; i < nrRounds; i++) {
     displayRoundNumber(3, i);
 
     theta(state);
@@ -254,6 +294,30 @@ void KeccakF1600_StateExtractLanes(const void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length) {
+  unsigned int i;
+
+  for (i = 0; i < length; i++)
+    data[i] ^= ((const unsigned char*)state)[lanePosition * 8 + offset + i];
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount) {
+  unsigned int i;
+
+  for (i = 0; i < laneCount * 8; i++)
+    data[i] ^= ((const unsigned char*)state)[i];
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateXORPermuteExtract(void* state,
                                         const unsigned char* inData,
                                         unsigned int inLaneCount,
@@ -266,6 +330,28 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakP1600_StateXORPermuteExtract12rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakF1600_StateXORLanes(state, inData, inLaneCount);
+  KeccakP1600_StatePermute12rounds(state);
+  KeccakF1600_StateExtractLanes(state, outData, outLaneCount);
+}
+
+void KeccakP1600_StateXORPermuteExtract14rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakF1600_StateXORLanes(state, inData, inLaneCount);
+  KeccakP1600_StatePermute14rounds(state);
+  KeccakF1600_StateExtractLanes(state, outData, outLaneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
 void displayRoundConstants(FILE* f) {
   unsigned int i;
 
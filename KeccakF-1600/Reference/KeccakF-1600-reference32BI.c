@@ -182,6 +182,38 @@ void KeccakF1600_StateXORLanes(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateOverwriteBytesInLane(void* state,
+                                           unsigned int lanePosition,
+                                           const unsigned char* data,
+                                           unsigned int offset,
+                                           unsigned int length) {
+  if ((lanePosition < 25) && (offset < 8) && (offset + length <= 8)) {
+    uint8_t laneAsBytes[8];
+    uint32_t* stateAsHalfLanes = (uint32_t*)state;
+
+    // The bytes around the ones overwritten are kept, so the lane is first
+    // cleared, then XORed with its new value.
+    KeccakF1600_StateExtractBytesInLane(state, lanePosition, laneAsBytes, 0, 8);
+    memcpy(laneAsBytes + offset, data, length);
+    stateAsHalfLanes[lanePosition * 2 + 0] = 0;
+    stateAsHalfLanes[lanePosition * 2 + 1] = 0;
+    KeccakF1600_StateXORBytesInLane(state, lanePosition, laneAsBytes, 0, 8);
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateOverwriteLanes(void* state,
+                                     const unsigned char* data,
+                                     unsigned int laneCount) {
+  if (laneCount <= 25) {
+    memset(state, 0, laneCount * 8);
+    KeccakF1600_StateXORLanes(state, data, laneCount);
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
   if (position < 1600) {
     uint32_t* stateAsHalfLanes = (uint32_t*)state;
@@ -195,13 +227,16 @@ void KeccakF1600_StateComplementBit(void* state, unsigned int position) {
 /* ---------------------------------------------------------------- */
 
 void KeccakF1600_PermutationOnWords(uint32_t* state);
+void KeccakP1600_PermutationOnWords(uint32_t* state,
+                                    unsigned int nrRoundsToApply);
 void theta(uint32_t* A);
 void rho(uint32_t* A);
 void pi(uint32_t* A);
 void chi(uint32_t* A);
 void iota(uint32_t* A, unsigned int indexRound);
 
-void KeccakF1600_StatePermute(void* state) {
+static void KeccakP1600_StatePermuteRounds(void* state,
+                                           unsigned int nrRoundsToApply) {
   uint32_t* stateAsHalfLanes = (uint32_t*)state;
   {
     uint8_t stateAsBytes[KeccakF_width / 8];
@@ -209,7 +244,7 @@ void KeccakF1600_StatePermute(void* state) {
         state, stateAsBytes, KeccakF_width / 8 / KeccakF_laneInBytes);
     displayStateAsBytes(1, "Input of permutation", stateAsBytes);
   }
-  KeccakF1600_PermutationOnWords(stateAsHalfLanes);
+  KeccakP1600_PermutationOnWords(stateAsHalfLanes, nrRoundsToApply);
   {
     uint8_t stateAsBytes[KeccakF_width / 8];
     KeccakF1600_StateExtractLanes(
@@ -218,13 +253,35 @@ void KeccakF1600_StatePermute(void* state) {
   }
 }
 
+void KeccakF1600_StatePermute(void* state) {
+  KeccakP1600_StatePermuteRounds(state, nrRounds);
+}
+
+void KeccakP1600_StatePermute12rounds(void* state) {
+  KeccakP1600_StatePermuteRounds(state, 12);
+}
+
+void KeccakP1600_StatePermute14rounds(void* state) {
+  KeccakP1600_StatePermuteRounds(state, 14);
+}
+
+void KeccakP1600_StatePermute6rounds(void* state) {
+  KeccakP1600_StatePermuteRounds(state, 6);
+}
+
 void KeccakF1600_PermutationOnWords(uint32_t* state) {
+  KeccakP1600_PermutationOnWords(state, nrRounds);
+}
+
+// Keccak-p[1600, n_r] consists of the last n_r rounds of Keccak-f[1600].
+void KeccakP1600_PermutationOnWords(uint32_t* state,
+                                    unsigned int nrRoundsToApply) {
   unsigned int i;
 
   displayStateAs32bitWords(
       3, "Same, with lanes as pairs of 32-bit words (bit interleaving)", state);
 
-  for (i = 0; i < nrRounds; i++) {
+  for (i = nrRounds - nrRoundsToApply; i < nrRounds; i++) {
     displayRoundNumber(3, i);
 
     theta(state);
@@ -388,6 +445,37 @@ void KeccakF1600_StateExtractLanes(const void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakF1600_StateExtractAndXORBytesInLane(const void* state,
+                                               unsigned int lanePosition,
+                                               unsigned char* data,
+                                               unsigned int offset,
+                                               unsigned int length) {
+  if ((lanePosition < 25) && (offset < 8) && (offset + length <= 8)) {
+    uint8_t laneAsBytes[8];
+    unsigned int i;
+
+    KeccakF1600_StateExtractBytesInLane(
+        state, lanePosition, laneAsBytes, offset, length);
+    for (i = 0; i < length; i++)
+      data[i] ^= laneAsBytes[i];
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+void KeccakF1600_StateExtractAndXORLanes(const void* state,
+                                         unsigned char* data,
+                                         unsigned int laneCount) {
+  if (laneCount <= 25) {
+    unsigned int lanePosition;
+    for (lanePosition = 0; lanePosition < laneCount; lanePosition++)
+      KeccakF1600_StateExtractAndXORBytesInLane(
+          state, lanePosition, data + lanePosition * 8, 0, 8);
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
 void KeccakF1600_StateXORPermuteExtract(void* state,
                                         const unsigned char* inData,
                                         unsigned int inLaneCount,
@@ -400,6 +488,28 @@ void KeccakF1600_StateXORPermuteExtract(void* state,
 
 /* ---------------------------------------------------------------- */
 
+void KeccakP1600_StateXORPermuteExtract12rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakF1600_StateXORLanes(state, inData, inLaneCount);
+  KeccakP1600_StatePermute12rounds(state);
+  KeccakF1600_StateExtractLanes(state, outData, outLaneCount);
+}
+
+void KeccakP1600_StateXORPermuteExtract14rounds(void* state,
+                                                const unsigned char* inData,
+                                                unsigned int inLaneCount,
+                                                unsigned char* outData,
+                                                unsigned int outLaneCount) {
+  KeccakF1600_StateXORLanes(state, inData, inLaneCount);
+  KeccakP1600_StatePermute14rounds(state);
+  KeccakF1600_StateExtractLanes(state, outData, outLaneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
 void displayRoundConstants(FILE* f) {
   unsigned int i;
 
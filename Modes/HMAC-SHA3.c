@@ -0,0 +1,152 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/HMAC-SHA3.h"
+
+/* ---------------------------------------------------------------- */
+
+// Overwrites key material with zeroes. The stores go through a volatile
+// pointer so that they are kept even if the buffer is not read again.
+static void HMAC_SHA3_Wipe(void* data, unsigned int byteLen) {
+  volatile unsigned char* bytes = (volatile unsigned char*)data;
+
+  while (byteLen-- > 0)
+    *bytes++ = 0;
+}
+
+static HashReturn HMAC_SHA3_HashInitialize(Keccak_HashInstance* instance,
+                                           unsigned int hashbitlen) {
+  return Keccak_HashInitialize(
+      instance, 1600 - 2 * hashbitlen, 2 * hashbitlen, hashbitlen, 0x06);
+}
+
+// Absorbs the key XORed with the given pad byte, making up one block.
+static HashReturn HMAC_SHA3_AbsorbPaddedKey(Keccak_HashInstance* instance,
+                                            unsigned int hashbitlen,
+                                            const unsigned char* key,
+                                            unsigned int keyByteLen,
+                                            unsigned char pad) {
+  unsigned char block[KeccakF_width / 8];
+  unsigned int blockSize = (1600 - 2 * hashbitlen) / 8;
+  unsigned int i;
+  HashReturn result;
+
+  if (HMAC_SHA3_HashInitialize(instance, hashbitlen) != SUCCESS) return FAIL;
+  for (i = 0; i < blockSize; i++)
+    block[i] = ((i < keyByteLen) ? key[i] : 0) ^ pad;
+  result = Keccak_HashUpdate(instance, block, blockSize * 8);
+  HMAC_SHA3_Wipe(block, sizeof(block));
+  return result;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn HMAC_SHA3_KeyInitialize(HMAC_SHA3_KeyInstance* keyInstance,
+                                   unsigned int hashbitlen,
+                                   const BitSequence* key,
+                                   DataLength keyBitLen) {
+  unsigned char hashedKey[512 / 8];
+  unsigned int blockSize = (1600 - 2 * hashbitlen) / 8;
+  HashReturn result;
+
+  if ((hashbitlen != 224) && (hashbitlen != 256) && (hashbitlen != 384) &&
+      (hashbitlen != 512))
+    return FAIL;
+  if ((keyBitLen % 8) != 0) return FAIL;
+  // A key longer than a block is replaced by its hash
+  if (keyBitLen > blockSize * 8) {
+    Keccak_HashInstance hash;
+    result = HMAC_SHA3_HashInitialize(&hash, hashbitlen);
+    if (result == SUCCESS) result = Keccak_HashUpdate(&hash, key, keyBitLen);
+    if (result == SUCCESS) result = Keccak_HashFinal(&hash, hashedKey);
+    HMAC_SHA3_Wipe(&hash, sizeof(hash));
+    if (result != SUCCESS) {
+      HMAC_SHA3_Wipe(hashedKey, sizeof(hashedKey));
+      return FAIL;
+    }
+    key = hashedKey;
+    keyBitLen = hashbitlen;
+  }
+  result = HMAC_SHA3_AbsorbPaddedKey(&keyInstance->inner,
+                                     hashbitlen,
+                                     key,
+                                     (unsigned int)(keyBitLen / 8),
+                                     0x36);
+  if (result == SUCCESS)
+    result = HMAC_SHA3_AbsorbPaddedKey(&keyInstance->outer,
+                                       hashbitlen,
+                                       key,
+                                       (unsigned int)(keyBitLen / 8),
+                                       0x5C);
+  HMAC_SHA3_Wipe(hashedKey, sizeof(hashedKey));
+  return result;
+}
+
+HashReturn HMAC_SHA3_Initialize(HMAC_SHA3_Instance* hmacInstance,
+                                const HMAC_SHA3_KeyInstance* keyInstance) {
+  // The padded keys end on a block boundary: copying the states is all it
+  // takes.
+  hmacInstance->inner = keyInstance->inner;
+  hmacInstance->outer = keyInstance->outer;
+  return SUCCESS;
+}
+
+HashReturn HMAC_SHA3_Update(HMAC_SHA3_Instance* hmacInstance,
+                            const BitSequence* input,
+                            DataLength inputBitLen) {
+  if ((inputBitLen % 8) != 0) return FAIL;
+  return Keccak_HashUpdate(&hmacInstance->inner, input, inputBitLen);
+}
+
+HashReturn HMAC_SHA3_Final(HMAC_SHA3_Instance* hmacInstance,
+                           BitSequence* output) {
+  unsigned char innerHash[512 / 8];
+
+  if (Keccak_HashFinal(&hmacInstance->inner, innerHash) != SUCCESS)
+    return FAIL;
+  if (Keccak_HashUpdate(&hmacInstance->outer,
+                        innerHash,
+                        hmacInstance->inner.fixedOutputLength) != SUCCESS)
+    return FAIL;
+  return Keccak_HashFinal(&hmacInstance->outer, output);
+}
+
+HashReturn HMAC_SHA3_WithKey(const HMAC_SHA3_KeyInstance* keyInstance,
+                             const BitSequence* input,
+                             DataLength inputBitLen,
+                             BitSequence* output) {
+  HMAC_SHA3_Instance hmac;
+  HashReturn result;
+
+  result = HMAC_SHA3_Initialize(&hmac, keyInstance);
+  if (result == SUCCESS) result = HMAC_SHA3_Update(&hmac, input, inputBitLen);
+  if (result == SUCCESS) result = HMAC_SHA3_Final(&hmac, output);
+  HMAC_SHA3_Wipe(&hmac, sizeof(hmac));
+  return result;
+}
+
+HashReturn HMAC_SHA3(unsigned int hashbitlen,
+                     const BitSequence* key,
+                     DataLength keyBitLen,
+                     const BitSequence* input,
+                     DataLength inputBitLen,
+                     BitSequence* output) {
+  HMAC_SHA3_KeyInstance keyInstance;
+  HashReturn result;
+
+  result = HMAC_SHA3_KeyInitialize(&keyInstance, hashbitlen, key, keyBitLen);
+  if (result == SUCCESS)
+    result = HMAC_SHA3_WithKey(&keyInstance, input, inputBitLen, output);
+  HMAC_SHA3_Wipe(&keyInstance, sizeof(keyInstance));
+  return result;
+}
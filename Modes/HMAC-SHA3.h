@@ -0,0 +1,132 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _HMAC_SHA3_h_
+#define _HMAC_SHA3_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * The functions below implement HMAC (RFC 2104, FIPS 198-1) on top of
+  * SHA3-224, SHA3-256, SHA3-384 and SHA3-512, whose block size is their
+  * rate: 144, 136, 104 and 72 bytes respectively. The key and the input
+  * must be a whole number of bytes; their lengths are still given in bits
+  * for consistency with the rest of the interface.
+  */
+
+/**
+  * Structure that holds an HMAC-SHA3 key in precomputed form: the SHA3
+  * states after absorbing K⊕ipad and K⊕opad respectively.
+  * Both are exactly one block, so starting a MAC from copies of these
+  * states saves the two permutations that the padded keys would cost.
+  */
+typedef struct {
+  Keccak_HashInstance inner;
+  Keccak_HashInstance outer;
+} HMAC_SHA3_KeyInstance;
+
+/**
+  * Structure that contains an HMAC-SHA3 computation in progress.
+  */
+typedef struct {
+  /** The inner hash, absorbing the input. */
+  Keccak_HashInstance inner;
+  /** The outer hash, waiting for the result of the inner one. */
+  Keccak_HashInstance outer;
+} HMAC_SHA3_Instance;
+
+/**
+  * Function to precompute an HMAC-SHA3 key.
+  * @param  keyInstance     Pointer to the key instance to be initialized.
+  * @param  hashbitlen      The output length of the underlying SHA3
+  *                         function: 224, 256, 384 or 512.
+  * @param  key             Pointer to the key K.
+  * @param  keyBitLen       The length of the key in bits. A key longer than
+  *                         the block size is first hashed.
+  * @pre    @a keyBitLen is a multiple of 8.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn HMAC_SHA3_KeyInitialize(HMAC_SHA3_KeyInstance* keyInstance,
+                                   unsigned int hashbitlen,
+                                   const BitSequence* key,
+                                   DataLength keyBitLen);
+
+/**
+  * Function to start an HMAC-SHA3 computation from a precomputed key.
+  * The key instance is not modified and can be reused for any number of
+  * computations.
+  * @param  hmacInstance    Pointer to the instance to be initialized.
+  * @param  keyInstance     Pointer to a key instance initialized by
+  *                         HMAC_SHA3_KeyInitialize().
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn HMAC_SHA3_Initialize(HMAC_SHA3_Instance* hmacInstance,
+                                const HMAC_SHA3_KeyInstance* keyInstance);
+
+/**
+  * Function to give input data to be authenticated.
+  * @param  hmacInstance    Pointer to the instance initialized by
+  *                         HMAC_SHA3_Initialize().
+  * @param  input           Pointer to the input data.
+  * @param  inputBitLen     The number of input bits (a multiple of 8).
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn HMAC_SHA3_Update(HMAC_SHA3_Instance* hmacInstance,
+                            const BitSequence* input,
+                            DataLength inputBitLen);
+
+/**
+  * Function to call after all the input has been given.
+  * @param  hmacInstance    Pointer to the instance initialized by
+  *                         HMAC_SHA3_Initialize().
+  * @param  output          Pointer to the buffer where to store the tag of
+  *                         hashbitlen bits.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn HMAC_SHA3_Final(HMAC_SHA3_Instance* hmacInstance,
+                           BitSequence* output);
+
+/**
+  * One-shot HMAC-SHA3 function using a precomputed key.
+  * @param  keyInstance     Pointer to a precomputed key.
+  * @param  input           Pointer to the input message.
+  * @param  inputBitLen     The length of the message in bits (a multiple of
+  *                         8).
+  * @param  output          Pointer to the buffer where to store the tag.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn HMAC_SHA3_WithKey(const HMAC_SHA3_KeyInstance* keyInstance,
+                             const BitSequence* input,
+                             DataLength inputBitLen,
+                             BitSequence* output);
+
+/**
+  * One-shot HMAC-SHA3 function.
+  * @param  hashbitlen      The output length of the underlying SHA3
+  *                         function: 224, 256, 384 or 512.
+  * @param  key             Pointer to the key K.
+  * @param  keyBitLen       The length of the key in bits (a multiple of 8).
+  * @param  input           Pointer to the input message.
+  * @param  inputBitLen     The length of the message in bits (a multiple of
+  *                         8).
+  * @param  output          Pointer to the buffer where to store the tag.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn HMAC_SHA3(unsigned int hashbitlen,
+                     const BitSequence* key,
+                     DataLength keyBitLen,
+                     const BitSequence* input,
+                     DataLength inputBitLen,
+                     BitSequence* output);
+
+#endif
@@ -0,0 +1,402 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KangarooTwelve.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// The number of chunks hashed per call to KangarooTwelve_HashChunks() from
+// KangarooTwelve_Update(), bounding the chaining values kept on the stack.
+#define KangarooTwelve_chunksPerUpdate 8
+
+#define KangarooTwelve_rate 1344
+#define KangarooTwelve_rounds 12
+#define MarsupilamiFourteen_rate 1088
+#define MarsupilamiFourteen_rounds 14
+
+// The chaining values are as long as the capacity, so an instance is fully
+// described by the rate and the number of rounds of its final node.
+#define KangarooTwelve_chainingValueSizeOf(rate) ((1600 - (rate)) / 8)
+
+// Domain separation: the final node, alone or with leaves, and the leaves.
+#define KangarooTwelve_suffixSingleNode 0x07
+#define KangarooTwelve_suffixFinalNode 0x06
+#define KangarooTwelve_suffixLeaf 0x0B
+
+// length_encode(x): x in big-endian order with no leading zero byte, followed
+// by its byte length. In particular, length_encode(0) = 0x00.
+static unsigned int KangarooTwelve_LengthEncode(unsigned char* encbuf,
+                                                unsigned long long value) {
+  unsigned int n, i;
+  unsigned long long v;
+
+  for (v = value, n = 0; v && (n < sizeof(unsigned long long)); ++n, v >>= 8)
+    ;
+  for (i = 1; i <= n; ++i)
+    encbuf[i - 1] = (unsigned char)(value >> (8 * (n - i)));
+  encbuf[n] = (unsigned char)n;
+  return n + 1;
+}
+
+/* ---------------------------------------------------------------- */
+
+static HashReturn KangarooTwelve_HashChunksWithParameters(
+    const unsigned char* input,
+    unsigned long long chunkCount,
+    unsigned char* chainingValues,
+    unsigned int rate,
+    unsigned int rounds) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  const unsigned char suffix = KangarooTwelve_suffixLeaf;
+  const unsigned char lastByte = 0x80;
+  const unsigned int rateInBytes = rate / 8;
+  const unsigned int chainingValueSize =
+      KangarooTwelve_chainingValueSizeOf(rate);
+  unsigned long long absorbed;
+  unsigned int i, partialLen;
+  Keccak_SpongeInstance leaf;
+
+  // Four chunks at a time, each in its own state
+  while (chunkCount >= KeccakF1600times4_parallelism) {
+    KeccakF1600times4_StateInitializeAll(states);
+    if (rounds == 12)
+      absorbed = KeccakP1600times4_StateAbsorbBlocksAll12rounds(
+          states,
+          rateInBytes / 8,
+          input,
+          KangarooTwelve_chunkSize,
+          KangarooTwelve_chunkSize);
+    else
+      absorbed = KeccakP1600times4_StateAbsorbBlocksAll14rounds(
+          states,
+          rateInBytes / 8,
+          input,
+          KangarooTwelve_chunkSize,
+          KangarooTwelve_chunkSize);
+    partialLen = (unsigned int)(KangarooTwelve_chunkSize - absorbed);
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      KeccakF1600times4_StateXORBytes(states,
+                                      i,
+                                      input + i * KangarooTwelve_chunkSize +
+                                          absorbed,
+                                      0,
+                                      partialLen);
+      KeccakF1600times4_StateXORBytes(states, i, &suffix, partialLen, 1);
+      KeccakF1600times4_StateXORBytes(states, i, &lastByte, rateInBytes - 1, 1);
+    }
+    if (rounds == 12)
+      KeccakP1600times4_StatePermuteAll12rounds(states);
+    else
+      KeccakP1600times4_StatePermuteAll14rounds(states);
+    for (i = 0; i < KeccakF1600times4_parallelism; i++)
+      KeccakF1600times4_StateExtractBytes(
+          states,
+          i,
+          chainingValues + i * chainingValueSize,
+          0,
+          chainingValueSize);
+    input += KeccakF1600times4_parallelism * KangarooTwelve_chunkSize;
+    chainingValues += KeccakF1600times4_parallelism * chainingValueSize;
+    chunkCount -= KeccakF1600times4_parallelism;
+  }
+
+  // The remaining chunks, one at a time
+  for (; chunkCount > 0; chunkCount--) {
+    if (Keccak_SpongeInitializeWithRounds(
+            &leaf, rate, 1600 - rate, rounds) != 0)
+      return FAIL;
+    if (Keccak_SpongeAbsorb(&leaf, input, KangarooTwelve_chunkSize) != 0)
+      return FAIL;
+    if (Keccak_SpongeAbsorbLastFewBits(&leaf, suffix) != 0) return FAIL;
+    if (Keccak_SpongeSqueeze(&leaf, chainingValues, chainingValueSize) != 0)
+      return FAIL;
+    input += KangarooTwelve_chunkSize;
+    chainingValues += chainingValueSize;
+  }
+  return SUCCESS;
+}
+
+HashReturn KangarooTwelve_HashChunks(const unsigned char* input,
+                                     unsigned long long chunkCount,
+                                     unsigned char* chainingValues) {
+  return KangarooTwelve_HashChunksWithParameters(input,
+                                                 chunkCount,
+                                                 chainingValues,
+                                                 KangarooTwelve_rate,
+                                                 KangarooTwelve_rounds);
+}
+
+HashReturn MarsupilamiFourteen_HashChunks(const unsigned char* input,
+                                          unsigned long long chunkCount,
+                                          unsigned char* chainingValues) {
+  return KangarooTwelve_HashChunksWithParameters(input,
+                                                 chunkCount,
+                                                 chainingValues,
+                                                 MarsupilamiFourteen_rate,
+                                                 MarsupilamiFourteen_rounds);
+}
+
+/* ---------------------------------------------------------------- */
+
+static HashReturn KangarooTwelve_InitializeWithParameters(
+    KangarooTwelve_Instance* ktInstance,
+    unsigned long long outputByteLen,
+    unsigned int rate,
+    unsigned int rounds) {
+  if (Keccak_SpongeInitializeWithRounds(
+          &ktInstance->finalNode, rate, 1600 - rate, rounds) != 0)
+    return FAIL;
+  ktInstance->fixedOutputLength = outputByteLen;
+  ktInstance->blockNumber = 0;
+  ktInstance->queueAbsorbedLen = 0;
+  ktInstance->squeezing = 0;
+  return SUCCESS;
+}
+
+HashReturn KangarooTwelve_Initialize(KangarooTwelve_Instance* ktInstance,
+                                     unsigned long long outputByteLen) {
+  return KangarooTwelve_InitializeWithParameters(
+      ktInstance, outputByteLen, KangarooTwelve_rate, KangarooTwelve_rounds);
+}
+
+HashReturn MarsupilamiFourteen_Initialize(
+    MarsupilamiFourteen_Instance* mfInstance,
+    unsigned long long outputByteLen) {
+  return KangarooTwelve_InitializeWithParameters(mfInstance,
+                                                 outputByteLen,
+                                                 MarsupilamiFourteen_rate,
+                                                 MarsupilamiFourteen_rounds);
+}
+
+// Once the first chunk is complete and more input follows, the final node
+// continues with 0x03 0x00^7 before the chaining values.
+static HashReturn KangarooTwelve_StartTree(
+    KangarooTwelve_Instance* ktInstance) {
+  const unsigned char separator[8] = {0x03, 0, 0, 0, 0, 0, 0, 0};
+
+  if (Keccak_SpongeAbsorb(&ktInstance->finalNode, separator, 8) != 0)
+    return FAIL;
+  ktInstance->blockNumber = 1;
+  ktInstance->queueAbsorbedLen = 0;
+  return SUCCESS;
+}
+
+HashReturn KangarooTwelve_UpdateChainingValues(
+    KangarooTwelve_Instance* ktInstance,
+    const unsigned char* chainingValues,
+    unsigned long long chunkCount) {
+  if (ktInstance->squeezing) return FAIL;
+  if (ktInstance->blockNumber == 0) {
+    if (ktInstance->queueAbsorbedLen != KangarooTwelve_chunkSize) return FAIL;
+    if (KangarooTwelve_StartTree(ktInstance) != SUCCESS) return FAIL;
+  }
+  if (ktInstance->queueAbsorbedLen != 0) return FAIL;
+  if (Keccak_SpongeAbsorb(&ktInstance->finalNode,
+                          chainingValues,
+                          chunkCount * KangarooTwelve_chainingValueSizeOf(
+                                           ktInstance->finalNode.rate)) != 0)
+    return FAIL;
+  ktInstance->blockNumber += chunkCount;
+  return SUCCESS;
+}
+
+// Completes the chunk in the queue, possibly shorter if it is the last one.
+static HashReturn KangarooTwelve_FlushQueue(
+    KangarooTwelve_Instance* ktInstance) {
+  unsigned char chainingValue[MarsupilamiFourteen_chainingValueSize];
+
+  if (Keccak_SpongeAbsorbLastFewBits(&ktInstance->queueNode,
+                                     KangarooTwelve_suffixLeaf) != 0)
+    return FAIL;
+  if (Keccak_SpongeSqueeze(
+          &ktInstance->queueNode,
+          chainingValue,
+          KangarooTwelve_chainingValueSizeOf(ktInstance->queueNode.rate)) != 0)
+    return FAIL;
+  ktInstance->queueAbsorbedLen = 0;
+  return KangarooTwelve_UpdateChainingValues(ktInstance, chainingValue, 1);
+}
+
+HashReturn KangarooTwelve_Update(KangarooTwelve_Instance* ktInstance,
+                                 const unsigned char* input,
+                                 unsigned long long inputByteLen) {
+  unsigned char chainingValues[KangarooTwelve_chunksPerUpdate *
+                               MarsupilamiFourteen_chainingValueSize];
+  const unsigned int rate = ktInstance->finalNode.rate;
+  unsigned long long n;
+
+  if (ktInstance->squeezing) return FAIL;
+
+  // The first chunk goes straight into the final node
+  if (ktInstance->blockNumber == 0) {
+    n = KangarooTwelve_chunkSize - ktInstance->queueAbsorbedLen;
+    if (n > inputByteLen) n = inputByteLen;
+    if (Keccak_SpongeAbsorb(&ktInstance->finalNode, input, n) != 0)
+      return FAIL;
+    input += n;
+    inputByteLen -= n;
+    ktInstance->queueAbsorbedLen += (unsigned int)n;
+    if (inputByteLen == 0) return SUCCESS;
+    if (KangarooTwelve_StartTree(ktInstance) != SUCCESS) return FAIL;
+  }
+
+  // Complete the chunk started by a previous call
+  if (ktInstance->queueAbsorbedLen != 0) {
+    n = KangarooTwelve_chunkSize - ktInstance->queueAbsorbedLen;
+    if (n > inputByteLen) n = inputByteLen;
+    if (Keccak_SpongeAbsorb(&ktInstance->queueNode, input, n) != 0)
+      return FAIL;
+    input += n;
+    inputByteLen -= n;
+    ktInstance->queueAbsorbedLen += (unsigned int)n;
+    if (ktInstance->queueAbsorbedLen == KangarooTwelve_chunkSize)
+      if (KangarooTwelve_FlushQueue(ktInstance) != SUCCESS) return FAIL;
+  }
+
+  // Whole chunks, hashed in parallel where possible
+  while (inputByteLen >= KangarooTwelve_chunkSize) {
+    n = inputByteLen / KangarooTwelve_chunkSize;
+    if (n > KangarooTwelve_chunksPerUpdate) n = KangarooTwelve_chunksPerUpdate;
+    if (KangarooTwelve_HashChunksWithParameters(
+            input, n, chainingValues, rate, ktInstance->finalNode.rounds) !=
+        SUCCESS)
+      return FAIL;
+    if (KangarooTwelve_UpdateChainingValues(ktInstance, chainingValues, n) !=
+        SUCCESS)
+      return FAIL;
+    input += n * KangarooTwelve_chunkSize;
+    inputByteLen -= n * KangarooTwelve_chunkSize;
+  }
+
+  // Start a new chunk with what remains
+  if (inputByteLen > 0) {
+    if (Keccak_SpongeInitializeWithRounds(&ktInstance->queueNode,
+                                          rate,
+                                          1600 - rate,
+                                          ktInstance->finalNode.rounds) != 0)
+      return FAIL;
+    if (Keccak_SpongeAbsorb(&ktInstance->queueNode, input, inputByteLen) != 0)
+      return FAIL;
+    ktInstance->queueAbsorbedLen = (unsigned int)inputByteLen;
+  }
+  return SUCCESS;
+}
+
+HashReturn KangarooTwelve_Final(KangarooTwelve_Instance* ktInstance,
+                                unsigned char* output,
+                                const unsigned char* customization,
+                                unsigned long long customByteLen) {
+  unsigned char encbuf[sizeof(unsigned long long) + 1 + 2];
+  unsigned int n;
+
+  if (ktInstance->squeezing) return FAIL;
+
+  // C || length_encode(|C|) completes the input
+  if (KangarooTwelve_Update(ktInstance, customization, customByteLen) !=
+      SUCCESS)
+    return FAIL;
+  n = KangarooTwelve_LengthEncode(encbuf, customByteLen);
+  if (KangarooTwelve_Update(ktInstance, encbuf, n) != SUCCESS) return FAIL;
+
+  if (ktInstance->blockNumber == 0) {
+    // Everything fits in a single node
+    if (Keccak_SpongeAbsorbLastFewBits(&ktInstance->finalNode,
+                                       KangarooTwelve_suffixSingleNode) != 0)
+      return FAIL;
+  } else {
+    if (ktInstance->queueAbsorbedLen != 0)
+      if (KangarooTwelve_FlushQueue(ktInstance) != SUCCESS) return FAIL;
+    // length_encode(n-1) || 0xFF 0xFF, with n the number of chunks
+    n = KangarooTwelve_LengthEncode(encbuf, ktInstance->blockNumber - 1);
+    encbuf[n++] = 0xFF;
+    encbuf[n++] = 0xFF;
+    if (Keccak_SpongeAbsorb(&ktInstance->finalNode, encbuf, n) != 0)
+      return FAIL;
+    if (Keccak_SpongeAbsorbLastFewBits(&ktInstance->finalNode,
+                                       KangarooTwelve_suffixFinalNode) != 0)
+      return FAIL;
+  }
+  ktInstance->squeezing = 1;
+  if (ktInstance->fixedOutputLength == 0) return SUCCESS;
+  if (Keccak_SpongeSqueeze(
+          &ktInstance->finalNode, output, ktInstance->fixedOutputLength) != 0)
+    return FAIL;
+  return SUCCESS;
+}
+
+HashReturn KangarooTwelve_Squeeze(KangarooTwelve_Instance* ktInstance,
+                                  unsigned char* output,
+                                  unsigned long long outputByteLen) {
+  if (!ktInstance->squeezing) return FAIL;
+  if (ktInstance->fixedOutputLength != 0) return FAIL;
+  if (Keccak_SpongeSqueeze(&ktInstance->finalNode, output, outputByteLen) !=
+      0)
+    return FAIL;
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+// Absorbs the whole input into an instance just initialized and completes it.
+static HashReturn KangarooTwelve_UpdateAndFinal(
+    KangarooTwelve_Instance* ktInstance,
+    const unsigned char* input,
+    unsigned long long inputByteLen,
+    unsigned char* output,
+    const unsigned char* customization,
+    unsigned long long customByteLen) {
+  if (KangarooTwelve_Update(ktInstance, input, inputByteLen) != SUCCESS)
+    return FAIL;
+  return KangarooTwelve_Final(ktInstance, output, customization, customByteLen);
+}
+
+HashReturn KangarooTwelve(const unsigned char* input,
+                          unsigned long long inputByteLen,
+                          unsigned char* output,
+                          unsigned long long outputByteLen,
+                          const unsigned char* customization,
+                          unsigned long long customByteLen) {
+  KangarooTwelve_Instance ktInstance;
+
+  if (outputByteLen == 0) return FAIL;
+  if (KangarooTwelve_Initialize(&ktInstance, outputByteLen) != SUCCESS)
+    return FAIL;
+  return KangarooTwelve_UpdateAndFinal(&ktInstance,
+                                       input,
+                                       inputByteLen,
+                                       output,
+                                       customization,
+                                       customByteLen);
+}
+
+HashReturn MarsupilamiFourteen(const unsigned char* input,
+                               unsigned long long inputByteLen,
+                               unsigned char* output,
+                               unsigned long long outputByteLen,
+                               const unsigned char* customization,
+                               unsigned long long customByteLen) {
+  MarsupilamiFourteen_Instance mfInstance;
+
+  if (outputByteLen == 0) return FAIL;
+  if (MarsupilamiFourteen_Initialize(&mfInstance, outputByteLen) != SUCCESS)
+    return FAIL;
+  return KangarooTwelve_UpdateAndFinal(&mfInstance,
+                                       input,
+                                       inputByteLen,
+                                       output,
+                                       customization,
+                                       customByteLen);
+}
@@ -0,0 +1,198 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KangarooTwelve_h_
+#define _KangarooTwelve_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * KangarooTwelve is a tree hash function on top of Keccak-p[1600, 12].
+  * The input, followed by the customization string and its length, is cut in
+  * chunks of 8192 bytes. The first chunk goes straight into the final node,
+  * while the others are hashed independently into 32-byte chaining values,
+  * four at a time with KeccakP1600times4_* when a parallel permutation is
+  * available.
+  *
+  * MarsupilamiFourteen is the same construction on top of Keccak-p[1600, 14],
+  * with a capacity of 512 bits and 64-byte chaining values. Apart from its
+  * initialization, chunk hashing and one-shot functions, it shares the
+  * instance type and the functions of KangarooTwelve.
+  */
+
+/** The size in bytes of a chunk. */
+#define KangarooTwelve_chunkSize 8192
+/** The size in bytes of the chaining value of a chunk. */
+#define KangarooTwelve_chainingValueSize 32
+/** The size in bytes of the chaining value of a chunk in MarsupilamiFourteen.
+  */
+#define MarsupilamiFourteen_chainingValueSize 64
+
+/**
+  * Structure that contains a KangarooTwelve computation in progress.
+  */
+typedef struct {
+  /** The final node, which absorbs the first chunk and the chaining values. */
+  Keccak_SpongeInstance finalNode;
+  /** The chunk currently being absorbed, if it is not complete yet. */
+  Keccak_SpongeInstance queueNode;
+  /** The requested output length in bytes, or 0 for an arbitrary length. */
+  unsigned long long fixedOutputLength;
+  /** The number of chunks started so far, the first one included; 0 as long
+   * as the input fits in the first chunk. */
+  unsigned long long blockNumber;
+  /** The number of bytes absorbed from the current chunk. */
+  unsigned int queueAbsorbedLen;
+  /** If set to 0, in the absorbing phase; otherwise, in the squeezing phase. */
+  int squeezing;
+} KangarooTwelve_Instance;
+
+typedef KangarooTwelve_Instance MarsupilamiFourteen_Instance;
+
+/**
+  * Function to initialize a KangarooTwelve instance.
+  * @param  ktInstance      Pointer to the instance to be initialized.
+  * @param  outputByteLen   The desired number of output bytes,
+  *                         or 0 for an arbitrarily-long output.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve_Initialize(KangarooTwelve_Instance* ktInstance,
+                                     unsigned long long outputByteLen);
+
+/**
+  * Function to initialize a MarsupilamiFourteen instance.
+  * @param  mfInstance      Pointer to the instance to be initialized.
+  * @param  outputByteLen   The desired number of output bytes,
+  *                         or 0 for an arbitrarily-long output.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn MarsupilamiFourteen_Initialize(
+    MarsupilamiFourteen_Instance* mfInstance,
+    unsigned long long outputByteLen);
+
+/**
+  * Function to give input data to be absorbed.
+  * @param  ktInstance      Pointer to the instance initialized by
+  *                         KangarooTwelve_Initialize().
+  * @param  input           Pointer to the input data.
+  * @param  inputByteLen    The number of input bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve_Update(KangarooTwelve_Instance* ktInstance,
+                                 const unsigned char* input,
+                                 unsigned long long inputByteLen);
+
+/**
+  * Function to hash whole chunks into chaining values, independently of any
+  * instance. This function has no side effect other than writing
+  * @a chainingValues, so a large input can be split in ranges of chunks that
+  * are processed concurrently, e.g., by different threads, before being given
+  * in order to KangarooTwelve_UpdateChainingValues().
+  * @param  input           Pointer to the first chunk.
+  * @param  chunkCount      The number of consecutive chunks of
+  *                         KangarooTwelve_chunkSize bytes.
+  * @param  chainingValues  Pointer to the buffer where to store the
+  *                         KangarooTwelve_chainingValueSize-byte chaining
+  *                         values.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve_HashChunks(const unsigned char* input,
+                                     unsigned long long chunkCount,
+                                     unsigned char* chainingValues);
+
+/**
+  * Same as KangarooTwelve_HashChunks(), but for MarsupilamiFourteen, with
+  * chaining values of MarsupilamiFourteen_chainingValueSize bytes.
+  */
+HashReturn MarsupilamiFourteen_HashChunks(const unsigned char* input,
+                                          unsigned long long chunkCount,
+                                          unsigned char* chainingValues);
+
+/**
+  * Function to give chaining values computed by KangarooTwelve_HashChunks(),
+  * or MarsupilamiFourteen_HashChunks() for a MarsupilamiFourteen instance, in
+  * the order of the chunks they correspond to.
+  * @param  ktInstance      Pointer to the instance.
+  * @param  chainingValues  Pointer to the chaining values.
+  * @param  chunkCount      The number of chaining values.
+  * @pre    The input given so far must be a whole number of chunks, at least
+  *         one, as the first chunk is not hashed into a chaining value.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve_UpdateChainingValues(
+    KangarooTwelve_Instance* ktInstance,
+    const unsigned char* chainingValues,
+    unsigned long long chunkCount);
+
+/**
+  * Function to call after all the input has been given.
+  * If the output length given to KangarooTwelve_Initialize() was not 0,
+  * the output is written to @a output; otherwise it must be extracted using
+  * KangarooTwelve_Squeeze().
+  * @param  ktInstance      Pointer to the instance.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  customization   Pointer to the customization string C.
+  * @param  customByteLen   The length of the customization string in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve_Final(KangarooTwelve_Instance* ktInstance,
+                                unsigned char* output,
+                                const unsigned char* customization,
+                                unsigned long long customByteLen);
+
+/**
+  * Function to squeeze output data.
+  * @pre    KangarooTwelve_Final() must have been already called.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve_Squeeze(KangarooTwelve_Instance* ktInstance,
+                                  unsigned char* output,
+                                  unsigned long long outputByteLen);
+
+/**
+  * One-shot KangarooTwelve function.
+  * @param  input           Pointer to the input message M.
+  * @param  inputByteLen    The length of M in bytes.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputByteLen   The number of output bytes.
+  * @param  customization   Pointer to the customization string C.
+  * @param  customByteLen   The length of the customization string in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KangarooTwelve(const unsigned char* input,
+                          unsigned long long inputByteLen,
+                          unsigned char* output,
+                          unsigned long long outputByteLen,
+                          const unsigned char* customization,
+                          unsigned long long customByteLen);
+
+/** The functions below work on MarsupilamiFourteen instances as well. */
+#define MarsupilamiFourteen_Update KangarooTwelve_Update
+#define MarsupilamiFourteen_UpdateChainingValues \
+  KangarooTwelve_UpdateChainingValues
+#define MarsupilamiFourteen_Final KangarooTwelve_Final
+#define MarsupilamiFourteen_Squeeze KangarooTwelve_Squeeze
+
+/**
+  * One-shot MarsupilamiFourteen function, with the same parameters as
+  * KangarooTwelve().
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn MarsupilamiFourteen(const unsigned char* input,
+                               unsigned long long inputByteLen,
+                               unsigned char* output,
+                               unsigned long long outputByteLen,
+                               const unsigned char* customization,
+                               unsigned long long customByteLen);
+
+#endif
@@ -23,10 +23,23 @@ HashReturn Keccak_HashInitialize(Keccak_HashInstance* instance,
                                  unsigned int capacity,
                                  unsigned int hashbitlen,
                                  unsigned char delimitedSuffix) {
+  return Keccak_HashInitializeWithRounds(
+      instance, rate, capacity, hashbitlen, delimitedSuffix, 24);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Keccak_HashInitializeWithRounds(Keccak_HashInstance* instance,
+                                           unsigned int rate,
+                                           unsigned int capacity,
+                                           unsigned int hashbitlen,
+                                           unsigned char delimitedSuffix,
+                                           unsigned int rounds) {
   HashReturn result;
 
   if (delimitedSuffix == 0) return FAIL;
-  result = Keccak_SpongeInitialize(&instance->sponge, rate, capacity);
+  result = Keccak_SpongeInitializeWithRounds(
+      &instance->sponge, rate, capacity, rounds);
   if (result != SUCCESS) return result;
   instance->fixedOutputLength = hashbitlen;
   instance->delimitedSuffix = delimitedSuffix;
@@ -64,6 +77,12 @@ HashReturn Keccak_HashUpdate(Keccak_HashInstance* instance,
   }
 }
 
+HashReturn Keccak_HashUpdateIov(Keccak_HashInstance* instance,
+                                const Keccak_Iovec* fragments,
+                                unsigned int fragmentCount) {
+  return Keccak_SpongeAbsorbIov(&instance->sponge, fragments, fragmentCount);
+}
+
 /* ---------------------------------------------------------------- */
 
 HashReturn Keccak_HashFinal(Keccak_HashInstance* instance,
@@ -85,3 +104,130 @@ HashReturn Keccak_HashSqueeze(Keccak_HashInstance* instance,
   if ((databitlen % 8) != 0) return FAIL;
   return Keccak_SpongeSqueeze(&instance->sponge, data, databitlen / 8);
 }
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Keccak_BufferedHashInitialize(
+    Keccak_BufferedHashInstance* bufferedInstance,
+    const Keccak_HashInstance* hashInstance) {
+  if (hashInstance->sponge.squeezing || (hashInstance->sponge.byteIOIndex != 0))
+    return FAIL;
+  bufferedInstance->hash = *hashInstance;
+  bufferedInstance->bufferByteLen = 0;
+  return SUCCESS;
+}
+
+HashReturn Keccak_BufferedHashUpdate(
+    Keccak_BufferedHashInstance* bufferedInstance,
+    const BitSequence* data,
+    unsigned long long dataByteLen) {
+  unsigned int rateInBytes = bufferedInstance->hash.sponge.rate / 8;
+  unsigned int room = rateInBytes - bufferedInstance->bufferByteLen;
+  unsigned long long wholeBlocksByteLen;
+
+  if (bufferedInstance->hash.sponge.squeezing) return FAIL;
+  if (dataByteLen < room) {
+    // Most fragments just go to the buffer
+    memcpy(bufferedInstance->buffer + bufferedInstance->bufferByteLen,
+           data,
+           (size_t)dataByteLen);
+    bufferedInstance->bufferByteLen += (unsigned int)dataByteLen;
+    return SUCCESS;
+  }
+  // The buffer is completed and absorbed as a whole block, then the whole
+  // blocks of data directly, and the rest is kept for later
+  if (bufferedInstance->bufferByteLen > 0) {
+    memcpy(bufferedInstance->buffer + bufferedInstance->bufferByteLen,
+           data,
+           room);
+    if ((HashReturn)Keccak_SpongeAbsorb(&bufferedInstance->hash.sponge,
+                                        bufferedInstance->buffer,
+                                        rateInBytes) != SUCCESS)
+      return FAIL;
+    data += room;
+    dataByteLen -= room;
+  }
+  wholeBlocksByteLen = dataByteLen - dataByteLen % rateInBytes;
+  if ((HashReturn)Keccak_SpongeAbsorb(
+          &bufferedInstance->hash.sponge, data, wholeBlocksByteLen) != SUCCESS)
+    return FAIL;
+  memcpy(bufferedInstance->buffer,
+         data + wholeBlocksByteLen,
+         (size_t)(dataByteLen - wholeBlocksByteLen));
+  bufferedInstance->bufferByteLen =
+      (unsigned int)(dataByteLen - wholeBlocksByteLen);
+  return SUCCESS;
+}
+
+HashReturn Keccak_BufferedHashFinal(
+    Keccak_BufferedHashInstance* bufferedInstance,
+    BitSequence* hashval) {
+  if ((HashReturn)Keccak_SpongeAbsorb(&bufferedInstance->hash.sponge,
+                                      bufferedInstance->buffer,
+                                      bufferedInstance->bufferByteLen) !=
+      SUCCESS)
+    return FAIL;
+  bufferedInstance->bufferByteLen = 0;
+  return Keccak_HashFinal(&bufferedInstance->hash, hashval);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Keccak_XOFReaderInitialize(Keccak_XOFReader* reader,
+                                      const Keccak_HashInstance* hashInstance) {
+  if ((hashInstance->fixedOutputLength != 0) ||
+      !hashInstance->sponge.squeezing)
+    return FAIL;
+  reader->hash = *hashInstance;
+  reader->bufferIndex = 0;
+  reader->bufferByteLen = 0;
+  return SUCCESS;
+}
+
+HashReturn Keccak_XOFReaderRefill(Keccak_XOFReader* reader) {
+  Keccak_SpongeInstance* sponge = &reader->hash.sponge;
+  unsigned int rateInBytes = sponge->rate / 8;
+  unsigned int length;
+
+  // Up to the end of the current block, normally a whole block
+  if (sponge->byteIOIndex < rateInBytes)
+    length = rateInBytes - sponge->byteIOIndex;
+  else
+    length = rateInBytes;
+  if ((HashReturn)Keccak_SpongeSqueeze(sponge, reader->buffer, length) !=
+      SUCCESS)
+    return FAIL;
+  reader->bufferIndex = 0;
+  reader->bufferByteLen = length;
+  return SUCCESS;
+}
+
+HashReturn Keccak_XOFReaderRead(Keccak_XOFReader* reader,
+                                unsigned char* data,
+                                unsigned long long dataByteLen) {
+  while (dataByteLen > 0) {
+    unsigned int length;
+    if (reader->bufferIndex == reader->bufferByteLen) {
+      unsigned int rateInBytes = reader->hash.sponge.rate / 8;
+      if ((dataByteLen >= rateInBytes) &&
+          (reader->hash.sponge.byteIOIndex == rateInBytes)) {
+        unsigned long long wholeBlocksByteLen =
+            dataByteLen - dataByteLen % rateInBytes;
+        if ((HashReturn)Keccak_SpongeSqueeze(
+                &reader->hash.sponge, data, wholeBlocksByteLen) != SUCCESS)
+          return FAIL;
+        data += wholeBlocksByteLen;
+        dataByteLen -= wholeBlocksByteLen;
+        continue;
+      }
+      if (Keccak_XOFReaderRefill(reader) != SUCCESS) return FAIL;
+    }
+    length = reader->bufferByteLen - reader->bufferIndex;
+    if (length > dataByteLen) length = (unsigned int)dataByteLen;
+    memcpy(data, reader->buffer + reader->bufferIndex, length);
+    reader->bufferIndex += length;
+    data += length;
+    dataByteLen -= length;
+  }
+  return SUCCESS;
+}
@@ -14,6 +14,7 @@ http://creativecommons.org/publicdomain/zero/1.0/
 #ifndef _KeccakHashInterface_h_
 #define _KeccakHashInterface_h_
 
+#include <stdint.h>
 #include "Constructions/KeccakSponge.h"
 
 typedef unsigned char BitSequence;
@@ -49,6 +50,20 @@ HashReturn Keccak_HashInitialize(Keccak_HashInstance* hashInstance,
                                  unsigned int hashbitlen,
                                  unsigned char delimitedSuffix);
 
+/**
+  * Function to initialize a hash instance on top of Keccak-p[1600, rounds],
+  * the last @a rounds rounds of Keccak-f[1600].
+  * Same as Keccak_HashInitialize() otherwise.
+  * @param  rounds      The number of rounds, 24 (Keccak-f[1600]), 14 or 12.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_HashInitializeWithRounds(Keccak_HashInstance* hashInstance,
+                                           unsigned int rate,
+                                           unsigned int capacity,
+                                           unsigned int hashbitlen,
+                                           unsigned char delimitedSuffix,
+                                           unsigned int rounds);
+
 /** Macro to initialize a SHAKE128 instance as specified in the FIPS 202 draft.
   */
 #define Keccak_HashInitialize_SHAKE128(hashInstance) \
@@ -59,6 +74,19 @@ HashReturn Keccak_HashInitialize(Keccak_HashInstance* hashInstance,
 #define Keccak_HashInitialize_SHAKE256(hashInstance) \
   Keccak_HashInitialize(hashInstance, 1088, 512, 0, 0x1F)
 
+/** Macro to initialize a TurboSHAKE128 instance, i.e., SHAKE128 with 12
+  * rounds and the domain separation byte @a domain in the range 0x01-0x7F.
+  * The usual choice for @a domain is 0x1F.
+  */
+#define Keccak_HashInitialize_TurboSHAKE128(hashInstance, domain) \
+  Keccak_HashInitializeWithRounds(hashInstance, 1344, 256, 0, domain, 12)
+
+/** Macro to initialize a TurboSHAKE256 instance, i.e., SHAKE256 with 12
+  * rounds and the domain separation byte @a domain in the range 0x01-0x7F.
+  */
+#define Keccak_HashInitialize_TurboSHAKE256(hashInstance, domain) \
+  Keccak_HashInitializeWithRounds(hashInstance, 1088, 512, 0, domain, 12)
+
 /** Macro to initialize a SHA3-224 instance as specified in the FIPS 202 draft.
   */
 #define Keccak_HashInitialize_SHA3_224(hashInstance) \
@@ -97,6 +125,22 @@ HashReturn Keccak_HashUpdate(Keccak_HashInstance* hashInstance,
                              const BitSequence* data,
                              DataLength databitlen);
 
+/**
+  * Function to give input data to be absorbed as a sequence of fragments of
+  * whole bytes, with the same effect as calling Keccak_HashUpdate() on each
+  * of them in turn. See Keccak_SpongeAbsorbIov().
+  * @param  hashInstance    Pointer to the hash instance initialized by
+  *                         Keccak_HashInitialize().
+  * @param  fragments   Pointer to the array of fragments.
+  * @param  fragmentCount   The number of fragments.
+  * @pre    In the previous call to Keccak_HashUpdate(), databitlen was a
+  *         multiple of 8.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_HashUpdateIov(Keccak_HashInstance* hashInstance,
+                                const Keccak_Iovec* fragments,
+                                unsigned int fragmentCount);
+
 /**
   * Function to call after all input blocks have been input and to get
   * output bits if the length was specified when calling
@@ -132,4 +176,174 @@ HashReturn Keccak_HashSqueeze(Keccak_HashInstance* hashInstance,
                               BitSequence* data,
                               DataLength databitlen);
 
+/* ---------------------------------------------------------------- */
+
+/**
+  * Structure that contains a hash instance with an input buffer of one
+  * block, for callers that give the input in many small fragments.
+  * Fragments are copied into the buffer, and the buffer is absorbed as whole
+  * lanes once it holds a full block, so that most updates cost little more
+  * than a memcpy.
+  */
+typedef struct {
+  /** The input buffer, with room for a block of the largest rate. */
+  ALIGN unsigned char buffer[KeccakF_width / 8];
+  /** The number of bytes in the buffer. */
+  unsigned int bufferByteLen;
+  /** The underlying hash instance, always on a block boundary. */
+  Keccak_HashInstance hash;
+} Keccak_BufferedHashInstance;
+
+/**
+  * Function to start a buffered hash computation from a hash instance,
+  * which can have been initialized by any of the Keccak_HashInitialize*
+  * functions, or have absorbed whole blocks, e.g., a key.
+  * @param  bufferedInstance    Pointer to the instance to be initialized.
+  * @param  hashInstance    Pointer to the hash instance to start from, which
+  *                         is copied.
+  * @pre    The hash instance is in the absorbing phase, on a block boundary.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_BufferedHashInitialize(
+    Keccak_BufferedHashInstance* bufferedInstance,
+    const Keccak_HashInstance* hashInstance);
+
+/**
+  * Function to give input data to be absorbed, as whole bytes.
+  * @param  bufferedInstance    Pointer to the instance initialized by
+  *                         Keccak_BufferedHashInitialize().
+  * @param  data        Pointer to the input data.
+  * @param  dataByteLen The number of input bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_BufferedHashUpdate(
+    Keccak_BufferedHashInstance* bufferedInstance,
+    const BitSequence* data,
+    unsigned long long dataByteLen);
+
+/**
+  * Function to call after all the input has been given, with the same
+  * semantics as Keccak_HashFinal(). Further output of an arbitrarily-long
+  * output function is then given by Keccak_HashSqueeze() on
+  * &@a bufferedInstance->hash.
+  * @param  bufferedInstance    Pointer to the instance initialized by
+  *                         Keccak_BufferedHashInitialize().
+  * @param  hashval     Pointer to the buffer where to store the output data.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_BufferedHashFinal(
+    Keccak_BufferedHashInstance* bufferedInstance,
+    BitSequence* hashval);
+
+/* ---------------------------------------------------------------- */
+
+/**
+  * Structure that contains a reader of the output of an arbitrarily-long
+  * output function, e.g., SHAKE128, for callers that read it a few bytes at
+  * a time. Each block of output is extracted at once into an aligned
+  * buffer, from which the reads are served, so that most reads only copy
+  * bytes from the buffer.
+  */
+typedef struct {
+  /** The current block of output. */
+  ALIGN unsigned char buffer[KeccakF_width / 8];
+  /** The position of the next byte to read in the buffer. */
+  unsigned int bufferIndex;
+  /** The number of bytes of output in the buffer. */
+  unsigned int bufferByteLen;
+  /** The underlying hash instance, in the squeezing phase. */
+  Keccak_HashInstance hash;
+} Keccak_XOFReader;
+
+/**
+  * Function to start reading the output of a hash instance.
+  * @param  reader      Pointer to the reader to be initialized.
+  * @param  hashInstance    Pointer to the hash instance, initialized with an
+  *                     output length of 0 and on which Keccak_HashFinal()
+  *                     has been called. It is copied, and the output it
+  *                     already gave is not read again.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_XOFReaderInitialize(Keccak_XOFReader* reader,
+                                      const Keccak_HashInstance* hashInstance);
+
+/**
+  * Function to fill the buffer of a reader with the next block of output.
+  * It is called by the other Keccak_XOFReader* functions when the buffer is
+  * exhausted.
+  * @param  reader      Pointer to the reader.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_XOFReaderRefill(Keccak_XOFReader* reader);
+
+/**
+  * Function to read output bytes. Large reads go directly from the
+  * permutation to @a data.
+  * @param  reader      Pointer to the reader.
+  * @param  data        Pointer to the buffer where to store the output.
+  * @param  dataByteLen The number of output bytes desired.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_XOFReaderRead(Keccak_XOFReader* reader,
+                                unsigned char* data,
+                                unsigned long long dataByteLen);
+
+/**
+  * Functions to read the next 1, 2, 4 or 8 bytes of output as an integer,
+  * the first byte being the least significant one. They do not report a
+  * failure of Keccak_XOFReaderRefill() or Keccak_XOFReaderRead(), which
+  * cannot happen once Keccak_XOFReaderInitialize() has succeeded.
+  * @param  reader      Pointer to the reader.
+  * @return The value read.
+  */
+static inline uint8_t Keccak_XOFReaderRead8(Keccak_XOFReader* reader) {
+  if (reader->bufferIndex == reader->bufferByteLen)
+    Keccak_XOFReaderRefill(reader);
+  return reader->buffer[reader->bufferIndex++];
+}
+
+static inline uint16_t Keccak_XOFReaderRead16(Keccak_XOFReader* reader) {
+  const unsigned char* bytes = reader->buffer + reader->bufferIndex;
+  unsigned char straddling[2];
+
+  if (reader->bufferIndex + 2 <= reader->bufferByteLen)
+    reader->bufferIndex += 2;
+  else {
+    Keccak_XOFReaderRead(reader, straddling, 2);
+    bytes = straddling;
+  }
+  return (uint16_t)(bytes[0] | ((uint16_t)bytes[1] << 8));
+}
+
+static inline uint32_t Keccak_XOFReaderRead32(Keccak_XOFReader* reader) {
+  const unsigned char* bytes = reader->buffer + reader->bufferIndex;
+  unsigned char straddling[4];
+
+  if (reader->bufferIndex + 4 <= reader->bufferByteLen)
+    reader->bufferIndex += 4;
+  else {
+    Keccak_XOFReaderRead(reader, straddling, 4);
+    bytes = straddling;
+  }
+  return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+         ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static inline uint64_t Keccak_XOFReaderRead64(Keccak_XOFReader* reader) {
+  const unsigned char* bytes = reader->buffer + reader->bufferIndex;
+  unsigned char straddling[8];
+  uint64_t value = 0;
+  int i;
+
+  if (reader->bufferIndex + 8 <= reader->bufferByteLen)
+    reader->bufferIndex += 8;
+  else {
+    Keccak_XOFReaderRead(reader, straddling, 8);
+    bytes = straddling;
+  }
+  for (i = 7; i >= 0; i--)
+    value = (value << 8) | bytes[i];
+  return value;
+}
+
 #endif
@@ -0,0 +1,133 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakHashChain.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <string.h>
+
+#define KeccakHashChain_rateInBytes 136
+#define KeccakHashChain_suffixSHAKE 0x1F
+
+/* ---------------------------------------------------------------- */
+
+// Builds the padded block of a chain, with the current value.
+static void KeccakHashChain_InitializeBlock(unsigned char* block,
+                                            const KeccakHashChain* chain,
+                                            unsigned int prefixByteLen,
+                                            unsigned int valueByteLen) {
+  memset(block, 0, KeccakHashChain_rateInBytes);
+  memcpy(block, chain->prefix, prefixByteLen);
+  memcpy(block + prefixByteLen, chain->value, valueByteLen);
+  block[prefixByteLen + valueByteLen] ^= KeccakHashChain_suffixSHAKE;
+  block[KeccakHashChain_rateInBytes - 1] ^= 0x80;
+}
+
+static void KeccakHashChain_SetIndex(unsigned char* block,
+                                     unsigned int indexOffset,
+                                     uint32_t index) {
+  block[indexOffset] = (unsigned char)(index >> 24);
+  block[indexOffset + 1] = (unsigned char)(index >> 16);
+  block[indexOffset + 2] = (unsigned char)(index >> 8);
+  block[indexOffset + 3] = (unsigned char)index;
+}
+
+// Iterates four chains in lockstep, until the longest one is complete.
+static void KeccakHashChain_IterateTimes4(KeccakHashChain* chains,
+                                          unsigned int prefixByteLen,
+                                          unsigned int indexOffset,
+                                          unsigned int valueByteLen) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char blocks[KeccakF1600times4_parallelism *
+                             KeccakHashChain_rateInBytes];
+  ALIGN unsigned char outputs[KeccakF1600times4_parallelism *
+                              KeccakHashChain_maxValueByteLen];
+  const unsigned int stride = KeccakHashChain_rateInBytes;
+  unsigned int i, step, maxSteps = 0;
+
+  for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+    KeccakHashChain_InitializeBlock(
+        blocks + i * stride, &chains[i], prefixByteLen, valueByteLen);
+    if (chains[i].steps > maxSteps) maxSteps = chains[i].steps;
+  }
+  for (step = 0; step < maxSteps; step++) {
+    for (i = 0; i < KeccakF1600times4_parallelism; i++)
+      KeccakHashChain_SetIndex(
+          blocks + i * stride, indexOffset, chains[i].start + step);
+    KeccakF1600times4_StateInitializeAll(states);
+    KeccakF1600times4_StateXORLanesAll(states, blocks, stride / 8, stride);
+    KeccakF1600times4_StatePermuteAll(states);
+    KeccakF1600times4_StateExtractLanesAll(states,
+                                           outputs,
+                                           valueByteLen / 8,
+                                           KeccakHashChain_maxValueByteLen);
+    // A chain that is already complete keeps its value
+    for (i = 0; i < KeccakF1600times4_parallelism; i++)
+      if (step < chains[i].steps)
+        memcpy(blocks + i * stride + prefixByteLen,
+               outputs + i * KeccakHashChain_maxValueByteLen,
+               valueByteLen);
+  }
+  for (i = 0; i < KeccakF1600times4_parallelism; i++)
+    memcpy(chains[i].value, blocks + i * stride + prefixByteLen, valueByteLen);
+}
+
+static void KeccakHashChain_IterateOne(KeccakHashChain* chain,
+                                       unsigned int prefixByteLen,
+                                       unsigned int indexOffset,
+                                       unsigned int valueByteLen) {
+  ALIGN unsigned char state[KeccakF_width / 8];
+  ALIGN unsigned char block[KeccakHashChain_rateInBytes];
+  ALIGN unsigned char output[KeccakHashChain_maxValueByteLen];
+  unsigned int step;
+
+  KeccakHashChain_InitializeBlock(block, chain, prefixByteLen, valueByteLen);
+  for (step = 0; step < chain->steps; step++) {
+    KeccakHashChain_SetIndex(block, indexOffset, chain->start + step);
+    KeccakF1600_StateInitialize(state);
+    KeccakF1600_StateXORLanes(state, block, KeccakHashChain_rateInBytes / 8);
+    KeccakF1600_StatePermute(state);
+    KeccakF1600_StateExtractLanes(state, output, valueByteLen / 8);
+    memcpy(block + prefixByteLen, output, valueByteLen);
+  }
+  memcpy(chain->value, block + prefixByteLen, valueByteLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakHashChain_Iterate(KeccakHashChain* chains,
+                                   unsigned int chainCount,
+                                   unsigned int prefixByteLen,
+                                   unsigned int indexOffset,
+                                   unsigned int valueByteLen) {
+  if ((indexOffset > prefixByteLen) || (prefixByteLen - indexOffset < 4))
+    return FAIL;
+  if (((valueByteLen % 8) != 0) ||
+      (valueByteLen > KeccakHashChain_maxValueByteLen))
+    return FAIL;
+  if (prefixByteLen + valueByteLen >= KeccakHashChain_rateInBytes) return FAIL;
+
+  for (; chainCount >= KeccakF1600times4_parallelism;
+       chainCount -= KeccakF1600times4_parallelism) {
+    KeccakHashChain_IterateTimes4(
+        chains, prefixByteLen, indexOffset, valueByteLen);
+    chains += KeccakF1600times4_parallelism;
+  }
+  for (; chainCount > 0; chainCount--) {
+    KeccakHashChain_IterateOne(
+        chains, prefixByteLen, indexOffset, valueByteLen);
+    chains++;
+  }
+  return SUCCESS;
+}
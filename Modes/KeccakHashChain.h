@@ -0,0 +1,71 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#ifndef _KeccakHashChain_h_
+#define _KeccakHashChain_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * Iteration of the short hash chains of WOTS+, XMSS or SPHINCS+ with
+  * SHAKE256. Each step of a chain replaces its value by the first bytes of
+  * SHAKE256(prefix || value), where the prefix (e.g., the public seed and
+  * the address) holds the index of the step as a 4-byte big-endian integer
+  * at a given offset (e.g., the hash address).
+  * Since the prefix, the value and the padding always fit in one block, the
+  * block of each chain is built once, and each step only updates the index
+  * and the value in place before permuting. The chains are processed four
+  * at a time with KeccakF1600times4_*, and the remaining ones with
+  * KeccakF1600_*. Chains are grouped in the order given, so giving them
+  * sorted by number of steps reduces the work wasted in a group.
+  */
+
+/** The maximum length in bytes of the value of a chain. */
+#define KeccakHashChain_maxValueByteLen 64
+
+/**
+  * Structure that describes one chain to iterate.
+  */
+typedef struct {
+  /** The value, which is replaced by the value at the end of the chain. */
+  unsigned char* value;
+  /** The prefix of the chain; its bytes at the offset of the index are
+    * ignored. */
+  const unsigned char* prefix;
+  /** The index of the first step. */
+  uint32_t start;
+  /** The number of steps. */
+  unsigned int steps;
+} KeccakHashChain;
+
+/**
+  * Function to iterate chains, each independently of the others.
+  * @param  chains          Pointer to the array of chains.
+  * @param  chainCount      The number of chains.
+  * @param  prefixByteLen   The length in bytes of the prefix of each chain.
+  * @param  indexOffset     The offset in the prefix of the index of the step.
+  * @param  valueByteLen    The length in bytes of the value of each chain.
+  * @pre    @a indexOffset + 4 ≤ @a prefixByteLen
+  * @pre    @a valueByteLen is a multiple of 8 and is at most
+  *         KeccakHashChain_maxValueByteLen.
+  * @pre    @a prefixByteLen + @a valueByteLen < 136
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakHashChain_Iterate(KeccakHashChain* chains,
+                                   unsigned int chainCount,
+                                   unsigned int prefixByteLen,
+                                   unsigned int indexOffset,
+                                   unsigned int valueByteLen);
+
+#endif
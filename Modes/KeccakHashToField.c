@@ -0,0 +1,323 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakHashToField.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <string.h>
+
+#define KeccakHashToField_suffixSHAKE 0x1F
+// The maximum length L, for a 66-byte p and k = 256
+#define KeccakHashToField_maxChunkByteLen \
+  ((KeccakHashToField_maxModulusByteLen * 8 + 256 + 7) / 8)
+#define KeccakHashToField_maxUniformByteLen \
+  (KeccakHashToField_maxComponentCount * KeccakHashToField_maxChunkByteLen)
+
+/* ---------------------------------------------------------------- */
+
+// Writes I2OSP(outputByteLen, 2) || DST_prime, which follows the message.
+static unsigned int KeccakHashToField_Trailer(
+    const KeccakHashToField_Instance* instance,
+    unsigned int outputByteLen,
+    unsigned char* trailer) {
+  trailer[0] = (unsigned char)(outputByteLen >> 8);
+  trailer[1] = (unsigned char)outputByteLen;
+  memcpy(trailer + 2, instance->DSTPrime, instance->DSTPrimeByteLen);
+  return 2 + instance->DSTPrimeByteLen;
+}
+
+// XORs into one of the four states the bytes of message || trailer from
+// the given position on.
+static void KeccakHashToField_XORStream(void* states,
+                                        unsigned int instanceIndex,
+                                        const unsigned char* message,
+                                        unsigned long long messageByteLen,
+                                        const unsigned char* trailer,
+                                        unsigned long long position,
+                                        unsigned int length) {
+  unsigned int offset = 0;
+
+  if (position < messageByteLen) {
+    unsigned int fromMessage = (messageByteLen - position < length)
+                                   ? (unsigned int)(messageByteLen - position)
+                                   : length;
+    KeccakF1600times4_StateXORBytes(
+        states, instanceIndex, message + position, 0, fromMessage);
+    offset = fromMessage;
+  }
+  if (offset < length)
+    KeccakF1600times4_StateXORBytes(states,
+                                    instanceIndex,
+                                    trailer + (position + offset) -
+                                        messageByteLen,
+                                    offset,
+                                    length - offset);
+}
+
+// Reduces a chunk of L bytes, read as a big-endian integer, mod p, and
+// writes the result in big-endian order. The bits of the chunk are shifted
+// in one at a time, each followed by a conditional subtraction of p done
+// with masks.
+static void KeccakHashToField_Reduce(const KeccakHashToField_Instance* instance,
+                                     const unsigned char* chunk,
+                                     unsigned char* component) {
+  const unsigned int wordCount = instance->modulusWordCount;
+  const unsigned int bitLen = instance->chunkByteLen * 8;
+  uint32_t r[(KeccakHashToField_maxModulusByteLen + 3) / 4 + 1];
+  uint32_t t[(KeccakHashToField_maxModulusByteLen + 3) / 4 + 1];
+  unsigned int i, j, bit;
+
+  // The first bits of the chunk are less than p as they are
+  memset(r, 0, sizeof(r));
+  for (bit = 0; bit < instance->modulusBitLen - 1; bit++) {
+    j = bitLen - (instance->modulusBitLen - 1) + bit;
+    r[bit / 32] |= (uint32_t)((chunk[instance->chunkByteLen - 1 - j / 8] >>
+                               (j % 8)) &
+                              1)
+                   << (bit % 32);
+  }
+  for (j = bitLen - instance->modulusBitLen + 1; j > 0; j--) {
+    uint32_t carry = (chunk[instance->chunkByteLen - 1 - (j - 1) / 8] >>
+                      ((j - 1) % 8)) &
+                     1;
+    uint64_t borrow = 0;
+    uint32_t mask;
+    for (i = 0; i <= wordCount; i++) {
+      uint32_t top = r[i] >> 31;
+      r[i] = (r[i] << 1) | carry;
+      carry = top;
+    }
+    for (i = 0; i <= wordCount; i++) {
+      uint64_t d = (uint64_t)r[i] -
+                   ((i < wordCount) ? instance->modulus[i] : 0) - borrow;
+      t[i] = (uint32_t)d;
+      borrow = (d >> 63) & 1;
+    }
+    // All ones if r ≥ p
+    mask = (uint32_t)borrow - 1;
+    for (i = 0; i <= wordCount; i++)
+      r[i] = (t[i] & mask) | (r[i] & ~mask);
+  }
+  for (j = 0; j < instance->modulusByteLen; j++)
+    component[instance->modulusByteLen - 1 - j] =
+        (j / 4 < wordCount) ? (unsigned char)(r[j / 4] >> (8 * (j % 4))) : 0;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakHashToField_Initialize(KeccakHashToField_Instance* instance,
+                                        unsigned int securityLevel,
+                                        const unsigned char* modulus,
+                                        unsigned int modulusByteLen,
+                                        unsigned int extensionDegree,
+                                        const unsigned char* DST,
+                                        unsigned long long DSTByteLen) {
+  unsigned int i, leadingZeros = 0;
+
+  if ((securityLevel < 1) || (securityLevel > 256)) return FAIL;
+  if ((modulusByteLen < 1) ||
+      (modulusByteLen > KeccakHashToField_maxModulusByteLen))
+    return FAIL;
+  if (extensionDegree < 1) return FAIL;
+
+  instance->securityLevel = securityLevel;
+  instance->rateInBytes = (securityLevel <= 128) ? 168 : 136;
+  if (DSTByteLen > 255) {
+    // DST = SHAKE("H2C-OVERSIZE-DST-" || DST, ⌈2k / 8⌉)
+    static const char oversize[] = "H2C-OVERSIZE-DST-";
+    Keccak_SpongeInstance sponge;
+    Keccak_SpongeInitialize(&sponge,
+                            instance->rateInBytes * 8,
+                            1600 - instance->rateInBytes * 8);
+    Keccak_SpongeAbsorb(
+        &sponge, (const unsigned char*)oversize, sizeof(oversize) - 1);
+    Keccak_SpongeAbsorb(&sponge, DST, DSTByteLen);
+    Keccak_SpongeAbsorbLastFewBits(&sponge, KeccakHashToField_suffixSHAKE);
+    instance->DSTPrimeByteLen = (2 * securityLevel + 7) / 8;
+    Keccak_SpongeSqueeze(
+        &sponge, instance->DSTPrime, instance->DSTPrimeByteLen);
+  } else {
+    memcpy(instance->DSTPrime, DST, (size_t)DSTByteLen);
+    instance->DSTPrimeByteLen = (unsigned int)DSTByteLen;
+  }
+  instance->DSTPrime[instance->DSTPrimeByteLen] =
+      (unsigned char)instance->DSTPrimeByteLen;
+  instance->DSTPrimeByteLen++;
+
+  // p as words, and its number of bits
+  memset(instance->modulus, 0, sizeof(instance->modulus));
+  for (i = 0; i < modulusByteLen; i++)
+    instance->modulus[i / 4] |= (uint32_t)modulus[modulusByteLen - 1 - i]
+                                << (8 * (i % 4));
+  for (i = 0; (i < modulusByteLen) && (modulus[i] == 0); i++)
+    leadingZeros += 8;
+  if (i == modulusByteLen) return FAIL;
+  for (; (modulus[i] << (leadingZeros % 8)) < 0x80; leadingZeros++)
+    ;
+  instance->modulusBitLen = modulusByteLen * 8 - leadingZeros;
+  if (instance->modulusBitLen < 2) return FAIL;
+  instance->modulusWordCount = (instance->modulusBitLen + 31) / 32;
+  instance->modulusByteLen = modulusByteLen;
+  instance->extensionDegree = extensionDegree;
+  instance->chunkByteLen = (instance->modulusBitLen + securityLevel + 7) / 8;
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakHashToField_ExpandMessage(
+    const KeccakHashToField_Instance* instance,
+    const unsigned char* message,
+    unsigned long long messageByteLen,
+    unsigned char* output,
+    unsigned int outputByteLen) {
+  unsigned char trailer[2 + 256];
+  unsigned int trailerByteLen;
+  Keccak_SpongeInstance sponge;
+
+  if (outputByteLen > 65535) return FAIL;
+  trailerByteLen = KeccakHashToField_Trailer(instance, outputByteLen, trailer);
+  Keccak_SpongeInitialize(&sponge,
+                          instance->rateInBytes * 8,
+                          1600 - instance->rateInBytes * 8);
+  Keccak_SpongeAbsorb(&sponge, message, messageByteLen);
+  Keccak_SpongeAbsorb(&sponge, trailer, trailerByteLen);
+  Keccak_SpongeAbsorbLastFewBits(&sponge, KeccakHashToField_suffixSHAKE);
+  Keccak_SpongeSqueeze(&sponge, output, outputByteLen);
+  return SUCCESS;
+}
+
+HashReturn KeccakHashToField_ExpandMessageTimes4(
+    const KeccakHashToField_Instance* instance,
+    const unsigned char* const messages[4],
+    const unsigned long long messageByteLens[4],
+    unsigned char* outputs[4],
+    unsigned int outputByteLen) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  const unsigned char suffix = KeccakHashToField_suffixSHAKE;
+  const unsigned char lastByte = 0x80;
+  const unsigned int rateInBytes = instance->rateInBytes;
+  const unsigned int outputBlockCount =
+      (outputByteLen + rateInBytes - 1) / rateInBytes;
+  unsigned char trailer[2 + 256];
+  unsigned int trailerByteLen;
+  unsigned long long absorbBlockCounts[KeccakF1600times4_parallelism];
+  unsigned long long step, stepCount = 0;
+  unsigned int i;
+
+  if (outputByteLen > 65535) return FAIL;
+  trailerByteLen = KeccakHashToField_Trailer(instance, outputByteLen, trailer);
+  // The number of blocks of each stream, the last one with the padding
+  for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+    absorbBlockCounts[i] =
+        (messageByteLens[i] + trailerByteLen) / rateInBytes + 1;
+    if (absorbBlockCounts[i] + outputBlockCount - 1 > stepCount)
+      stepCount = absorbBlockCounts[i] + outputBlockCount - 1;
+  }
+
+  // At each step, a stream that is still absorbing gets its next block, and
+  // a stream that is squeezing gets its next output block
+  KeccakF1600times4_StateInitializeAll(states);
+  for (step = 0; step < stepCount; step++) {
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      unsigned long long position = step * rateInBytes;
+      if (step + 1 < absorbBlockCounts[i])
+        KeccakHashToField_XORStream(states,
+                                    i,
+                                    messages[i],
+                                    messageByteLens[i],
+                                    trailer,
+                                    position,
+                                    rateInBytes);
+      else if (step + 1 == absorbBlockCounts[i]) {
+        unsigned int partialLen = (unsigned int)(messageByteLens[i] +
+                                                 trailerByteLen - position);
+        KeccakHashToField_XORStream(states,
+                                    i,
+                                    messages[i],
+                                    messageByteLens[i],
+                                    trailer,
+                                    position,
+                                    partialLen);
+        KeccakF1600times4_StateXORBytes(states, i, &suffix, partialLen, 1);
+        KeccakF1600times4_StateXORBytes(
+            states, i, &lastByte, rateInBytes - 1, 1);
+      }
+    }
+    KeccakF1600times4_StatePermuteAll(states);
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      if ((step + 1 >= absorbBlockCounts[i]) &&
+          (step + 1 - absorbBlockCounts[i] < outputBlockCount)) {
+        unsigned int offset =
+            (unsigned int)(step + 1 - absorbBlockCounts[i]) * rateInBytes;
+        unsigned int length = (outputByteLen - offset < rateInBytes)
+                                  ? outputByteLen - offset
+                                  : rateInBytes;
+        KeccakF1600times4_StateExtractBytes(
+            states, i, outputs[i] + offset, 0, length);
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakHashToField_HashToField(
+    const KeccakHashToField_Instance* instance,
+    const unsigned char* const* messages,
+    const unsigned long long* messageByteLens,
+    unsigned int messageCount,
+    unsigned int count,
+    unsigned char* elements) {
+  unsigned char uniform[KeccakF1600times4_parallelism]
+                       [KeccakHashToField_maxUniformByteLen];
+  unsigned char* outputs[KeccakF1600times4_parallelism];
+  const unsigned int componentCount = count * instance->extensionDegree;
+  const unsigned int uniformByteLen = componentCount * instance->chunkByteLen;
+  const unsigned int elementsByteLen =
+      componentCount * instance->modulusByteLen;
+  unsigned int i, j, groupCount;
+
+  if ((count < 1) || (componentCount > KeccakHashToField_maxComponentCount))
+    return FAIL;
+  for (i = 0; i < KeccakF1600times4_parallelism; i++)
+    outputs[i] = uniform[i];
+
+  while (messageCount > 0) {
+    if (messageCount >= KeccakF1600times4_parallelism) {
+      groupCount = KeccakF1600times4_parallelism;
+      KeccakHashToField_ExpandMessageTimes4(
+          instance, messages, messageByteLens, outputs, uniformByteLen);
+    } else {
+      groupCount = 1;
+      KeccakHashToField_ExpandMessage(instance,
+                                      messages[0],
+                                      messageByteLens[0],
+                                      uniform[0],
+                                      uniformByteLen);
+    }
+    for (i = 0; i < groupCount; i++)
+      for (j = 0; j < componentCount; j++)
+        KeccakHashToField_Reduce(instance,
+                                 uniform[i] + j * instance->chunkByteLen,
+                                 elements + i * elementsByteLen +
+                                     j * instance->modulusByteLen);
+    messages += groupCount;
+    messageByteLens += groupCount;
+    messageCount -= groupCount;
+    elements += groupCount * elementsByteLen;
+  }
+  return SUCCESS;
+}
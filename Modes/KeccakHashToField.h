@@ -0,0 +1,138 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#ifndef _KeccakHashToField_h_
+#define _KeccakHashToField_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * expand_message_xof and hash_to_field as in RFC 9380, "Hashing to Elliptic
+  * Curves", with SHAKE128 for a security level of 128 bits and SHAKE256 for
+  * higher ones.
+  * An instance holds the parameters shared by all messages: the XOF, the
+  * domain separation tag DST (hashed first if longer than 255 bytes) and the
+  * field GF(p^m). expand_message_xof computes
+  * SHAKE(msg || I2OSP(len_in_bytes, 2) || DST || I2OSP(len(DST), 1)), and
+  * hash_to_field reduces mod p each L-byte chunk of the expanded message,
+  * with L = ⌈(⌈log2(p)⌉ + k) / 8⌉.
+  * Messages are expanded four at a time with KeccakF1600times4_*, each at its
+  * own pace when their lengths differ.
+  */
+
+/** The maximum length in bytes of the characteristic p of the field. */
+#define KeccakHashToField_maxModulusByteLen 66
+/** The maximum number of components (count × m) derived from a message. */
+#define KeccakHashToField_maxComponentCount 8
+
+/**
+  * Structure that contains the parameters of hash_to_field.
+  */
+typedef struct {
+  /** The security level k in bits. */
+  unsigned int securityLevel;
+  /** The rate in bytes of the XOF. */
+  unsigned int rateInBytes;
+  /** DST || I2OSP(len(DST), 1), with DST already hashed if oversized. */
+  unsigned char DSTPrime[256];
+  /** The length of @a DSTPrime in bytes. */
+  unsigned int DSTPrimeByteLen;
+  /** p as 32-bit words, least significant first. */
+  uint32_t modulus[(KeccakHashToField_maxModulusByteLen + 3) / 4];
+  /** The number of words of p. */
+  unsigned int modulusWordCount;
+  /** The number of bits of p. */
+  unsigned int modulusBitLen;
+  /** The length in bytes of a component of an element. */
+  unsigned int modulusByteLen;
+  /** The extension degree m. */
+  unsigned int extensionDegree;
+  /** The length L in bytes of the chunk reduced into a component. */
+  unsigned int chunkByteLen;
+} KeccakHashToField_Instance;
+
+/**
+  * Function to initialize the parameters.
+  * @param  instance        Pointer to the instance to be initialized.
+  * @param  securityLevel   The security level k in bits, from 1 to 256;
+  *                         SHAKE128 is used if k ≤ 128, SHAKE256 otherwise.
+  * @param  modulus         Pointer to p, in big-endian order.
+  * @param  modulusByteLen  The length of p in bytes, which is also the
+  *                         length of the components output.
+  * @param  extensionDegree The extension degree m.
+  * @param  DST             Pointer to the domain separation tag.
+  * @param  DSTByteLen      The length of the tag in bytes.
+  * @pre    @a modulusByteLen ≤ KeccakHashToField_maxModulusByteLen
+  * @pre    p ≥ 2
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakHashToField_Initialize(KeccakHashToField_Instance* instance,
+                                        unsigned int securityLevel,
+                                        const unsigned char* modulus,
+                                        unsigned int modulusByteLen,
+                                        unsigned int extensionDegree,
+                                        const unsigned char* DST,
+                                        unsigned long long DSTByteLen);
+
+/**
+  * Function to compute expand_message_xof(msg, DST, len_in_bytes).
+  * @param  instance        Pointer to the instance.
+  * @param  message         Pointer to the message.
+  * @param  messageByteLen  The length of the message in bytes.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputByteLen   The length in bytes of the output len_in_bytes.
+  * @pre    @a outputByteLen ≤ 65535
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakHashToField_ExpandMessage(
+    const KeccakHashToField_Instance* instance,
+    const unsigned char* message,
+    unsigned long long messageByteLen,
+    unsigned char* output,
+    unsigned int outputByteLen);
+
+/**
+  * Same as KeccakHashToField_ExpandMessage(), but for four messages of
+  * possibly different lengths in parallel.
+  */
+HashReturn KeccakHashToField_ExpandMessageTimes4(
+    const KeccakHashToField_Instance* instance,
+    const unsigned char* const messages[4],
+    const unsigned long long messageByteLens[4],
+    unsigned char* outputs[4],
+    unsigned int outputByteLen);
+
+/**
+  * Function to compute hash_to_field(msg, count) for each of a list of
+  * messages. The elements of a message are output one after the other, each
+  * as its m components of @a modulusByteLen bytes in big-endian order.
+  * @param  instance        Pointer to the instance.
+  * @param  messages        Pointer to the array of messages.
+  * @param  messageByteLens Pointer to the array of their lengths in bytes.
+  * @param  messageCount    The number of messages.
+  * @param  count           The number of elements per message.
+  * @param  elements        Pointer to the buffer where to store the
+  *                         elements.
+  * @pre    @a count × m ≤ KeccakHashToField_maxComponentCount
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakHashToField_HashToField(
+    const KeccakHashToField_Instance* instance,
+    const unsigned char* const* messages,
+    const unsigned long long* messageByteLens,
+    unsigned int messageCount,
+    unsigned int count,
+    unsigned char* elements);
+
+#endif
@@ -0,0 +1,280 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakMerkleTree.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <string.h>
+
+// SHA3-256 and SHAKE256 have the same rate.
+#define KeccakMerkleTree_rate 1088
+#define KeccakMerkleTree_rateInBytes (KeccakMerkleTree_rate / 8)
+
+/* ---------------------------------------------------------------- */
+
+static int KeccakMerkleTree_CheckParameters(
+    const KeccakMerkleTree_Parameters* parameters) {
+  if ((parameters->arity < 2) ||
+      (parameters->arity > KeccakMerkleTree_maxArity))
+    return 0;
+  return (parameters->delimitedSuffix == KeccakMerkleTree_SHA3_256) ||
+         (parameters->delimitedSuffix == KeccakMerkleTree_SHAKE256);
+}
+
+// Hashes domain || data into a node.
+static void KeccakMerkleTree_HashOne(
+    const KeccakMerkleTree_Parameters* parameters,
+    unsigned char domain,
+    const unsigned char* data,
+    unsigned long long dataByteLen,
+    unsigned char* output) {
+  Keccak_SpongeInstance sponge;
+
+  Keccak_SpongeInitialize(
+      &sponge, KeccakMerkleTree_rate, 1600 - KeccakMerkleTree_rate);
+  Keccak_SpongeAbsorb(&sponge, &domain, 1);
+  Keccak_SpongeAbsorb(&sponge, data, dataByteLen);
+  Keccak_SpongeAbsorbLastFewBits(&sponge, parameters->delimitedSuffix);
+  Keccak_SpongeSqueeze(&sponge, output, KeccakMerkleTree_nodeSize);
+}
+
+// Hashes domain || data_i into four consecutive nodes, where data_i starts
+// i * dataStride bytes after data. The data are read entirely before the
+// nodes are written.
+static void KeccakMerkleTree_HashTimes4(
+    const KeccakMerkleTree_Parameters* parameters,
+    unsigned char domain,
+    const unsigned char* data,
+    unsigned long long dataStride,
+    unsigned long long dataByteLen,
+    unsigned char* outputs) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char blocks[KeccakF1600times4_parallelism *
+                             KeccakMerkleTree_rateInBytes];
+  ALIGN unsigned char digests[KeccakF1600times4_parallelism *
+                              KeccakMerkleTree_nodeSize];
+  const unsigned int rateInBytes = KeccakMerkleTree_rateInBytes;
+  const unsigned long long messageByteLen = 1 + dataByteLen;
+  unsigned long long position = 0;
+  unsigned int i, blockByteLen;
+
+  KeccakF1600times4_StateInitializeAll(states);
+  // The blocks of the four messages are gathered side by side, the last
+  // one, possibly empty, with the padding
+  do {
+    blockByteLen = (messageByteLen - position < rateInBytes)
+                       ? (unsigned int)(messageByteLen - position)
+                       : rateInBytes;
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      unsigned char* block = blocks + i * rateInBytes;
+      const unsigned char* source = data + i * dataStride;
+      if (position == 0) {
+        block[0] = domain;
+        memcpy(block + 1, source, blockByteLen - 1);
+      } else
+        memcpy(block, source + position - 1, blockByteLen);
+      if (blockByteLen < rateInBytes) {
+        memset(block + blockByteLen, 0, rateInBytes - blockByteLen);
+        block[blockByteLen] ^= parameters->delimitedSuffix;
+        block[rateInBytes - 1] ^= 0x80;
+      }
+    }
+    KeccakF1600times4_StateXORLanesAll(
+        states, blocks, rateInBytes / 8, rateInBytes);
+    KeccakF1600times4_StatePermuteAll(states);
+    position += blockByteLen;
+  } while (blockByteLen == rateInBytes);
+  KeccakF1600times4_StateExtractLanesAll(states,
+                                         digests,
+                                         KeccakMerkleTree_nodeSize / 8,
+                                         KeccakMerkleTree_nodeSize);
+  memcpy(outputs, digests, sizeof(digests));
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakMerkleTree_HashLeaves(
+    const KeccakMerkleTree_Parameters* parameters,
+    const unsigned char* leaves,
+    unsigned int leafByteLen,
+    unsigned long long leafCount,
+    unsigned char* digests) {
+  if (!KeccakMerkleTree_CheckParameters(parameters)) return FAIL;
+
+  for (; leafCount >= KeccakF1600times4_parallelism;
+       leafCount -= KeccakF1600times4_parallelism) {
+    KeccakMerkleTree_HashTimes4(parameters,
+                                parameters->leafDomain,
+                                leaves,
+                                leafByteLen,
+                                leafByteLen,
+                                digests);
+    leaves += KeccakF1600times4_parallelism * leafByteLen;
+    digests += KeccakF1600times4_parallelism * KeccakMerkleTree_nodeSize;
+  }
+  for (; leafCount > 0; leafCount--) {
+    KeccakMerkleTree_HashOne(
+        parameters, parameters->leafDomain, leaves, leafByteLen, digests);
+    leaves += leafByteLen;
+    digests += KeccakMerkleTree_nodeSize;
+  }
+  return SUCCESS;
+}
+
+HashReturn KeccakMerkleTree_HashNodes(
+    const KeccakMerkleTree_Parameters* parameters,
+    const unsigned char* children,
+    unsigned long long childCount,
+    unsigned char* parents) {
+  unsigned int groupByteLen;
+  unsigned long long parentCount;
+
+  if (!KeccakMerkleTree_CheckParameters(parameters)) return FAIL;
+  groupByteLen = parameters->arity * KeccakMerkleTree_nodeSize;
+  parentCount = childCount / parameters->arity;
+
+  // Writing a parent only overwrites children already hashed, so that
+  // parents can be equal to children
+  for (; parentCount >= KeccakF1600times4_parallelism;
+       parentCount -= KeccakF1600times4_parallelism) {
+    KeccakMerkleTree_HashTimes4(parameters,
+                                parameters->nodeDomain,
+                                children,
+                                groupByteLen,
+                                groupByteLen,
+                                parents);
+    children += KeccakF1600times4_parallelism * groupByteLen;
+    parents += KeccakF1600times4_parallelism * KeccakMerkleTree_nodeSize;
+  }
+  for (; parentCount > 0; parentCount--) {
+    KeccakMerkleTree_HashOne(
+        parameters, parameters->nodeDomain, children, groupByteLen, parents);
+    children += groupByteLen;
+    parents += KeccakMerkleTree_nodeSize;
+  }
+  // The last parent, with the remaining children
+  if ((childCount % parameters->arity) != 0)
+    KeccakMerkleTree_HashOne(
+        parameters,
+        parameters->nodeDomain,
+        children,
+        (childCount % parameters->arity) * KeccakMerkleTree_nodeSize,
+        parents);
+  return SUCCESS;
+}
+
+HashReturn KeccakMerkleTree_ComputeRoot(
+    const KeccakMerkleTree_Parameters* parameters,
+    const unsigned char* leaves,
+    unsigned int leafByteLen,
+    unsigned long long leafCount,
+    unsigned char* workspace,
+    unsigned char* root) {
+  unsigned long long nodeCount = leafCount;
+
+  if (leafCount == 0) return FAIL;
+  if (KeccakMerkleTree_HashLeaves(
+          parameters, leaves, leafByteLen, leafCount, workspace) != SUCCESS)
+    return FAIL;
+  while (nodeCount > 1) {
+    KeccakMerkleTree_HashNodes(parameters, workspace, nodeCount, workspace);
+    nodeCount = (nodeCount + parameters->arity - 1) / parameters->arity;
+  }
+  memcpy(root, workspace, KeccakMerkleTree_nodeSize);
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakMerkleTree_Initialize(
+    KeccakMerkleTree_Instance* instance,
+    const KeccakMerkleTree_Parameters* parameters) {
+  if (!KeccakMerkleTree_CheckParameters(parameters)) return FAIL;
+  instance->parameters = *parameters;
+  memset(instance->pendingCount, 0, sizeof(instance->pendingCount));
+  instance->leafCount = 0;
+  return SUCCESS;
+}
+
+HashReturn KeccakMerkleTree_Append(KeccakMerkleTree_Instance* instance,
+                                   const unsigned char* leaf,
+                                   unsigned long long leafByteLen) {
+  const KeccakMerkleTree_Parameters* parameters = &instance->parameters;
+  unsigned char group[KeccakMerkleTree_maxArity * KeccakMerkleTree_nodeSize];
+  unsigned char node[KeccakMerkleTree_nodeSize];
+  unsigned int level;
+
+  KeccakMerkleTree_HashOne(
+      parameters, parameters->leafDomain, leaf, leafByteLen, node);
+  // Each node that completes a group completes the parent of the group
+  for (level = 0; level < KeccakMerkleTree_maxLevels; level++) {
+    unsigned int count = instance->pendingCount[level];
+    if (count < parameters->arity - 1) {
+      memcpy(instance->pending[level] + count * KeccakMerkleTree_nodeSize,
+             node,
+             KeccakMerkleTree_nodeSize);
+      instance->pendingCount[level]++;
+      instance->leafCount++;
+      return SUCCESS;
+    }
+    memcpy(group, instance->pending[level], count * KeccakMerkleTree_nodeSize);
+    memcpy(group + count * KeccakMerkleTree_nodeSize,
+           node,
+           KeccakMerkleTree_nodeSize);
+    KeccakMerkleTree_HashOne(parameters,
+                             parameters->nodeDomain,
+                             group,
+                             parameters->arity * KeccakMerkleTree_nodeSize,
+                             node);
+    instance->pendingCount[level] = 0;
+  }
+  return FAIL;
+}
+
+HashReturn KeccakMerkleTree_Root(const KeccakMerkleTree_Instance* instance,
+                                 unsigned char* root) {
+  const KeccakMerkleTree_Parameters* parameters = &instance->parameters;
+  unsigned char group[KeccakMerkleTree_maxArity * KeccakMerkleTree_nodeSize];
+  unsigned char carry[KeccakMerkleTree_nodeSize];
+  unsigned long long nodeCount = instance->leafCount;
+  unsigned int level = 0;
+  int hasCarry = 0;
+
+  if (nodeCount == 0) return FAIL;
+  // The last node of each level is made of the pending nodes of the level
+  // below, followed by the last node of that level if it is incomplete
+  for (; nodeCount > 1; level++) {
+    unsigned int count = instance->pendingCount[level];
+    memcpy(group, instance->pending[level], count * KeccakMerkleTree_nodeSize);
+    if (hasCarry) {
+      memcpy(group + count * KeccakMerkleTree_nodeSize,
+             carry,
+             KeccakMerkleTree_nodeSize);
+      count++;
+    }
+    if (count > 0) {
+      KeccakMerkleTree_HashOne(parameters,
+                               parameters->nodeDomain,
+                               group,
+                               count * KeccakMerkleTree_nodeSize,
+                               carry);
+      hasCarry = 1;
+    }
+    nodeCount = (nodeCount + parameters->arity - 1) / parameters->arity;
+  }
+  memcpy(root,
+         hasCarry ? carry : instance->pending[level],
+         KeccakMerkleTree_nodeSize);
+  return SUCCESS;
+}
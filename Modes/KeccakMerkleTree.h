@@ -0,0 +1,169 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#ifndef _KeccakMerkleTree_h_
+#define _KeccakMerkleTree_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * Merkle trees with 32-byte nodes, computed with SHA3-256 or with SHAKE256
+  * truncated to 256 bits.
+  * A leaf is hashed as H(leafDomain || leaf), and a node as
+  * H(nodeDomain || child_1 || ... || child_k), with k the arity of the tree,
+  * except for the last node of a level, which has the remaining children if
+  * their number is not a multiple of the arity. The levels are built until
+  * one node remains, which is the root.
+  * Nodes are hashed four at a time with KeccakF1600times4_*. The functions
+  * that hash a level have no side effect other than writing the digests, so
+  * a large level can be split in ranges that are processed concurrently,
+  * e.g., by different threads.
+  * Alternatively, a tree can be built incrementally, one leaf at a time,
+  * keeping only the incomplete nodes on the right edge of the tree.
+  */
+
+/** The size in bytes of a node. */
+#define KeccakMerkleTree_nodeSize 32
+/** The maximum arity of a tree. */
+#define KeccakMerkleTree_maxArity 8
+/** The maximum number of levels of a tree built incrementally. */
+#define KeccakMerkleTree_maxLevels 48
+/** The delimited suffixes of the supported hash functions. */
+#define KeccakMerkleTree_SHA3_256 0x06
+#define KeccakMerkleTree_SHAKE256 0x1F
+
+/**
+  * Structure that contains the parameters of a tree.
+  */
+typedef struct {
+  /** The number of children of a node, from 2 to KeccakMerkleTree_maxArity.
+    */
+  unsigned int arity;
+  /** The hash function, KeccakMerkleTree_SHA3_256 or
+    * KeccakMerkleTree_SHAKE256. */
+  unsigned char delimitedSuffix;
+  /** The byte prepended to a leaf before hashing it. */
+  unsigned char leafDomain;
+  /** The byte prepended to the children of a node before hashing them. */
+  unsigned char nodeDomain;
+} KeccakMerkleTree_Parameters;
+
+/**
+  * Structure that contains a tree being built incrementally.
+  */
+typedef struct {
+  /** The parameters of the tree. */
+  KeccakMerkleTree_Parameters parameters;
+  /** For each level, the complete nodes whose parent is not complete yet. */
+  unsigned char pending[KeccakMerkleTree_maxLevels]
+                       [(KeccakMerkleTree_maxArity - 1) *
+                        KeccakMerkleTree_nodeSize];
+  /** For each level, the number of nodes in @a pending. */
+  unsigned char pendingCount[KeccakMerkleTree_maxLevels];
+  /** The number of leaves appended so far. */
+  unsigned long long leafCount;
+} KeccakMerkleTree_Instance;
+
+/**
+  * Function to hash consecutive leaves of the same length.
+  * @param  parameters      Pointer to the parameters of the tree.
+  * @param  leaves          Pointer to the first leaf.
+  * @param  leafByteLen     The length of each leaf in bytes.
+  * @param  leafCount       The number of leaves.
+  * @param  digests         Pointer to the buffer where to store the
+  *                         KeccakMerkleTree_nodeSize-byte digests.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakMerkleTree_HashLeaves(
+    const KeccakMerkleTree_Parameters* parameters,
+    const unsigned char* leaves,
+    unsigned int leafByteLen,
+    unsigned long long leafCount,
+    unsigned char* digests);
+
+/**
+  * Function to hash the nodes of a level into the nodes of the level above.
+  * The children of a range of parents can also be given, as long as the
+  * range starts at a multiple of the arity.
+  * @param  parameters      Pointer to the parameters of the tree.
+  * @param  children        Pointer to the nodes of the level.
+  * @param  childCount      The number of nodes of the level.
+  * @param  parents         Pointer to the buffer where to store the
+  *                         ⌈@a childCount / arity⌉ parents. It may be equal
+  *                         to @a children.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakMerkleTree_HashNodes(
+    const KeccakMerkleTree_Parameters* parameters,
+    const unsigned char* children,
+    unsigned long long childCount,
+    unsigned char* parents);
+
+/**
+  * Function to compute the root of a tree, level by level.
+  * @param  parameters      Pointer to the parameters of the tree.
+  * @param  leaves          Pointer to the first leaf.
+  * @param  leafByteLen     The length of each leaf in bytes.
+  * @param  leafCount       The number of leaves.
+  * @param  workspace       Pointer to a buffer of @a leafCount *
+  *                         KeccakMerkleTree_nodeSize bytes, used to store
+  *                         the levels.
+  * @param  root            Pointer to the buffer where to store the root.
+  * @pre    @a leafCount > 0
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakMerkleTree_ComputeRoot(
+    const KeccakMerkleTree_Parameters* parameters,
+    const unsigned char* leaves,
+    unsigned int leafByteLen,
+    unsigned long long leafCount,
+    unsigned char* workspace,
+    unsigned char* root);
+
+/**
+  * Function to start building a tree incrementally, without any leaf.
+  * @param  instance        Pointer to the instance to be initialized.
+  * @param  parameters      Pointer to the parameters of the tree.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakMerkleTree_Initialize(
+    KeccakMerkleTree_Instance* instance,
+    const KeccakMerkleTree_Parameters* parameters);
+
+/**
+  * Function to append a leaf to the tree. It hashes the leaf and the nodes
+  * completed by it, i.e., O(log n) nodes at most.
+  * @param  instance        Pointer to the instance.
+  * @param  leaf            Pointer to the leaf.
+  * @param  leafByteLen     The length of the leaf in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakMerkleTree_Append(KeccakMerkleTree_Instance* instance,
+                                   const unsigned char* leaf,
+                                   unsigned long long leafByteLen);
+
+/**
+  * Function to compute the root of the tree made of the leaves appended so
+  * far, which is the same as with KeccakMerkleTree_ComputeRoot(). It hashes
+  * the O(log n) incomplete nodes on the right edge of the tree, and leaves
+  * the instance unchanged, so that more leaves can be appended.
+  * @param  instance        Pointer to the instance.
+  * @param  root            Pointer to the buffer where to store the root.
+  * @pre    At least one leaf was appended.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakMerkleTree_Root(const KeccakMerkleTree_Instance* instance,
+                                 unsigned char* root);
+
+#endif
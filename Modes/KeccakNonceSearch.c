@@ -0,0 +1,150 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakNonceSearch.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+static void KeccakNonceSearch_PermuteAll(void* states, unsigned int rounds) {
+  if (rounds == 12)
+    KeccakP1600times4_StatePermuteAll12rounds(states);
+  else if (rounds == 14)
+    KeccakP1600times4_StatePermuteAll14rounds(states);
+  else
+    KeccakF1600times4_StatePermuteAll(states);
+}
+
+// Reads the given bytes as a big-endian integer.
+static uint64_t KeccakNonceSearch_LoadBigEndian(const unsigned char* bytes,
+                                                unsigned int byteLen) {
+  uint64_t value = 0;
+  unsigned int i;
+
+  for (i = 0; i < byteLen; i++)
+    value = (value << 8) | bytes[i];
+  return value;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakNonceSearch_Initialize(KeccakNonceSearch_Instance* instance,
+                                        const Keccak_HashInstance* prefixed,
+                                        unsigned int nonceByteLen,
+                                        const unsigned char* target,
+                                        unsigned int targetByteLen) {
+  const Keccak_SpongeInstance* sponge = &prefixed->sponge;
+  const unsigned int rateInBytes = sponge->rate / 8;
+  const unsigned int offset = sponge->byteIOIndex;
+
+  if (sponge->squeezing) return FAIL;
+  if ((sponge->rounds != 12) && (sponge->rounds != 14) &&
+      (sponge->rounds != 24))
+    return FAIL;
+  if ((nonceByteLen < 1) || (nonceByteLen > 8)) return FAIL;
+  if ((targetByteLen < 1) ||
+      (targetByteLen > KeccakNonceSearch_maxTargetByteLen) ||
+      (targetByteLen > rateInBytes))
+    return FAIL;
+  // A fixed-length hash would only give the first bytes of the digest
+  if ((prefixed->fixedOutputLength != 0) &&
+      (targetByteLen > prefixed->fixedOutputLength / 8))
+    return FAIL;
+
+  // The sponge permutes a full block as soon as it is absorbed, so the nonce
+  // starts in a block that is not full. The nonce and the delimited suffix
+  // must fit in that block, and the suffix must not need a block of its own
+  // for the second bit of padding
+  if (offset + nonceByteLen >= rateInBytes) return FAIL;
+  if ((prefixed->delimitedSuffix >= 0x80) &&
+      (offset + nonceByteLen == rateInBytes - 1))
+    return FAIL;
+
+  KeccakF1600_StateExtractLanes(
+      sponge->state, instance->midstate, KeccakF_width / 64);
+  instance->midstate[offset + nonceByteLen] ^= prefixed->delimitedSuffix;
+  instance->midstate[rateInBytes - 1] ^= 0x80;
+  memcpy(instance->target, target, targetByteLen);
+  instance->targetByteLen = targetByteLen;
+  instance->nonceOffset = offset;
+  instance->nonceByteLen = nonceByteLen;
+  instance->rounds = sponge->rounds;
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakNonceSearch_Search(const KeccakNonceSearch_Instance* instance,
+                                    uint64_t firstNonce,
+                                    uint64_t nonceCount,
+                                    uint64_t* found,
+                                    unsigned int maxFoundCount,
+                                    unsigned int* foundCount) {
+  ALIGN unsigned char midstates[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char firstLanes[KeccakF1600times4_parallelism * 8];
+  unsigned char digest[KeccakNonceSearch_maxTargetByteLen];
+  unsigned char nonce[8];
+  const unsigned int laneByteLen =
+      (instance->targetByteLen < 8) ? instance->targetByteLen : 8;
+  const uint64_t targetLane =
+      KeccakNonceSearch_LoadBigEndian(instance->target, laneByteLen);
+  unsigned int i, j;
+
+  *foundCount = 0;
+  if (maxFoundCount == 0) return SUCCESS;
+
+  // The midstate is loaded once in the four states
+  KeccakF1600times4_StateInitializeAll(midstates);
+  KeccakF1600times4_StateXORLanesAll(
+      midstates, instance->midstate, KeccakF_width / 64, 0);
+
+  while (nonceCount > 0) {
+    unsigned int candidateCount = (nonceCount < KeccakF1600times4_parallelism)
+                                      ? (unsigned int)nonceCount
+                                      : KeccakF1600times4_parallelism;
+    memcpy(states, midstates, sizeof(states));
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      uint64_t value = firstNonce + i;
+      for (j = 0; j < instance->nonceByteLen; j++) {
+        nonce[j] = (unsigned char)value;
+        value >>= 8;
+      }
+      KeccakF1600times4_StateXORBytes(
+          states, i, nonce, instance->nonceOffset, instance->nonceByteLen);
+    }
+    KeccakNonceSearch_PermuteAll(states, instance->rounds);
+    KeccakF1600times4_StateExtractLanesAll(states, firstLanes, 1, 8);
+
+    for (i = 0; i < candidateCount; i++) {
+      uint64_t lane =
+          KeccakNonceSearch_LoadBigEndian(firstLanes + 8 * i, laneByteLen);
+      if (lane > targetLane) continue;
+      // The rest of the digest only matters if the first lanes are equal
+      if ((lane == targetLane) && (instance->targetByteLen > 8)) {
+        KeccakF1600times4_StateExtractBytes(
+            states, i, digest, 0, instance->targetByteLen);
+        if (memcmp(digest, instance->target, instance->targetByteLen) > 0)
+          continue;
+      }
+      found[(*foundCount)++] = firstNonce + i;
+      if (*foundCount == maxFoundCount) return SUCCESS;
+    }
+    firstNonce += candidateCount;
+    nonceCount -= candidateCount;
+  }
+  return SUCCESS;
+}
@@ -0,0 +1,98 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#ifndef _KeccakNonceSearch_h_
+#define _KeccakNonceSearch_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * Search for nonces such that hashing a fixed prefix followed by the nonce
+  * gives a digest that meets a target, as in proofs of work.
+  * The prefix is absorbed once, and the state after it, called the
+  * midstate, is stored with the padding of the last block already in place,
+  * so that each candidate only costs the XOR of its nonce and one
+  * permutation. The candidates are hashed four at a time with
+  * KeccakF1600times4_*. A digest meets the target if its first bytes, read
+  * as a big-endian integer, are less than or equal to the target; only the
+  * first lane of each digest is compared, unless it equals the target.
+  */
+
+/** The maximum length in bytes of a target. */
+#define KeccakNonceSearch_maxTargetByteLen 64
+
+/**
+  * Structure that contains a nonce search set up for a prefix and a target.
+  */
+typedef struct {
+  /** The midstate as bytes, with the padding after the nonce. */
+  ALIGN unsigned char midstate[KeccakF_width / 8];
+  /** The target. */
+  unsigned char target[KeccakNonceSearch_maxTargetByteLen];
+  /** The length of the target in bytes. */
+  unsigned int targetByteLen;
+  /** The offset of the nonce in the last block. */
+  unsigned int nonceOffset;
+  /** The length of the nonce in bytes. */
+  unsigned int nonceByteLen;
+  /** The number of rounds of the permutation. */
+  unsigned int rounds;
+} KeccakNonceSearch_Instance;
+
+/**
+  * Function to set up a search.
+  * @param  instance        Pointer to the instance to be initialized.
+  * @param  prefixed        Pointer to a hash instance to which the prefix
+  *                         was given, in whole bytes, and which is not
+  *                         finalized yet. It is not modified.
+  * @param  nonceByteLen    The length of the nonce in bytes, from 1 to 8.
+  *                         The nonce is encoded in little-endian order.
+  * @param  target          Pointer to the target.
+  * @param  targetByteLen   The length of the target in bytes.
+  * @pre    The nonce and the first byte of the padding fit in the block
+  *         that contains the end of the prefix.
+  * @pre    1 ≤ @a targetByteLen ≤ KeccakNonceSearch_maxTargetByteLen, and
+  *         at most the rate in bytes and, for a fixed-length hash function,
+  *         its output length in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakNonceSearch_Initialize(KeccakNonceSearch_Instance* instance,
+                                        const Keccak_HashInstance* prefixed,
+                                        unsigned int nonceByteLen,
+                                        const unsigned char* target,
+                                        unsigned int targetByteLen);
+
+/**
+  * Function to look for the nonces in a range whose digest meets the
+  * target, in increasing order, until the range is exhausted or
+  * @a maxFoundCount nonces are found.
+  * @param  instance        Pointer to the instance.
+  * @param  firstNonce      The first nonce of the range.
+  * @param  nonceCount      The number of nonces in the range.
+  * @param  found           Pointer to the buffer where to store the nonces
+  *                         found.
+  * @param  maxFoundCount   The maximum number of nonces to find.
+  * @param  foundCount      Pointer to where to store the number of nonces
+  *                         found.
+  * @pre    The nonces of the range fit in the length of the nonce.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakNonceSearch_Search(const KeccakNonceSearch_Instance* instance,
+                                    uint64_t firstNonce,
+                                    uint64_t nonceCount,
+                                    uint64_t* found,
+                                    unsigned int maxFoundCount,
+                                    unsigned int* foundCount);
+
+#endif
@@ -0,0 +1,120 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KeccakPRG.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// Makes a duplexing call with σ given as whole bytes, the output being
+// available in the state afterwards. The buffers may be empty but must not
+// be null.
+static void KeccakPRG_Duplexing(KeccakPRG_Instance* instance,
+                                const unsigned char* sigma,
+                                unsigned int sigmaByteLen,
+                                unsigned char* Z,
+                                unsigned int ZByteLen) {
+  Keccak_Duplexing(&instance->duplex, sigma, sigmaByteLen, Z, ZByteLen, 0x01);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakPRG_Initialize(KeccakPRG_Instance* instance,
+                                unsigned int capacity) {
+  unsigned int rate;
+
+  if ((capacity % 8) != 0) return FAIL;
+  if (capacity > 1600 - 16) return FAIL;
+  rate = 1600 - capacity;
+  if (Keccak_DuplexInitialize(&instance->duplex, rate, capacity) != 0)
+    return FAIL;
+  instance->blockSize = (rate - 2) / 8;
+  // There is no output before the first duplexing call
+  instance->duplex.byteOutputIndex = instance->blockSize;
+  return SUCCESS;
+}
+
+HashReturn KeccakPRG_Feed(KeccakPRG_Instance* instance,
+                          const unsigned char* seed,
+                          unsigned long long seedByteLen) {
+  unsigned char none[1] = {0};
+
+  while (seedByteLen > 0) {
+    unsigned int length =
+        instance->blockSize - instance->duplex.byteInputIndex;
+    if (length > seedByteLen) length = (unsigned int)seedByteLen;
+    if (length == instance->blockSize)
+      // A whole block goes directly with the duplexing call
+      KeccakPRG_Duplexing(instance, seed, length, none, 0);
+    else {
+      Keccak_DuplexingFeedPartialInput(&instance->duplex, seed, length);
+      if (instance->duplex.byteInputIndex == instance->blockSize)
+        KeccakPRG_Duplexing(instance, none, 0, none, 0);
+    }
+    seed += length;
+    seedByteLen -= length;
+  }
+  return SUCCESS;
+}
+
+HashReturn KeccakPRG_Fetch(KeccakPRG_Instance* instance,
+                           unsigned char* output,
+                           unsigned long long outputByteLen) {
+  unsigned char none[1] = {0};
+
+  // The seed material given since the last block must be absorbed first
+  if (instance->duplex.byteInputIndex > 0)
+    KeccakPRG_Duplexing(instance, none, 0, none, 0);
+  while (outputByteLen > 0) {
+    unsigned int length;
+    if (instance->duplex.byteOutputIndex == instance->blockSize) {
+      if (outputByteLen >= instance->blockSize) {
+        // Whole blocks go directly from the duplexing call to the output
+        KeccakPRG_Duplexing(instance, none, 0, output, instance->blockSize);
+        output += instance->blockSize;
+        outputByteLen -= instance->blockSize;
+        continue;
+      }
+      KeccakPRG_Duplexing(instance, none, 0, none, 0);
+    }
+    length = instance->blockSize - instance->duplex.byteOutputIndex;
+    if (length > outputByteLen) length = (unsigned int)outputByteLen;
+    Keccak_DuplexingGetFurtherOutput(&instance->duplex, output, length);
+    output += length;
+    outputByteLen -= length;
+  }
+  return SUCCESS;
+}
+
+HashReturn KeccakPRG_Forget(KeccakPRG_Instance* instance) {
+  unsigned char zeroes[KeccakF_width / 8];
+  unsigned int capacityByteLen = (1600 - instance->duplex.rate) / 8;
+  unsigned int laneCount = capacityByteLen / KeccakF_laneInBytes;
+
+  if (instance->blockSize * 8 < 1600 - instance->duplex.rate) return FAIL;
+  memset(zeroes, 0, sizeof(zeroes));
+  // A first call absorbs any pending seed material, then c bits of the
+  // outer part are erased before a second call
+  KeccakPRG_Duplexing(instance, zeroes, 0, zeroes, 0);
+  KeccakF1600_StateOverwriteLanes(instance->duplex.state, zeroes, laneCount);
+  if ((capacityByteLen % KeccakF_laneInBytes) > 0)
+    KeccakF1600_StateOverwriteBytesInLane(
+        instance->duplex.state,
+        laneCount,
+        zeroes,
+        0,
+        capacityByteLen % KeccakF_laneInBytes);
+  KeccakPRG_Duplexing(instance, zeroes, 0, zeroes, 0);
+  return SUCCESS;
+}
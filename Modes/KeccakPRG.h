@@ -0,0 +1,94 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KeccakPRG_h_
+#define _KeccakPRG_h_
+
+#include "Constructions/KeccakDuplex.h"
+#include "Modes/KeccakHash.h"
+
+/**
+  * KeccakPRG is a reseedable pseudo-random generator on top of the duplex
+  * construction Duplex[Keccak-f[r+c], pad10*1, r], following the SpongePRG
+  * construction. Seed material is absorbed in blocks of ρ bytes, with ρ the
+  * largest whole number of bytes such that a block and its padding fit in
+  * one duplexing call, and the output is taken from the state ρ bytes at a
+  * time, so that requests of any size are served without any duplexing
+  * call until a block is exhausted. Requests of whole blocks are squeezed
+  * directly into the caller's buffer.
+  * Seeding and reseeding can happen at any time. After
+  * KeccakPRG_Forget(), the state cannot be used to recover the previous
+  * outputs.
+  * An instance does not share any data with other instances, so that each
+  * thread can have its own without locking. (The reference implementations
+  * fill global tables in KeccakF1600_Initialize(), so there the first
+  * instance must be initialized before the other threads start.)
+  */
+
+/**
+  * Structure that contains a KeccakPRG instance.
+  */
+typedef struct {
+  /** The underlying duplex object, whose indexes give the seed bytes
+    * pending and the output bytes already used in the current block. */
+  Keccak_DuplexInstance duplex;
+  /** The block size ρ in bytes. */
+  unsigned int blockSize;
+} KeccakPRG_Instance;
+
+/**
+  * Function to initialize a KeccakPRG instance, without any seed.
+  * @param  instance        Pointer to the instance to be initialized.
+  * @param  capacity        The value of the capacity c, which determines the
+  *                         security level. The rate is r=1600-c.
+  * @pre    c is a multiple of 8 and r-2 ≥ 8.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakPRG_Initialize(KeccakPRG_Instance* instance,
+                                unsigned int capacity);
+
+/**
+  * Function to give seed material to the generator. It can be called at any
+  * time, including between two requests for output, to reseed it.
+  * @param  instance        Pointer to the instance.
+  * @param  seed            Pointer to the seed material.
+  * @param  seedByteLen     The length of the seed material in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakPRG_Feed(KeccakPRG_Instance* instance,
+                          const unsigned char* seed,
+                          unsigned long long seedByteLen);
+
+/**
+  * Function to get pseudo-random bytes, depending on all the seed material
+  * given so far.
+  * @param  instance        Pointer to the instance.
+  * @param  output          Pointer to the buffer where to store the bytes.
+  * @param  outputByteLen   The number of bytes desired.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakPRG_Fetch(KeccakPRG_Instance* instance,
+                           unsigned char* output,
+                           unsigned long long outputByteLen);
+
+/**
+  * Function to make the state irreversible, so that an attacker who learns
+  * it afterwards cannot recover the previous outputs. The c bits that could
+  * lead back to the previous state are overwritten with zeroes.
+  * @param  instance        Pointer to the instance.
+  * @pre    ρ*8 ≥ c, i.e., c ≤ 792.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakPRG_Forget(KeccakPRG_Instance* instance);
+
+#endif
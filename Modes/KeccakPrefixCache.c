@@ -0,0 +1,93 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KeccakPrefixCache.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// FNV-1a, only used to skip entries quickly before comparing the prefixes.
+static unsigned long long Keccak_PrefixCacheFingerprint(
+    const unsigned char* prefix,
+    unsigned int prefixByteLen) {
+  unsigned long long fingerprint = 0xCBF29CE484222325ULL;
+  unsigned int i;
+
+  for (i = 0; i < prefixByteLen; i++) {
+    fingerprint ^= prefix[i];
+    fingerprint *= 0x100000001B3ULL;
+  }
+  return fingerprint;
+}
+
+// Whether the entry was made with the same hash function as the instance.
+static int Keccak_PrefixCacheSameFunction(const Keccak_HashInstance* a,
+                                          const Keccak_HashInstance* b) {
+  return (a->sponge.rate == b->sponge.rate) &&
+         (a->sponge.rounds == b->sponge.rounds) &&
+         (a->fixedOutputLength == b->fixedOutputLength) &&
+         (a->delimitedSuffix == b->delimitedSuffix);
+}
+
+/* ---------------------------------------------------------------- */
+
+void Keccak_PrefixCacheInitialize(Keccak_PrefixCache* cache) {
+  memset(cache, 0, sizeof(Keccak_PrefixCache));
+}
+
+void Keccak_PrefixCacheClear(Keccak_PrefixCache* cache) {
+  memset(cache->entries, 0, sizeof(cache->entries));
+}
+
+HashReturn Keccak_PrefixCacheAbsorb(Keccak_PrefixCache* cache,
+                                    Keccak_HashInstance* hashInstance,
+                                    const BitSequence* prefix,
+                                    unsigned int prefixByteLen) {
+  Keccak_PrefixCacheEntry* victim;
+  unsigned long long fingerprint;
+  unsigned int i;
+
+  if (prefixByteLen > Keccak_PrefixCache_maxPrefixByteLen) {
+    cache->misses++;
+    return Keccak_HashUpdate(
+        hashInstance, prefix, (DataLength)prefixByteLen * 8);
+  }
+  fingerprint = Keccak_PrefixCacheFingerprint(prefix, prefixByteLen);
+  cache->clock++;
+  victim = &cache->entries[0];
+  for (i = 0; i < Keccak_PrefixCache_entryCount; i++) {
+    Keccak_PrefixCacheEntry* entry = &cache->entries[i];
+    if ((entry->lastUse != 0) && (entry->fingerprint == fingerprint) &&
+        (entry->prefixByteLen == prefixByteLen) &&
+        Keccak_PrefixCacheSameFunction(&entry->state, hashInstance) &&
+        (memcmp(entry->prefix, prefix, prefixByteLen) == 0)) {
+      *hashInstance = entry->state;
+      entry->lastUse = cache->clock;
+      cache->hits++;
+      return SUCCESS;
+    }
+    if (entry->lastUse < victim->lastUse) victim = entry;
+  }
+
+  cache->misses++;
+  if (Keccak_HashUpdate(hashInstance, prefix, (DataLength)prefixByteLen * 8) !=
+      SUCCESS)
+    return FAIL;
+  victim->state = *hashInstance;
+  memcpy(victim->prefix, prefix, prefixByteLen);
+  victim->prefixByteLen = prefixByteLen;
+  victim->fingerprint = fingerprint;
+  victim->lastUse = cache->clock;
+  return SUCCESS;
+}
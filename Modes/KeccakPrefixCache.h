@@ -0,0 +1,99 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KeccakPrefixCache_h_
+#define _KeccakPrefixCache_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * A prefix cache keeps the states of hash instances after they absorbed
+  * common prefixes, e.g., a domain separation string or a key block, so
+  * that a hash starting with a prefix seen recently starts from a copy of
+  * the state instead of absorbing the prefix again. Like any other hash
+  * instance, a state can be forked into many continuations by copying the
+  * structure.
+  * Prefixes are looked up with a non-cryptographic fingerprint and then
+  * compared byte by byte, so a lookup costs no permutation. The least
+  * recently used entry is replaced when the cache is full.
+  * Entries hold the prefixes and the states after them, so a cache holding
+  * secret prefixes should be cleared with Keccak_PrefixCacheClear() after
+  * use.
+  */
+
+/** The number of prefixes kept in a cache. */
+#define Keccak_PrefixCache_entryCount 8
+/** The maximum length in bytes of a prefix that can be cached. Longer
+  * prefixes are simply absorbed. */
+#define Keccak_PrefixCache_maxPrefixByteLen 512
+
+typedef struct {
+  /** The state after the prefix. */
+  Keccak_HashInstance state;
+  /** The prefix itself. */
+  unsigned char prefix[Keccak_PrefixCache_maxPrefixByteLen];
+  /** The length of the prefix in bytes. */
+  unsigned int prefixByteLen;
+  /** The fingerprint of the prefix. */
+  unsigned long long fingerprint;
+  /** The time of last use, or 0 if the entry is free. */
+  unsigned long long lastUse;
+} Keccak_PrefixCacheEntry;
+
+/**
+  * Structure that contains a prefix cache. A cache is not meant to be
+  * shared between threads without locking.
+  */
+typedef struct {
+  Keccak_PrefixCacheEntry entries[Keccak_PrefixCache_entryCount];
+  /** A counter incremented by each lookup, to order the entries. */
+  unsigned long long clock;
+  /** The number of lookups that found the prefix in the cache. */
+  unsigned long long hits;
+  /** The number of lookups that had to absorb the prefix. */
+  unsigned long long misses;
+} Keccak_PrefixCache;
+
+/**
+  * Function to initialize an empty prefix cache.
+  * @param  cache           Pointer to the cache to be initialized.
+  */
+void Keccak_PrefixCacheInitialize(Keccak_PrefixCache* cache);
+
+/**
+  * Function to erase all the entries of a prefix cache, leaving it empty.
+  * @param  cache           Pointer to the cache.
+  */
+void Keccak_PrefixCacheClear(Keccak_PrefixCache* cache);
+
+/**
+  * Function to absorb a prefix into a hash instance that was just
+  * initialized, using the cache. On return, the instance is in the same
+  * state as after Keccak_HashUpdate() with the prefix, and more input can
+  * follow.
+  * Entries only match instances with the same parameters, so one cache can
+  * serve several hash functions.
+  * @param  cache           Pointer to the cache.
+  * @param  hashInstance    Pointer to the hash instance, initialized by
+  *                         Keccak_HashInitialize() or one of its variants
+  *                         and not given any input yet.
+  * @param  prefix          Pointer to the prefix.
+  * @param  prefixByteLen   The length of the prefix in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Keccak_PrefixCacheAbsorb(Keccak_PrefixCache* cache,
+                                    Keccak_HashInstance* hashInstance,
+                                    const BitSequence* prefix,
+                                    unsigned int prefixByteLen);
+
+#endif
@@ -0,0 +1,166 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakSampling.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#define KeccakSampling_rateInBytesSHAKE128 168
+#define KeccakSampling_rateInBytesSHAKE256 136
+#define KeccakSampling_suffixSHAKE 0x1F
+
+/* ---------------------------------------------------------------- */
+
+// Absorbs the four seeds, each with its padding, in the four states.
+static void KeccakSampling_AbsorbTimes4(void* states,
+                                        const unsigned char* seeds[4],
+                                        unsigned int seedByteLen,
+                                        unsigned int rateInBytes) {
+  const unsigned char suffix = KeccakSampling_suffixSHAKE;
+  const unsigned char lastByte = 0x80;
+  unsigned int i;
+
+  KeccakF1600times4_StateInitializeAll(states);
+  for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+    KeccakF1600times4_StateXORBytes(states, i, seeds[i], 0, seedByteLen);
+    KeccakF1600times4_StateXORBytes(states, i, &suffix, seedByteLen, 1);
+    KeccakF1600times4_StateXORBytes(states, i, &lastByte, rateInBytes - 1, 1);
+  }
+}
+
+// Appends to the coefficients the candidates taken from the given bytes that
+// are less than q, until there are KeccakSampling_coefficientCount of them,
+// and returns the new number of coefficients. Each candidate is stored
+// unconditionally and kept by advancing the count, so that there is no
+// branch on its value.
+static unsigned int KeccakSampling_RejectUniform(int32_t* coefficients,
+                                                 unsigned int count,
+                                                 const unsigned char* bytes,
+                                                 unsigned int byteLen,
+                                                 uint32_t q) {
+  const unsigned int n = KeccakSampling_coefficientCount;
+  unsigned int j;
+
+  if (q <= 4096) {
+    for (j = 0; (j + 3 <= byteLen) && (count < n); j += 3) {
+      uint32_t d1 = bytes[j] | ((uint32_t)(bytes[j + 1] & 0x0F) << 8);
+      uint32_t d2 = (bytes[j + 1] >> 4) | ((uint32_t)bytes[j + 2] << 4);
+      coefficients[count] = (int32_t)d1;
+      count += (d1 < q);
+      if (count < n) {
+        coefficients[count] = (int32_t)d2;
+        count += (d2 < q);
+      }
+    }
+  } else {
+    for (j = 0; (j + 3 <= byteLen) && (count < n); j += 3) {
+      uint32_t t = bytes[j] | ((uint32_t)bytes[j + 1] << 8) |
+                   ((uint32_t)(bytes[j + 2] & 0x7F) << 16);
+      coefficients[count] = (int32_t)t;
+      count += (t < q);
+    }
+  }
+  return count;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakSampling_UniformTimes4(int32_t* coefficients[4],
+                                        const unsigned char* seeds[4],
+                                        unsigned int seedByteLen,
+                                        uint32_t q) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char blocks[KeccakF1600times4_parallelism *
+                             KeccakSampling_rateInBytesSHAKE128];
+  const unsigned int rateInBytes = KeccakSampling_rateInBytesSHAKE128;
+  unsigned int counts[KeccakF1600times4_parallelism] = {0, 0, 0, 0};
+  unsigned int i, completed = 0;
+
+  if (seedByteLen > KeccakSampling_maxSeedByteLen) return FAIL;
+  if ((q < 2) || (q > ((uint32_t)1 << 23))) return FAIL;
+
+  KeccakSampling_AbsorbTimes4(states, seeds, seedByteLen, rateInBytes);
+  // The four streams are squeezed in lockstep until all polynomials are
+  // complete
+  while (completed < KeccakF1600times4_parallelism) {
+    KeccakF1600times4_StatePermuteAll(states);
+    KeccakF1600times4_StateExtractLanesAll(
+        states, blocks, rateInBytes / 8, rateInBytes);
+    completed = 0;
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      counts[i] = KeccakSampling_RejectUniform(coefficients[i],
+                                               counts[i],
+                                               blocks + i * rateInBytes,
+                                               rateInBytes,
+                                               q);
+      if (counts[i] == KeccakSampling_coefficientCount) completed++;
+    }
+  }
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakSampling_CenteredBinomialTimes4(int32_t* coefficients[4],
+                                                 const unsigned char* seeds[4],
+                                                 unsigned int seedByteLen,
+                                                 unsigned int eta) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char blocks[KeccakF1600times4_parallelism * 2 *
+                             KeccakSampling_rateInBytesSHAKE256];
+  const unsigned int rateInBytes = KeccakSampling_rateInBytesSHAKE256;
+  const unsigned int stride = 2 * rateInBytes;
+  unsigned int i, j, k;
+
+  if (seedByteLen > KeccakSampling_maxSeedByteLen) return FAIL;
+  if ((eta != 2) && (eta != 3)) return FAIL;
+
+  // 64η bytes per stream: one block for η = 2, two blocks for η = 3
+  KeccakSampling_AbsorbTimes4(states, seeds, seedByteLen, rateInBytes);
+  KeccakF1600times4_StatePermuteAll(states);
+  KeccakF1600times4_StateExtractLanesAll(
+      states, blocks, rateInBytes / 8, stride);
+  if (eta == 3) {
+    KeccakF1600times4_StatePermuteAll(states);
+    KeccakF1600times4_StateExtractLanesAll(
+        states, blocks + rateInBytes, rateInBytes / 8, stride);
+  }
+
+  // The bits of each group are added in parallel within a word
+  for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+    const unsigned char* bytes = blocks + i * stride;
+    int32_t* r = coefficients[i];
+    if (eta == 2) {
+      for (j = 0; j < KeccakSampling_coefficientCount / 8; j++) {
+        uint32_t t = bytes[4 * j] | ((uint32_t)bytes[4 * j + 1] << 8) |
+                     ((uint32_t)bytes[4 * j + 2] << 16) |
+                     ((uint32_t)bytes[4 * j + 3] << 24);
+        uint32_t d = (t & 0x55555555) + ((t >> 1) & 0x55555555);
+        for (k = 0; k < 8; k++)
+          r[8 * j + k] = (int32_t)((d >> (4 * k)) & 0x3) -
+                         (int32_t)((d >> (4 * k + 2)) & 0x3);
+      }
+    } else {
+      for (j = 0; j < KeccakSampling_coefficientCount / 4; j++) {
+        uint32_t t = bytes[3 * j] | ((uint32_t)bytes[3 * j + 1] << 8) |
+                     ((uint32_t)bytes[3 * j + 2] << 16);
+        uint32_t d = (t & 0x00249249) + ((t >> 1) & 0x00249249) +
+                     ((t >> 2) & 0x00249249);
+        for (k = 0; k < 4; k++)
+          r[4 * j + k] = (int32_t)((d >> (6 * k)) & 0x7) -
+                         (int32_t)((d >> (6 * k + 3)) & 0x7);
+      }
+    }
+  }
+  return SUCCESS;
+}
@@ -0,0 +1,77 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#ifndef _KeccakSampling_h_
+#define _KeccakSampling_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * Sampling of polynomial coefficients from SHAKE, as done by lattice-based
+  * schemes such as ML-KEM and ML-DSA. Polynomials are sampled four at a
+  * time, each from its own seed, with the four XOF streams running in
+  * lockstep on KeccakF1600times4_*.
+  * - The uniform sampling mod q, used for the expansion of the public
+  *   matrix, squeezes SHAKE128(seed) and rejects the candidates that are not
+  *   less than q. If q ≤ 4096, each 3 bytes give two 12-bit candidates, as
+  *   in ML-KEM; otherwise, each 3 bytes give one 23-bit candidate, as in
+  *   ML-DSA.
+  * - The centered binomial sampling takes 64η bytes of SHAKE256(seed) and
+  *   makes each coefficient the difference of the Hamming weights of two
+  *   consecutive groups of η bits, as in ML-KEM.
+  */
+
+/** The number of coefficients of a polynomial. */
+#define KeccakSampling_coefficientCount 256
+/** The maximum length in bytes of a seed, so that it fits in one block of
+  * SHAKE256 with its padding. */
+#define KeccakSampling_maxSeedByteLen 135
+
+/**
+  * Function to sample four polynomials with coefficients uniformly
+  * distributed mod @a q.
+  * @param  coefficients    The four arrays of KeccakSampling_coefficientCount
+  *                         coefficients where to store the polynomials.
+  * @param  seeds           The four seeds, e.g., ρ followed by the indexes
+  *                         of the matrix entry.
+  * @param  seedByteLen     The length in bytes of each seed.
+  * @param  q               The modulus.
+  * @pre    @a seedByteLen ≤ KeccakSampling_maxSeedByteLen
+  * @pre    2 ≤ @a q ≤ 2^23
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakSampling_UniformTimes4(int32_t* coefficients[4],
+                                        const unsigned char* seeds[4],
+                                        unsigned int seedByteLen,
+                                        uint32_t q);
+
+/**
+  * Function to sample four polynomials with coefficients following the
+  * centered binomial distribution with parameter @a eta.
+  * @param  coefficients    The four arrays of KeccakSampling_coefficientCount
+  *                         coefficients where to store the polynomials, in
+  *                         [-@a eta, @a eta].
+  * @param  seeds           The four seeds, e.g., σ followed by a counter.
+  * @param  seedByteLen     The length in bytes of each seed.
+  * @param  eta             The parameter η of the distribution.
+  * @pre    @a seedByteLen ≤ KeccakSampling_maxSeedByteLen
+  * @pre    @a eta is 2 or 3.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakSampling_CenteredBinomialTimes4(int32_t* coefficients[4],
+                                                 const unsigned char* seeds[4],
+                                                 unsigned int seedByteLen,
+                                                 unsigned int eta);
+
+#endif
@@ -0,0 +1,113 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakSketch.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#define KeccakSketch_rateInBytes 168
+#define KeccakSketch_suffixSHAKE 0x1F
+
+/* ---------------------------------------------------------------- */
+
+// Maps the words of the output to their ranges. The loop has no branch, so
+// that the compiler can vectorize it.
+static void KeccakSketch_MapToRanges(const unsigned char* output,
+                                     const uint32_t* ranges,
+                                     unsigned int indexCount,
+                                     uint32_t* indexes) {
+  unsigned int i;
+
+  for (i = 0; i < indexCount; i++) {
+    uint32_t word = (uint32_t)output[4 * i] |
+                    ((uint32_t)output[4 * i + 1] << 8) |
+                    ((uint32_t)output[4 * i + 2] << 16) |
+                    ((uint32_t)output[4 * i + 3] << 24);
+    indexes[i] = (uint32_t)(((uint64_t)word * ranges[i]) >> 32);
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KeccakSketch_Indexes(const unsigned char* key,
+                                unsigned long long keyByteLen,
+                                const uint32_t* ranges,
+                                unsigned int indexCount,
+                                uint32_t* indexes) {
+  unsigned char output[KeccakSketch_maxIndexCount * 4];
+  Keccak_SpongeInstance sponge;
+
+  if (indexCount > KeccakSketch_maxIndexCount) return FAIL;
+  Keccak_SpongeInitialize(&sponge,
+                          KeccakSketch_rateInBytes * 8,
+                          1600 - KeccakSketch_rateInBytes * 8);
+  Keccak_SpongeAbsorb(&sponge, key, keyByteLen);
+  Keccak_SpongeAbsorbLastFewBits(&sponge, KeccakSketch_suffixSHAKE);
+  Keccak_SpongeSqueeze(&sponge, output, indexCount * 4);
+  KeccakSketch_MapToRanges(output, ranges, indexCount, indexes);
+  return SUCCESS;
+}
+
+HashReturn KeccakSketch_IndexesBatch(const unsigned char* const* keys,
+                                     const unsigned long long* keyByteLens,
+                                     unsigned int keyCount,
+                                     const uint32_t* ranges,
+                                     unsigned int indexCount,
+                                     uint32_t* indexes) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char outputs[KeccakF1600times4_parallelism *
+                              KeccakSketch_rateInBytes];
+  const unsigned char suffix = KeccakSketch_suffixSHAKE;
+  const unsigned char lastByte = 0x80;
+  unsigned int i;
+
+  if (indexCount > KeccakSketch_maxIndexCount) return FAIL;
+
+  while (keyCount > 0) {
+    // Four keys that each fit in one block with their padding, in parallel
+    if ((keyCount >= KeccakF1600times4_parallelism) &&
+        (keyByteLens[0] < KeccakSketch_rateInBytes) &&
+        (keyByteLens[1] < KeccakSketch_rateInBytes) &&
+        (keyByteLens[2] < KeccakSketch_rateInBytes) &&
+        (keyByteLens[3] < KeccakSketch_rateInBytes)) {
+      KeccakF1600times4_StateInitializeAll(states);
+      for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+        unsigned int keyByteLen = (unsigned int)keyByteLens[i];
+        KeccakF1600times4_StateXORBytes(states, i, keys[i], 0, keyByteLen);
+        KeccakF1600times4_StateXORBytes(states, i, &suffix, keyByteLen, 1);
+        KeccakF1600times4_StateXORBytes(
+            states, i, &lastByte, KeccakSketch_rateInBytes - 1, 1);
+      }
+      KeccakF1600times4_StatePermuteAll(states);
+      KeccakF1600times4_StateExtractLanesAll(
+          states, outputs, (indexCount * 4 + 7) / 8, KeccakSketch_rateInBytes);
+      for (i = 0; i < KeccakF1600times4_parallelism; i++)
+        KeccakSketch_MapToRanges(outputs + i * KeccakSketch_rateInBytes,
+                                 ranges,
+                                 indexCount,
+                                 indexes + i * indexCount);
+      keys += KeccakF1600times4_parallelism;
+      keyByteLens += KeccakF1600times4_parallelism;
+      indexes += KeccakF1600times4_parallelism * indexCount;
+      keyCount -= KeccakF1600times4_parallelism;
+    } else {
+      KeccakSketch_Indexes(
+          keys[0], keyByteLens[0], ranges, indexCount, indexes);
+      keys++;
+      keyByteLens++;
+      indexes += indexCount;
+      keyCount--;
+    }
+  }
+  return SUCCESS;
+}
@@ -0,0 +1,70 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#ifndef _KeccakSketch_h_
+#define _KeccakSketch_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * Derivation of the k bucket indexes of a key for Bloom filters and
+  * count-min sketches from a single SHAKE128 call.
+  * The indexes come from consecutive 32-bit little-endian words w_i of
+  * SHAKE128(key), each mapped to its own range [0, n_i) as
+  * ⌊w_i × n_i / 2^32⌋, so that they fit in the first block of output and
+  * cost one permutation per key (plus one per block of a key that does not
+  * fit in a single block).
+  * Batches of keys are processed four at a time with KeccakF1600times4_*.
+  */
+
+/** The maximum number of indexes per key, so that they fit in one block. */
+#define KeccakSketch_maxIndexCount 42
+
+/**
+  * Function to derive the indexes of a key.
+  * @param  key             Pointer to the key.
+  * @param  keyByteLen      The length of the key in bytes.
+  * @param  ranges          Pointer to the array of the sizes n_i of the
+  *                         ranges, one per index.
+  * @param  indexCount      The number of indexes k.
+  * @param  indexes         Pointer to the array where to store the indexes.
+  * @pre    @a indexCount ≤ KeccakSketch_maxIndexCount
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakSketch_Indexes(const unsigned char* key,
+                                unsigned long long keyByteLen,
+                                const uint32_t* ranges,
+                                unsigned int indexCount,
+                                uint32_t* indexes);
+
+/**
+  * Function to derive the indexes of several keys, with the same ranges.
+  * @param  keys            Pointer to the array of keys.
+  * @param  keyByteLens     Pointer to the array of their lengths in bytes.
+  * @param  keyCount        The number of keys.
+  * @param  ranges          Pointer to the array of the sizes of the ranges.
+  * @param  indexCount      The number of indexes per key.
+  * @param  indexes         Pointer to the array where to store the
+  *                         @a indexCount indexes of each key in turn.
+  * @pre    @a indexCount ≤ KeccakSketch_maxIndexCount
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KeccakSketch_IndexesBatch(const unsigned char* const* keys,
+                                     const unsigned long long* keyByteLens,
+                                     unsigned int keyCount,
+                                     const uint32_t* ranges,
+                                     unsigned int indexCount,
+                                     uint32_t* indexes);
+
+#endif
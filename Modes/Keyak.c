@@ -0,0 +1,353 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/Keyak.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// Layout of a piston: the first Rs bytes take the ciphertext, the first Ra
+// bytes take the associated data, and the four following bytes take the
+// frame bits.
+#define Keyak_Rs 168
+#define Keyak_Ra 192
+#define Keyak_offsetEOM (Keyak_Ra + 0)
+#define Keyak_offsetCryptEnd (Keyak_Ra + 1)
+#define Keyak_offsetInjectStart (Keyak_Ra + 2)
+#define Keyak_offsetInjectEnd (Keyak_Ra + 3)
+// The length of the tags that chain the pistons in a knot.
+#define Keyak_knotTagSize 32
+// The length of the SUV, before the nonce, that holds the key.
+#define Keyak_keyPackSize 40
+
+#define Keyak_stateSize (KeccakF_width / 8)
+
+// With 4 or 8 pistons, piston i is state i%4 of the group i/4 of times4
+// states; otherwise, it is a state of its own.
+static void Keyak_XORBytes(Keyak_Instance* keyak,
+                           unsigned int piston,
+                           const unsigned char* data,
+                           unsigned int offset,
+                           unsigned int length) {
+  unsigned char* state;
+  unsigned int lanePosition, offsetInLane, n;
+
+  if (keyak->pistonCount >= KeccakF1600times4_parallelism) {
+    KeccakF1600times4_StateXORBytes(
+        keyak->states + (piston / KeccakF1600times4_parallelism) *
+                            KeccakF1600times4_statesSizeInBytes,
+        piston % KeccakF1600times4_parallelism,
+        data,
+        offset,
+        length);
+    return;
+  }
+  state = keyak->states + piston * Keyak_stateSize;
+  while (length > 0) {
+    lanePosition = offset / 8;
+    offsetInLane = offset % 8;
+    n = 8 - offsetInLane;
+    if (n > length) n = length;
+    KeccakF1600_StateXORBytesInLane(
+        state, lanePosition, data, offsetInLane, n);
+    data += n;
+    offset += n;
+    length -= n;
+  }
+}
+
+static void Keyak_ExtractBytes(Keyak_Instance* keyak,
+                               unsigned int piston,
+                               unsigned char* data,
+                               unsigned int offset,
+                               unsigned int length) {
+  const unsigned char* state;
+  unsigned int lanePosition, offsetInLane, n;
+
+  if (keyak->pistonCount >= KeccakF1600times4_parallelism) {
+    KeccakF1600times4_StateExtractBytes(
+        keyak->states + (piston / KeccakF1600times4_parallelism) *
+                            KeccakF1600times4_statesSizeInBytes,
+        piston % KeccakF1600times4_parallelism,
+        data,
+        offset,
+        length);
+    return;
+  }
+  state = keyak->states + piston * Keyak_stateSize;
+  while (length > 0) {
+    lanePosition = offset / 8;
+    offsetInLane = offset % 8;
+    n = 8 - offsetInLane;
+    if (n > length) n = length;
+    KeccakF1600_StateExtractBytesInLane(
+        state, lanePosition, data, offsetInLane, n);
+    data += n;
+    offset += n;
+    length -= n;
+  }
+}
+
+static void Keyak_XORByte(Keyak_Instance* keyak,
+                          unsigned int piston,
+                          unsigned char value,
+                          unsigned int offset) {
+  Keyak_XORBytes(keyak, piston, &value, offset, 1);
+}
+
+/* ---------------------------------------------------------------- */
+
+// Encrypts (or decrypts) as much data as fits in the piston, from the offset
+// left by the last spark, and returns the number of bytes processed.
+static unsigned int Keyak_Crypt(Keyak_Instance* keyak,
+                                unsigned int piston,
+                                const unsigned char* input,
+                                unsigned char* output,
+                                unsigned long long dataByteLen,
+                                int unwrapFlag) {
+  unsigned char keystream[Keyak_Rs];
+  unsigned int offset = keyak->offsets[piston];
+  unsigned int n = Keyak_Rs - offset;
+  unsigned int i;
+
+  if (n > dataByteLen) n = (unsigned int)dataByteLen;
+  if (!unwrapFlag) {
+    // The state receives the ciphertext, which is read back as output
+    Keyak_XORBytes(keyak, piston, input, offset, n);
+    Keyak_ExtractBytes(keyak, piston, output, offset, n);
+  } else {
+    // XORing the plaintext into the state leaves the ciphertext there
+    Keyak_ExtractBytes(keyak, piston, keystream, offset, n);
+    for (i = 0; i < n; i++) output[i] = keystream[i] ^ input[i];
+    Keyak_XORBytes(keyak, piston, output, offset, n);
+  }
+  Keyak_XORByte(
+      keyak, piston, (unsigned char)(offset + n), Keyak_offsetCryptEnd);
+  return n;
+}
+
+// Injects as much data as fits in the piston, after the ciphertext if
+// crypting, and returns the number of bytes processed.
+static unsigned int Keyak_Inject(Keyak_Instance* keyak,
+                                 unsigned int piston,
+                                 const unsigned char* data,
+                                 unsigned long long dataByteLen,
+                                 int crypting) {
+  unsigned int offset = crypting ? Keyak_Rs : 0;
+  unsigned int n = Keyak_Ra - offset;
+
+  if (n > dataByteLen) n = (unsigned int)dataByteLen;
+  Keyak_XORByte(keyak, piston, (unsigned char)offset, Keyak_offsetInjectStart);
+  Keyak_XORBytes(keyak, piston, data, offset, n);
+  Keyak_XORByte(
+      keyak, piston, (unsigned char)(offset + n), Keyak_offsetInjectEnd);
+  return n;
+}
+
+// Permutes all pistons, after marking the end of a message with the length
+// of the tag each piston will give, if eom is set.
+static void Keyak_Spark(Keyak_Instance* keyak,
+                        int eom,
+                        const unsigned char* tagLengths) {
+  unsigned int i;
+
+  for (i = 0; i < keyak->pistonCount; i++) {
+    if (eom)
+      Keyak_XORByte(keyak,
+                    i,
+                    tagLengths[i] == 0 ? 0xFF : tagLengths[i],
+                    Keyak_offsetEOM);
+    keyak->offsets[i] = eom ? tagLengths[i] : 0;
+  }
+  if (keyak->pistonCount >= KeccakF1600times4_parallelism) {
+    for (i = 0; i < keyak->pistonCount; i += KeccakF1600times4_parallelism)
+      KeccakP1600times4_StatePermuteAll12rounds(
+          keyak->states + (i / KeccakF1600times4_parallelism) *
+                              KeccakF1600times4_statesSizeInBytes);
+  } else {
+    for (i = 0; i < keyak->pistonCount; i++)
+      KeccakP1600_StatePermute12rounds(keyak->states + i * Keyak_stateSize);
+  }
+}
+
+// Ends a message and returns the concatenation of the tags of the pistons.
+static unsigned int Keyak_Tags(Keyak_Instance* keyak,
+                               const unsigned char* tagLengths,
+                               unsigned char* tags) {
+  unsigned int i, length = 0;
+
+  Keyak_Spark(keyak, 1, tagLengths);
+  for (i = 0; i < keyak->pistonCount; i++) {
+    Keyak_ExtractBytes(keyak, i, tags + length, 0, tagLengths[i]);
+    length += tagLengths[i];
+  }
+  return length;
+}
+
+// Injects the same data into all pistons, diversified with the piston count
+// and index if requested.
+static void Keyak_Collective(Keyak_Instance* keyak,
+                             const unsigned char* data,
+                             unsigned int dataByteLen,
+                             int diversify) {
+  unsigned char buffer[Keyak_maxPistons * Keyak_knotTagSize + 2];
+  unsigned int i, n = 0, offset, length = dataByteLen;
+
+  memcpy(buffer, data, dataByteLen);
+  if (diversify) length += 2;
+  for (offset = 0; offset < length; offset += n) {
+    for (i = 0; i < keyak->pistonCount; i++) {
+      if (diversify) {
+        buffer[dataByteLen] = (unsigned char)keyak->pistonCount;
+        buffer[dataByteLen + 1] = (unsigned char)i;
+      }
+      n = Keyak_Inject(keyak, i, buffer + offset, length - offset, 0);
+    }
+    if (offset + n < length) Keyak_Spark(keyak, 0, NULL);
+  }
+  memset(keyak->offsets, 0, sizeof(keyak->offsets));
+}
+
+// Chains the pistons together by injecting all their tags into each.
+static void Keyak_Knot(Keyak_Instance* keyak) {
+  unsigned char tagLengths[Keyak_maxPistons];
+  unsigned char tags[Keyak_maxPistons * Keyak_knotTagSize];
+  unsigned int length;
+
+  memset(tagLengths, Keyak_knotTagSize, sizeof(tagLengths));
+  length = Keyak_Tags(keyak, tagLengths, tags);
+  Keyak_Collective(keyak, tags, length, 0);
+}
+
+// Produces the tag of a message, or checks it and fails if it differs.
+static HashReturn Keyak_HandleTag(Keyak_Instance* keyak,
+                                  int tagFlag,
+                                  unsigned char* tag,
+                                  int unwrapFlag) {
+  unsigned char tagLengths[Keyak_maxPistons];
+  unsigned char tagPrime[Keyak_tagSize];
+  unsigned char difference = 0;
+  unsigned int i;
+
+  memset(tagLengths, 0, sizeof(tagLengths));
+  if (tagFlag) tagLengths[0] = Keyak_tagSize;
+  Keyak_Tags(keyak, tagLengths, tagPrime);
+  if (!tagFlag) return SUCCESS;
+  if (!unwrapFlag) {
+    memcpy(tag, tagPrime, Keyak_tagSize);
+    return SUCCESS;
+  }
+
+  // Constant-time comparison
+  for (i = 0; i < Keyak_tagSize; i++) difference |= tagPrime[i] ^ tag[i];
+  if (difference != 0) {
+    keyak->failed = 1;
+    return FAIL;
+  }
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Keyak_Initialize(Keyak_Instance* keyak,
+                            unsigned int pistonCount,
+                            const unsigned char* key,
+                            unsigned int keyByteLen,
+                            const unsigned char* nonce,
+                            unsigned int nonceByteLen,
+                            int tagFlag,
+                            unsigned char* tag,
+                            int unwrapFlag,
+                            int forgetFlag) {
+  unsigned char SUV[Keyak_keyPackSize + Keyak_maxNonceByteLen];
+  unsigned int i;
+
+  if ((pistonCount != Keyak_pistonsLake) &&
+      (pistonCount != Keyak_pistonsSea) &&
+      (pistonCount != Keyak_pistonsOcean) &&
+      (pistonCount != Keyak_pistonsLunar))
+    return FAIL;
+  if (keyByteLen > Keyak_maxKeyByteLen) return FAIL;
+  if (nonceByteLen > Keyak_maxNonceByteLen) return FAIL;
+
+  KeccakF1600_Initialize();
+  keyak->pistonCount = pistonCount;
+  keyak->failed = 0;
+  if (pistonCount >= KeccakF1600times4_parallelism) {
+    for (i = 0; i < pistonCount; i += KeccakF1600times4_parallelism)
+      KeccakF1600times4_StateInitializeAll(
+          keyak->states + (i / KeccakF1600times4_parallelism) *
+                              KeccakF1600times4_statesSizeInBytes);
+  } else {
+    for (i = 0; i < pistonCount; i++)
+      KeccakF1600_StateInitialize(keyak->states + i * Keyak_stateSize);
+  }
+
+  // SUV = keypack(K, 40) || N, with keypack(K, l) = enc8(l) || K || 10*
+  memset(SUV, 0, Keyak_keyPackSize);
+  SUV[0] = Keyak_keyPackSize;
+  memcpy(SUV + 1, key, keyByteLen);
+  SUV[1 + keyByteLen] = 0x01;
+  memcpy(SUV + Keyak_keyPackSize, nonce, nonceByteLen);
+  Keyak_Collective(keyak, SUV, Keyak_keyPackSize + nonceByteLen, 1);
+  if (forgetFlag) Keyak_Knot(keyak);
+  if (Keyak_HandleTag(keyak, tagFlag, tag, unwrapFlag) != SUCCESS) {
+    return FAIL;
+  }
+  return SUCCESS;
+}
+
+HashReturn Keyak_Wrap(Keyak_Instance* keyak,
+                      const unsigned char* input,
+                      unsigned char* output,
+                      unsigned long long dataByteLen,
+                      const unsigned char* AD,
+                      unsigned long long ADByteLen,
+                      unsigned char* tag,
+                      int unwrapFlag,
+                      int forgetFlag) {
+  unsigned char* outputStart = output;
+  unsigned long long outputByteLen = dataByteLen;
+  unsigned int i, n;
+  int crypting;
+
+  if (keyak->failed) return FAIL;
+
+  while ((dataByteLen > 0) || (ADByteLen > 0)) {
+    // Each piston takes the next part of the data, then of the AD
+    crypting = (dataByteLen > 0);
+    if (crypting) {
+      for (i = 0; i < keyak->pistonCount; i++) {
+        n = Keyak_Crypt(keyak, i, input, output, dataByteLen, unwrapFlag);
+        input += n;
+        output += n;
+        dataByteLen -= n;
+      }
+    }
+    for (i = 0; i < keyak->pistonCount; i++) {
+      n = Keyak_Inject(keyak, i, AD, ADByteLen, crypting);
+      AD += n;
+      ADByteLen -= n;
+    }
+    if ((dataByteLen > 0) || (ADByteLen > 0)) {
+      Keyak_Spark(keyak, 0, NULL);
+    }
+  }
+  if ((keyak->pistonCount > 1) || forgetFlag) Keyak_Knot(keyak);
+  if (Keyak_HandleTag(keyak, 1, tag, unwrapFlag) != SUCCESS) {
+    memset(outputStart, 0, (size_t)outputByteLen);
+    return FAIL;
+  }
+  return SUCCESS;
+}
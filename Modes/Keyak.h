@@ -0,0 +1,122 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _Keyak_h_
+#define _Keyak_h_
+
+#include "Modes/KeccakHash.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+/**
+  * Keyak is a family of authenticated encryption schemes that follow the
+  * Motorist mode on top of Keccak-p[1600, 12], with a capacity of 256 bits
+  * and 128-bit tags. Its members differ by their number of pistons, i.e., of
+  * duplex-like states that process consecutive parts of the data in
+  * parallel: 1 for Lake Keyak, 2 for Sea Keyak, 4 for Ocean Keyak and 8 for
+  * Lunar Keyak. With 4 or 8 pistons, the states are permuted four at a time
+  * with KeccakP1600times4_*.
+  * A session starts with a key and a nonce, and then wraps (or unwraps) a
+  * sequence of messages, each with its associated data and tag.
+  */
+
+/** The number of pistons of each member of the family. */
+#define Keyak_pistonsLake 1
+#define Keyak_pistonsSea 2
+#define Keyak_pistonsOcean 4
+#define Keyak_pistonsLunar 8
+#define Keyak_maxPistons 8
+
+/** The size in bytes of a tag. */
+#define Keyak_tagSize 16
+/** The maximum key length in bytes. */
+#define Keyak_maxKeyByteLen 38
+/** The maximum nonce length in bytes. */
+#define Keyak_maxNonceByteLen 150
+
+/**
+  * Structure that contains a Keyak session.
+  */
+typedef struct {
+  /** The states of the pistons: groups of four states in the layout of
+    * KeccakF1600times4_* with 4 or 8 pistons, one state each otherwise. */
+  ALIGN unsigned char states[Keyak_maxPistons * KeccakF_width / 8];
+  /** The number of pistons. */
+  unsigned int pistonCount;
+  /** For each piston, the offset where the next data to encrypt starts. */
+  unsigned char offsets[Keyak_maxPistons];
+  /** Set if a tag did not match, after which the session is unusable. */
+  int failed;
+} Keyak_Instance;
+
+/**
+  * Function to start a session.
+  * @param  keyak           Pointer to the instance to be initialized.
+  * @param  pistonCount     The number of pistons, e.g., Keyak_pistonsLake.
+  * @param  key             Pointer to the key.
+  * @param  keyByteLen      The length of the key in bytes.
+  * @param  nonce           Pointer to the nonce.
+  * @param  nonceByteLen    The length of the nonce in bytes.
+  * @param  tagFlag         If set, a tag is produced or checked on the
+  *                         session start.
+  * @param  tag             The buffer where to store the tag, or the tag to
+  *                         check if @a unwrapFlag is set.
+  * @param  unwrapFlag      Whether the tag is checked rather than produced.
+  * @param  forgetFlag      If set, the states are made irreversible.
+  * @pre    @a pistonCount is 1, 2, 4 or 8.
+  * @pre    @a keyByteLen ≤ Keyak_maxKeyByteLen
+  * @pre    @a nonceByteLen ≤ Keyak_maxNonceByteLen
+  * @return SUCCESS if successful, FAIL otherwise, including when the tag
+  *         does not match.
+  */
+HashReturn Keyak_Initialize(Keyak_Instance* keyak,
+                            unsigned int pistonCount,
+                            const unsigned char* key,
+                            unsigned int keyByteLen,
+                            const unsigned char* nonce,
+                            unsigned int nonceByteLen,
+                            int tagFlag,
+                            unsigned char* tag,
+                            int unwrapFlag,
+                            int forgetFlag);
+
+/**
+  * Function to wrap or unwrap a message with its associated data.
+  * When unwrapping, the output is only valid if SUCCESS is returned;
+  * otherwise it is cleared.
+  * @param  keyak           Pointer to the instance.
+  * @param  input           Pointer to the plaintext, or to the ciphertext if
+  *                         @a unwrapFlag is set.
+  * @param  output          Pointer to the buffer where to store the
+  *                         ciphertext, or the plaintext. It may be equal to
+  *                         @a input.
+  * @param  dataByteLen     The length of the message in bytes.
+  * @param  AD              Pointer to the associated data.
+  * @param  ADByteLen       The length of the associated data in bytes.
+  * @param  tag             The buffer where to store the Keyak_tagSize-byte
+  *                         tag, or the tag to check if @a unwrapFlag is set.
+  * @param  unwrapFlag      Whether to decrypt and check rather than encrypt.
+  * @param  forgetFlag      If set, the states are made irreversible.
+  * @return SUCCESS if successful, FAIL otherwise, including when the tag
+  *         does not match.
+  */
+HashReturn Keyak_Wrap(Keyak_Instance* keyak,
+                      const unsigned char* input,
+                      unsigned char* output,
+                      unsigned long long dataByteLen,
+                      const unsigned char* AD,
+                      unsigned long long ADByteLen,
+                      unsigned char* tag,
+                      int unwrapFlag,
+                      int forgetFlag);
+
+#endif
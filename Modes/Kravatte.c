@@ -0,0 +1,281 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/Kravatte.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// The masks, the accumulator and the rolled states are kept as bytes, lanes
+// in little-endian order, and only go through the permutation interface.
+
+#define Kravatte_laneCount (Kravatte_blockSize / 8)
+#define ROL64(a, offset) \
+  ((((uint64_t)a) << offset) ^ (((uint64_t)a) >> (64 - offset)))
+
+static uint64_t Kravatte_LoadLane(const unsigned char* data) {
+  uint64_t lane = 0;
+  int i;
+
+  for (i = 7; i >= 0; i--) lane = (lane << 8) | data[i];
+  return lane;
+}
+
+static void Kravatte_StoreLane(unsigned char* data, uint64_t lane) {
+  unsigned int i;
+
+  for (i = 0; i < 8; i++, lane >>= 8) data[i] = (unsigned char)lane;
+}
+
+static void Kravatte_AddBytes(unsigned char* data,
+                              const unsigned char* other,
+                              unsigned int length) {
+  unsigned int i;
+
+  for (i = 0; i < length; i++) data[i] ^= other[i];
+}
+
+// roll_c, on the last 5 lanes: x0 <- (x0 <<< 7) + x1 + (x1 >> 3), then the
+// lanes are shifted by one position, x0 going last.
+static void Kravatte_Rollc(unsigned char* block) {
+  uint64_t x0 = Kravatte_LoadLane(block + 20 * 8);
+  uint64_t x1 = Kravatte_LoadLane(block + 21 * 8);
+
+  x0 = ROL64(x0, 7) ^ x1 ^ (x1 >> 3);
+  memmove(block + 20 * 8, block + 21 * 8, 4 * 8);
+  Kravatte_StoreLane(block + 24 * 8, x0);
+}
+
+// roll_e, on the last 10 lanes: x0 <- (x0 <<< 7) + (x1 <<< 18) +
+// (x2 & (x1 >> 1)), then the lanes are shifted by one position, x0 going
+// last.
+static void Kravatte_Rolle(unsigned char* block) {
+  uint64_t x0 = Kravatte_LoadLane(block + 15 * 8);
+  uint64_t x1 = Kravatte_LoadLane(block + 16 * 8);
+  uint64_t x2 = Kravatte_LoadLane(block + 17 * 8);
+
+  x0 = ROL64(x0, 7) ^ ROL64(x1, 18) ^ (x2 & (x1 >> 1));
+  memmove(block + 15 * 8, block + 16 * 8, 9 * 8);
+  Kravatte_StoreLane(block + 24 * 8, x0);
+}
+
+// Applies Keccak-p[1600, 6] on a block.
+static void Kravatte_Permute(unsigned char* block) {
+  ALIGN unsigned char state[KeccakF_width / 8];
+
+  KeccakF1600_StateInitialize(state);
+  KeccakF1600_StateXORLanes(state, block, Kravatte_laneCount);
+  KeccakP1600_StatePermute6rounds(state);
+  KeccakF1600_StateExtractLanes(state, block, Kravatte_laneCount);
+}
+
+/* ---------------------------------------------------------------- */
+
+// x <- x + p_c(block + kRoll), then kRoll <- roll_c(kRoll)
+static void Kravatte_CompressBlock(Kravatte_Instance* kv,
+                                   const unsigned char* block) {
+  ALIGN unsigned char t[Kravatte_blockSize];
+
+  memcpy(t, block, Kravatte_blockSize);
+  Kravatte_AddBytes(t, kv->kRoll, Kravatte_blockSize);
+  Kravatte_Permute(t);
+  Kravatte_AddBytes(kv->xAccu, t, Kravatte_blockSize);
+  Kravatte_Rollc(kv->kRoll);
+}
+
+// Same as Kravatte_CompressBlock() on four consecutive blocks, in parallel.
+static void Kravatte_CompressBlocksTimes4(Kravatte_Instance* kv,
+                                          const unsigned char* blocks) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char t[KeccakF1600times4_parallelism * Kravatte_blockSize];
+  unsigned int i;
+
+  for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+    memcpy(t + i * Kravatte_blockSize, kv->kRoll, Kravatte_blockSize);
+    Kravatte_Rollc(kv->kRoll);
+  }
+  KeccakF1600times4_StateInitializeAll(states);
+  KeccakF1600times4_StateXORLanesAll(
+      states, t, Kravatte_laneCount, Kravatte_blockSize);
+  KeccakF1600times4_StateXORLanesAll(
+      states, blocks, Kravatte_laneCount, Kravatte_blockSize);
+  KeccakP1600times4_StatePermuteAll6rounds(states);
+  KeccakF1600times4_StateExtractLanesAll(
+      states, t, Kravatte_laneCount, Kravatte_blockSize);
+  for (i = 0; i < KeccakF1600times4_parallelism; i++)
+    Kravatte_AddBytes(
+        kv->xAccu, t + i * Kravatte_blockSize, Kravatte_blockSize);
+}
+
+// output <- p_e(yAccu) + k', then yAccu <- roll_e(yAccu)
+static void Kravatte_ExpandBlock(Kravatte_Instance* kv,
+                                 unsigned char* output) {
+  memcpy(output, kv->yAccu, Kravatte_blockSize);
+  Kravatte_Permute(output);
+  Kravatte_AddBytes(output, kv->kRoll, Kravatte_blockSize);
+  Kravatte_Rolle(kv->yAccu);
+}
+
+// Same as Kravatte_ExpandBlock() for four consecutive blocks, in parallel.
+static void Kravatte_ExpandBlocksTimes4(Kravatte_Instance* kv,
+                                        unsigned char* output) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  unsigned int i;
+
+  for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+    memcpy(output + i * Kravatte_blockSize, kv->yAccu, Kravatte_blockSize);
+    Kravatte_Rolle(kv->yAccu);
+  }
+  KeccakF1600times4_StateInitializeAll(states);
+  KeccakF1600times4_StateXORLanesAll(
+      states, output, Kravatte_laneCount, Kravatte_blockSize);
+  KeccakP1600times4_StatePermuteAll6rounds(states);
+  KeccakF1600times4_StateExtractLanesAll(
+      states, output, Kravatte_laneCount, Kravatte_blockSize);
+  for (i = 0; i < KeccakF1600times4_parallelism; i++)
+    Kravatte_AddBytes(
+        output + i * Kravatte_blockSize, kv->kRoll, Kravatte_blockSize);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Kravatte_MaskDerivation(Kravatte_Instance* kv,
+                                   const unsigned char* key,
+                                   unsigned int keyByteLen) {
+  if (keyByteLen > Kravatte_maxKeyByteLen) return FAIL;
+  KeccakF1600_Initialize();
+
+  // k = p_b(K || 1 || 0*)
+  memset(kv->kRoll, 0, Kravatte_blockSize);
+  memcpy(kv->kRoll, key, keyByteLen);
+  kv->kRoll[keyByteLen] = 0x01;
+  Kravatte_Permute(kv->kRoll);
+
+  memset(kv->xAccu, 0, Kravatte_blockSize);
+  kv->queueOffset = 0;
+  kv->expanding = 0;
+  return SUCCESS;
+}
+
+HashReturn Kravatte_Compress(Kravatte_Instance* kv,
+                             const unsigned char* input,
+                             unsigned long long inputByteLen,
+                             int lastPart) {
+  unsigned int n;
+
+  if (kv->expanding) return FAIL;
+
+  // Complete the block started by a previous call
+  if (kv->queueOffset != 0) {
+    n = Kravatte_blockSize - kv->queueOffset;
+    if (n > inputByteLen) n = (unsigned int)inputByteLen;
+    memcpy(kv->queue + kv->queueOffset, input, n);
+    input += n;
+    inputByteLen -= n;
+    kv->queueOffset += n;
+    if (kv->queueOffset == Kravatte_blockSize) {
+      Kravatte_CompressBlock(kv, kv->queue);
+      kv->queueOffset = 0;
+    }
+  }
+
+  // Whole blocks, four at a time where possible
+  while (inputByteLen >=
+         KeccakF1600times4_parallelism * Kravatte_blockSize) {
+    Kravatte_CompressBlocksTimes4(kv, input);
+    input += KeccakF1600times4_parallelism * Kravatte_blockSize;
+    inputByteLen -= KeccakF1600times4_parallelism * Kravatte_blockSize;
+  }
+  while (inputByteLen >= Kravatte_blockSize) {
+    Kravatte_CompressBlock(kv, input);
+    input += Kravatte_blockSize;
+    inputByteLen -= Kravatte_blockSize;
+  }
+  if (inputByteLen > 0) {
+    memcpy(kv->queue, input, (size_t)inputByteLen);
+    kv->queueOffset = (unsigned int)inputByteLen;
+  }
+
+  if (lastPart) {
+    // The string is padded with 10*, and one mask is skipped before the next
+    // string or, eventually, k'.
+    kv->queue[kv->queueOffset] = 0x01;
+    memset(kv->queue + kv->queueOffset + 1,
+           0,
+           Kravatte_blockSize - kv->queueOffset - 1);
+    Kravatte_CompressBlock(kv, kv->queue);
+    kv->queueOffset = 0;
+    Kravatte_Rollc(kv->kRoll);
+  }
+  return SUCCESS;
+}
+
+HashReturn Kravatte_Expand(Kravatte_Instance* kv,
+                           unsigned char* output,
+                           unsigned long long outputByteLen) {
+  unsigned int n;
+
+  if (!kv->expanding) {
+    if (kv->queueOffset != 0) return FAIL;
+    // y = p_d(x), while kRoll now holds k'
+    memcpy(kv->yAccu, kv->xAccu, Kravatte_blockSize);
+    Kravatte_Permute(kv->yAccu);
+    kv->queueOffset = Kravatte_blockSize;
+    kv->expanding = 1;
+  }
+
+  // What remains of the last output block
+  n = Kravatte_blockSize - kv->queueOffset;
+  if (n > outputByteLen) n = (unsigned int)outputByteLen;
+  memcpy(output, kv->queue + kv->queueOffset, n);
+  output += n;
+  outputByteLen -= n;
+  kv->queueOffset += n;
+
+  // Whole blocks, four at a time where possible
+  while (outputByteLen >=
+         KeccakF1600times4_parallelism * Kravatte_blockSize) {
+    Kravatte_ExpandBlocksTimes4(kv, output);
+    output += KeccakF1600times4_parallelism * Kravatte_blockSize;
+    outputByteLen -= KeccakF1600times4_parallelism * Kravatte_blockSize;
+  }
+  while (outputByteLen >= Kravatte_blockSize) {
+    Kravatte_ExpandBlock(kv, output);
+    output += Kravatte_blockSize;
+    outputByteLen -= Kravatte_blockSize;
+  }
+  if (outputByteLen > 0) {
+    Kravatte_ExpandBlock(kv, kv->queue);
+    memcpy(output, kv->queue, (size_t)outputByteLen);
+    kv->queueOffset = (unsigned int)outputByteLen;
+  }
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Kravatte(const unsigned char* key,
+                    unsigned int keyByteLen,
+                    const unsigned char* input,
+                    unsigned long long inputByteLen,
+                    unsigned char* output,
+                    unsigned long long outputByteLen) {
+  Kravatte_Instance kv;
+
+  if (Kravatte_MaskDerivation(&kv, key, keyByteLen) != SUCCESS) return FAIL;
+  if (Kravatte_Compress(&kv, input, inputByteLen, 1) != SUCCESS) return FAIL;
+  return Kravatte_Expand(&kv, output, outputByteLen);
+}
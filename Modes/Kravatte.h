@@ -0,0 +1,115 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _Kravatte_h_
+#define _Kravatte_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * Kravatte is a deck function, i.e., a keyed function taking a sequence of
+  * strings and returning an output of arbitrary length, that follows the
+  * Farfalle construction with Keccak-p[1600, 6] in all its layers.
+  * Each input string, padded with 10*, is cut in 200-byte blocks that are
+  * masked with a rolling key, permuted and added together. The result is
+  * permuted once more and then rolled to give independent output blocks.
+  * As both the input blocks and the output blocks are processed
+  * independently, four of them at a time go through KeccakP1600times4_*.
+  * The key, the input strings and the output are a whole number of bytes.
+  */
+
+/** The size in bytes of an input or output block. */
+#define Kravatte_blockSize 200
+/** The maximum key length in bytes, so that its padding fits in one block. */
+#define Kravatte_maxKeyByteLen (Kravatte_blockSize - 1)
+
+/**
+  * Structure that contains a Kravatte computation in progress.
+  */
+typedef struct {
+  /** The mask of the next input block, or the mask k' of the output blocks
+    * once expanding. */
+  ALIGN unsigned char kRoll[Kravatte_blockSize];
+  /** The accumulator x of the permuted input blocks. */
+  ALIGN unsigned char xAccu[Kravatte_blockSize];
+  /** Once expanding, the rolled state from which the next output block is
+    * computed. */
+  ALIGN unsigned char yAccu[Kravatte_blockSize];
+  /** The bytes of an incomplete input block, or of the last output block. */
+  ALIGN unsigned char queue[Kravatte_blockSize];
+  /** The number of input bytes in the queue, or of output bytes already
+    * taken from it once expanding. */
+  unsigned int queueOffset;
+  /** If set to 0, input strings are accepted; otherwise, in the expansion. */
+  int expanding;
+} Kravatte_Instance;
+
+/**
+  * Function to initialize a Kravatte instance with a key.
+  * @param  kv          Pointer to the instance to be initialized.
+  * @param  key         Pointer to the key K.
+  * @param  keyByteLen  The length of the key in bytes.
+  * @pre    @a keyByteLen ≤ Kravatte_maxKeyByteLen
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Kravatte_MaskDerivation(Kravatte_Instance* kv,
+                                   const unsigned char* key,
+                                   unsigned int keyByteLen);
+
+/**
+  * Function to give (part of) an input string.
+  * An input string can be given in several calls, the last one with
+  * @a lastPart set. Several strings can be given before the expansion.
+  * @param  kv              Pointer to the instance.
+  * @param  input           Pointer to the input data.
+  * @param  inputByteLen    The number of input bytes.
+  * @param  lastPart        Non-zero if this call completes the string.
+  * @pre    Kravatte_Expand() must not have been called yet.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Kravatte_Compress(Kravatte_Instance* kv,
+                             const unsigned char* input,
+                             unsigned long long inputByteLen,
+                             int lastPart);
+
+/**
+  * Function to get output bytes. It can be called several times to get the
+  * output incrementally.
+  * @param  kv              Pointer to the instance.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputByteLen   The number of output bytes.
+  * @pre    The last input string must have been completed.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Kravatte_Expand(Kravatte_Instance* kv,
+                           unsigned char* output,
+                           unsigned long long outputByteLen);
+
+/**
+  * One-shot Kravatte function on a single input string.
+  * @param  key             Pointer to the key K.
+  * @param  keyByteLen      The length of the key in bytes.
+  * @param  input           Pointer to the input string.
+  * @param  inputByteLen    The length of the input string in bytes.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputByteLen   The number of output bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Kravatte(const unsigned char* key,
+                    unsigned int keyByteLen,
+                    const unsigned char* input,
+                    unsigned long long inputByteLen,
+                    unsigned char* output,
+                    unsigned long long outputByteLen);
+
+#endif
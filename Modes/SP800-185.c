@@ -0,0 +1,650 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/SP800-185.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+static const unsigned char SP800_185_zeroes[KeccakF_width / 8] = {0};
+
+// left_encode(x): the byte length of x followed by x in big-endian order.
+static unsigned int SP800_185_LeftEncode(unsigned char* encbuf,
+                                         DataLength value) {
+  unsigned int n, i;
+  DataLength v;
+
+  for (v = value, n = 0; v && (n < sizeof(DataLength)); ++n, v >>= 8)
+    ;
+  if (n == 0) n = 1;
+  for (i = 1; i <= n; ++i)
+    encbuf[i] = (unsigned char)(value >> (8 * (n - i)));
+  encbuf[0] = (unsigned char)n;
+  return n + 1;
+}
+
+// right_encode(x): x in big-endian order followed by its byte length.
+static unsigned int SP800_185_RightEncode(unsigned char* encbuf,
+                                          DataLength value) {
+  unsigned int n, i;
+  DataLength v;
+
+  for (v = value, n = 0; v && (n < sizeof(DataLength)); ++n, v >>= 8)
+    ;
+  if (n == 0) n = 1;
+  for (i = 1; i <= n; ++i)
+    encbuf[i - 1] = (unsigned char)(value >> (8 * (n - i)));
+  encbuf[n] = (unsigned char)n;
+  return n + 1;
+}
+
+/* ---------------------------------------------------------------- */
+
+// Absorbs encode_string(X) = left_encode(|X|) || X.
+static HashReturn SP800_185_AbsorbEncodedString(Keccak_HashInstance* instance,
+                                                const BitSequence* string,
+                                                DataLength stringBitLen) {
+  unsigned char encbuf[sizeof(DataLength) + 1];
+  unsigned int n;
+
+  if ((stringBitLen % 8) != 0) return FAIL;
+  n = SP800_185_LeftEncode(encbuf, stringBitLen);
+  if (Keccak_SpongeAbsorb(&instance->sponge, encbuf, n) != 0) return FAIL;
+  if (Keccak_SpongeAbsorb(&instance->sponge, string, stringBitLen / 8) != 0)
+    return FAIL;
+  return SUCCESS;
+}
+
+// Absorbs the zeroes that complete bytepad() up to the next block boundary.
+static HashReturn SP800_185_AbsorbZeroPadding(Keccak_HashInstance* instance) {
+  unsigned int rateInBytes = instance->sponge.rate / 8;
+  unsigned int byteIOIndex = instance->sponge.byteIOIndex;
+
+  if (byteIOIndex == 0) return SUCCESS;
+  if (Keccak_SpongeAbsorb(&instance->sponge,
+                          SP800_185_zeroes,
+                          rateInBytes - byteIOIndex) != 0)
+    return FAIL;
+  return SUCCESS;
+}
+
+// Absorbs left_encode(w), the start of bytepad(X, w) with w the rate in bytes.
+static HashReturn SP800_185_AbsorbBytepadHeader(Keccak_HashInstance* instance) {
+  unsigned char encbuf[sizeof(DataLength) + 1];
+  unsigned int n = SP800_185_LeftEncode(encbuf, instance->sponge.rate / 8);
+
+  if (Keccak_SpongeAbsorb(&instance->sponge, encbuf, n) != 0) return FAIL;
+  return SUCCESS;
+}
+
+/* ---------------------------------------------------------------- */
+
+static HashReturn cSHAKE_Initialize(cSHAKE_Instance* instance,
+                                    unsigned int rate,
+                                    unsigned int capacity,
+                                    DataLength outputBitLen,
+                                    const BitSequence* name,
+                                    DataLength nameBitLen,
+                                    const BitSequence* customization,
+                                    DataLength customBitLen) {
+  unsigned int fixedOutputLength = (unsigned int)outputBitLen;
+
+  if ((outputBitLen % 8) != 0) return FAIL;
+  // The hash instance keeps the output length in an unsigned int
+  if (fixedOutputLength != outputBitLen) return FAIL;
+  if ((nameBitLen % 8) != 0) return FAIL;
+  if ((customBitLen % 8) != 0) return FAIL;
+
+  // With N and S both empty, cSHAKE is SHAKE
+  if ((nameBitLen == 0) && (customBitLen == 0))
+    return Keccak_HashInitialize(
+        instance, rate, capacity, fixedOutputLength, 0x1F);
+
+  if (Keccak_HashInitialize(
+          instance, rate, capacity, fixedOutputLength, 0x04) != SUCCESS)
+    return FAIL;
+  if (SP800_185_AbsorbBytepadHeader(instance) != SUCCESS) return FAIL;
+  if (SP800_185_AbsorbEncodedString(instance, name, nameBitLen) != SUCCESS)
+    return FAIL;
+  if (SP800_185_AbsorbEncodedString(instance, customization, customBitLen) !=
+      SUCCESS)
+    return FAIL;
+  return SP800_185_AbsorbZeroPadding(instance);
+}
+
+HashReturn cSHAKE128_Initialize(cSHAKE_Instance* instance,
+                                DataLength outputBitLen,
+                                const BitSequence* name,
+                                DataLength nameBitLen,
+                                const BitSequence* customization,
+                                DataLength customBitLen) {
+  return cSHAKE_Initialize(instance,
+                           1344,
+                           256,
+                           outputBitLen,
+                           name,
+                           nameBitLen,
+                           customization,
+                           customBitLen);
+}
+
+HashReturn cSHAKE256_Initialize(cSHAKE_Instance* instance,
+                                DataLength outputBitLen,
+                                const BitSequence* name,
+                                DataLength nameBitLen,
+                                const BitSequence* customization,
+                                DataLength customBitLen) {
+  return cSHAKE_Initialize(instance,
+                           1088,
+                           512,
+                           outputBitLen,
+                           name,
+                           nameBitLen,
+                           customization,
+                           customBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn cSHAKE_Update(cSHAKE_Instance* instance,
+                         const BitSequence* input,
+                         DataLength inputBitLen) {
+  return Keccak_HashUpdate(instance, input, inputBitLen);
+}
+
+HashReturn cSHAKE_Final(cSHAKE_Instance* instance, BitSequence* output) {
+  return Keccak_HashFinal(instance, output);
+}
+
+HashReturn cSHAKE_Squeeze(cSHAKE_Instance* instance,
+                          BitSequence* output,
+                          DataLength outputBitLen) {
+  return Keccak_HashSqueeze(instance, output, outputBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn cSHAKE128(const BitSequence* input,
+                     DataLength inputBitLen,
+                     BitSequence* output,
+                     DataLength outputBitLen,
+                     const BitSequence* name,
+                     DataLength nameBitLen,
+                     const BitSequence* customization,
+                     DataLength customBitLen) {
+  cSHAKE_Instance csi;
+
+  if (outputBitLen == 0) return FAIL;
+  if (cSHAKE128_Initialize(&csi,
+                           outputBitLen,
+                           name,
+                           nameBitLen,
+                           customization,
+                           customBitLen) != SUCCESS)
+    return FAIL;
+  if (cSHAKE_Update(&csi, input, inputBitLen) != SUCCESS) return FAIL;
+  return cSHAKE_Final(&csi, output);
+}
+
+HashReturn cSHAKE256(const BitSequence* input,
+                     DataLength inputBitLen,
+                     BitSequence* output,
+                     DataLength outputBitLen,
+                     const BitSequence* name,
+                     DataLength nameBitLen,
+                     const BitSequence* customization,
+                     DataLength customBitLen) {
+  cSHAKE_Instance csi;
+
+  if (outputBitLen == 0) return FAIL;
+  if (cSHAKE256_Initialize(&csi,
+                           outputBitLen,
+                           name,
+                           nameBitLen,
+                           customization,
+                           customBitLen) != SUCCESS)
+    return FAIL;
+  if (cSHAKE_Update(&csi, input, inputBitLen) != SUCCESS) return FAIL;
+  return cSHAKE_Final(&csi, output);
+}
+
+/* ---------------------------------------------------------------- */
+
+static HashReturn KMAC_KeyInitialize(KMAC_KeyInstance* keyInstance,
+                                     unsigned int rate,
+                                     unsigned int capacity,
+                                     const BitSequence* key,
+                                     DataLength keyBitLen,
+                                     const BitSequence* customization,
+                                     DataLength customBitLen) {
+  const BitSequence* name = (const BitSequence*)"KMAC";
+
+  if ((keyBitLen % 8) != 0) return FAIL;
+  if (cSHAKE_Initialize(&keyInstance->csi,
+                        rate,
+                        capacity,
+                        0,
+                        name,
+                        4 * 8,
+                        customization,
+                        customBitLen) != SUCCESS)
+    return FAIL;
+  // bytepad(encode_string(K), rate)
+  if (SP800_185_AbsorbBytepadHeader(&keyInstance->csi) != SUCCESS) return FAIL;
+  if (SP800_185_AbsorbEncodedString(&keyInstance->csi, key, keyBitLen) !=
+      SUCCESS)
+    return FAIL;
+  return SP800_185_AbsorbZeroPadding(&keyInstance->csi);
+}
+
+HashReturn KMAC128_KeyInitialize(KMAC_KeyInstance* keyInstance,
+                                 const BitSequence* key,
+                                 DataLength keyBitLen,
+                                 const BitSequence* customization,
+                                 DataLength customBitLen) {
+  return KMAC_KeyInitialize(keyInstance,
+                            1344,
+                            256,
+                            key,
+                            keyBitLen,
+                            customization,
+                            customBitLen);
+}
+
+HashReturn KMAC256_KeyInitialize(KMAC_KeyInstance* keyInstance,
+                                 const BitSequence* key,
+                                 DataLength keyBitLen,
+                                 const BitSequence* customization,
+                                 DataLength customBitLen) {
+  return KMAC_KeyInitialize(keyInstance,
+                            1088,
+                            512,
+                            key,
+                            keyBitLen,
+                            customization,
+                            customBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KMAC_Initialize(KMAC_Instance* kmacInstance,
+                           const KMAC_KeyInstance* keyInstance,
+                           DataLength outputBitLen) {
+  if ((outputBitLen % 8) != 0) return FAIL;
+  if ((unsigned int)outputBitLen != outputBitLen) return FAIL;
+  // The key state ends on a block boundary: copying it is all it takes.
+  kmacInstance->csi = keyInstance->csi;
+  kmacInstance->csi.fixedOutputLength = (unsigned int)outputBitLen;
+  kmacInstance->outputBitLen = outputBitLen;
+  kmacInstance->squeezing = 0;
+  return SUCCESS;
+}
+
+HashReturn KMAC_Update(KMAC_Instance* kmacInstance,
+                       const BitSequence* input,
+                       DataLength inputBitLen) {
+  if (kmacInstance->squeezing) return FAIL;
+  if ((inputBitLen % 8) != 0) return FAIL;
+  return cSHAKE_Update(&kmacInstance->csi, input, inputBitLen);
+}
+
+HashReturn KMAC_Final(KMAC_Instance* kmacInstance, BitSequence* output) {
+  unsigned char encbuf[sizeof(DataLength) + 1];
+  unsigned int n;
+
+  if (kmacInstance->squeezing) return FAIL;
+  // right_encode(L), with L = 0 for KMACXOF
+  n = SP800_185_RightEncode(encbuf, kmacInstance->outputBitLen);
+  if (cSHAKE_Update(&kmacInstance->csi, encbuf, n * 8) != SUCCESS) return FAIL;
+  kmacInstance->squeezing = 1;
+  return cSHAKE_Final(&kmacInstance->csi, output);
+}
+
+HashReturn KMAC_Squeeze(KMAC_Instance* kmacInstance,
+                        BitSequence* output,
+                        DataLength outputBitLen) {
+  if (!kmacInstance->squeezing) return FAIL;
+  if (kmacInstance->outputBitLen != 0) return FAIL;
+  return cSHAKE_Squeeze(&kmacInstance->csi, output, outputBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn KMAC_WithKey(const KMAC_KeyInstance* keyInstance,
+                        const BitSequence* input,
+                        DataLength inputBitLen,
+                        BitSequence* output,
+                        DataLength outputBitLen) {
+  KMAC_Instance kmacInstance;
+
+  if (outputBitLen == 0) return FAIL;
+  if (KMAC_Initialize(&kmacInstance, keyInstance, outputBitLen) != SUCCESS)
+    return FAIL;
+  if (KMAC_Update(&kmacInstance, input, inputBitLen) != SUCCESS) return FAIL;
+  return KMAC_Final(&kmacInstance, output);
+}
+
+HashReturn KMAC128(const BitSequence* key,
+                   DataLength keyBitLen,
+                   const BitSequence* input,
+                   DataLength inputBitLen,
+                   BitSequence* output,
+                   DataLength outputBitLen,
+                   const BitSequence* customization,
+                   DataLength customBitLen) {
+  KMAC_KeyInstance keyInstance;
+
+  if (KMAC128_KeyInitialize(
+          &keyInstance, key, keyBitLen, customization, customBitLen) !=
+      SUCCESS)
+    return FAIL;
+  return KMAC_WithKey(&keyInstance, input, inputBitLen, output, outputBitLen);
+}
+
+HashReturn KMAC256(const BitSequence* key,
+                   DataLength keyBitLen,
+                   const BitSequence* input,
+                   DataLength inputBitLen,
+                   BitSequence* output,
+                   DataLength outputBitLen,
+                   const BitSequence* customization,
+                   DataLength customBitLen) {
+  KMAC_KeyInstance keyInstance;
+
+  if (KMAC256_KeyInitialize(
+          &keyInstance, key, keyBitLen, customization, customBitLen) !=
+      SUCCESS)
+    return FAIL;
+  return KMAC_WithKey(&keyInstance, input, inputBitLen, output, outputBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+// The number of leaves hashed per call to ParallelHash_HashLeaves() from
+// ParallelHash_Update(), bounding the chaining values kept on the stack.
+#define ParallelHash_leavesPerUpdate 8
+#define ParallelHash_maxChainingValueSize 64
+
+// The chaining value size in bytes is c/8: 32 for ParallelHash128 and 64 for
+// ParallelHash256.
+static unsigned int ParallelHash_ChainingValueSize(
+    const ParallelHash_Instance* phInstance) {
+  return (KeccakF_width - phInstance->finalNode.sponge.rate) / 8;
+}
+
+static HashReturn ParallelHash_Initialize(ParallelHash_Instance* phInstance,
+                                          unsigned int rate,
+                                          unsigned int capacity,
+                                          unsigned long long blockByteLen,
+                                          DataLength outputBitLen,
+                                          const BitSequence* customization,
+                                          DataLength customBitLen) {
+  const BitSequence* name = (const BitSequence*)"ParallelHash";
+  unsigned char encbuf[sizeof(DataLength) + 1];
+  unsigned int n;
+
+  if (blockByteLen == 0) return FAIL;
+  if (cSHAKE_Initialize(&phInstance->finalNode,
+                        rate,
+                        capacity,
+                        outputBitLen,
+                        name,
+                        12 * 8,
+                        customization,
+                        customBitLen) != SUCCESS)
+    return FAIL;
+  n = SP800_185_LeftEncode(encbuf, blockByteLen);
+  if (cSHAKE_Update(&phInstance->finalNode, encbuf, n * 8) != SUCCESS)
+    return FAIL;
+  phInstance->blockLen = blockByteLen;
+  phInstance->queueAbsorbedLen = 0;
+  phInstance->leafCount = 0;
+  phInstance->outputBitLen = outputBitLen;
+  phInstance->squeezing = 0;
+  return SUCCESS;
+}
+
+HashReturn ParallelHash128_Initialize(ParallelHash_Instance* phInstance,
+                                      unsigned long long blockByteLen,
+                                      DataLength outputBitLen,
+                                      const BitSequence* customization,
+                                      DataLength customBitLen) {
+  return ParallelHash_Initialize(phInstance,
+                                 1344,
+                                 256,
+                                 blockByteLen,
+                                 outputBitLen,
+                                 customization,
+                                 customBitLen);
+}
+
+HashReturn ParallelHash256_Initialize(ParallelHash_Instance* phInstance,
+                                      unsigned long long blockByteLen,
+                                      DataLength outputBitLen,
+                                      const BitSequence* customization,
+                                      DataLength customBitLen) {
+  return ParallelHash_Initialize(phInstance,
+                                 1088,
+                                 512,
+                                 blockByteLen,
+                                 outputBitLen,
+                                 customization,
+                                 customBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn ParallelHash_HashLeaves(const ParallelHash_Instance* phInstance,
+                                   const BitSequence* input,
+                                   unsigned long long leafCount,
+                                   BitSequence* chainingValues) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  const unsigned char suffix = 0x1F;
+  const unsigned char lastByte = 0x80;
+  unsigned int rate = phInstance->finalNode.sponge.rate;
+  unsigned int rateInBytes = rate / 8;
+  unsigned int cvSize = ParallelHash_ChainingValueSize(phInstance);
+  unsigned long long blockLen = phInstance->blockLen;
+  unsigned long long absorbed;
+  unsigned int i, partialLen;
+  Keccak_SpongeInstance leaf;
+
+  // Four leaves at a time, each in its own state
+  while (leafCount >= KeccakF1600times4_parallelism) {
+    KeccakF1600times4_StateInitializeAll(states);
+    absorbed = KeccakF1600times4_StateAbsorbBlocksAll(
+        states, rateInBytes / 8, input, blockLen, blockLen);
+    partialLen = (unsigned int)(blockLen - absorbed);
+    for (i = 0; i < KeccakF1600times4_parallelism; i++) {
+      // SHAKE padding: the 0x1F suffix, then the last bit of the block
+      KeccakF1600times4_StateXORBytes(
+          states, i, input + i * blockLen + absorbed, 0, partialLen);
+      KeccakF1600times4_StateXORBytes(states, i, &suffix, partialLen, 1);
+      KeccakF1600times4_StateXORBytes(states, i, &lastByte, rateInBytes - 1, 1);
+    }
+    KeccakF1600times4_StatePermuteAll(states);
+    for (i = 0; i < KeccakF1600times4_parallelism; i++)
+      KeccakF1600times4_StateExtractBytes(
+          states, i, chainingValues + i * cvSize, 0, cvSize);
+    input += KeccakF1600times4_parallelism * blockLen;
+    chainingValues += KeccakF1600times4_parallelism * cvSize;
+    leafCount -= KeccakF1600times4_parallelism;
+  }
+
+  // The remaining leaves, one at a time
+  for (; leafCount > 0; leafCount--) {
+    if (Keccak_SpongeInitialize(&leaf, rate, KeccakF_width - rate) != 0)
+      return FAIL;
+    if (Keccak_SpongeAbsorb(&leaf, input, blockLen) != 0) return FAIL;
+    if (Keccak_SpongeAbsorbLastFewBits(&leaf, suffix) != 0) return FAIL;
+    if (Keccak_SpongeSqueeze(&leaf, chainingValues, cvSize) != 0) return FAIL;
+    input += blockLen;
+    chainingValues += cvSize;
+  }
+  return SUCCESS;
+}
+
+HashReturn ParallelHash_UpdateChainingValues(
+    ParallelHash_Instance* phInstance,
+    const BitSequence* chainingValues,
+    unsigned long long leafCount) {
+  unsigned int cvSize = ParallelHash_ChainingValueSize(phInstance);
+
+  if (phInstance->squeezing) return FAIL;
+  if (phInstance->queueAbsorbedLen != 0) return FAIL;
+  if (cSHAKE_Update(&phInstance->finalNode,
+                    chainingValues,
+                    leafCount * cvSize * 8) != SUCCESS)
+    return FAIL;
+  phInstance->leafCount += leafCount;
+  return SUCCESS;
+}
+
+// Completes the leaf in the queue, possibly shorter than B if it is the last.
+static HashReturn ParallelHash_FlushQueue(ParallelHash_Instance* phInstance) {
+  unsigned char chainingValue[ParallelHash_maxChainingValueSize];
+
+  if (Keccak_HashFinal(&phInstance->queueNode, chainingValue) != SUCCESS)
+    return FAIL;
+  phInstance->queueAbsorbedLen = 0;
+  return ParallelHash_UpdateChainingValues(phInstance, chainingValue, 1);
+}
+
+HashReturn ParallelHash_Update(ParallelHash_Instance* phInstance,
+                               const BitSequence* input,
+                               DataLength inputBitLen) {
+  unsigned char chainingValues[ParallelHash_leavesPerUpdate *
+                               ParallelHash_maxChainingValueSize];
+  unsigned int rate = phInstance->finalNode.sponge.rate;
+  unsigned long long blockLen = phInstance->blockLen;
+  unsigned long long dataByteLen, n;
+
+  if (phInstance->squeezing) return FAIL;
+  if ((inputBitLen % 8) != 0) return FAIL;
+  dataByteLen = inputBitLen / 8;
+
+  // Complete the leaf started by a previous call
+  if (phInstance->queueAbsorbedLen != 0) {
+    n = blockLen - phInstance->queueAbsorbedLen;
+    if (n > dataByteLen) n = dataByteLen;
+    if (Keccak_HashUpdate(&phInstance->queueNode, input, n * 8) != SUCCESS)
+      return FAIL;
+    input += n;
+    dataByteLen -= n;
+    phInstance->queueAbsorbedLen += n;
+    if (phInstance->queueAbsorbedLen == blockLen)
+      if (ParallelHash_FlushQueue(phInstance) != SUCCESS) return FAIL;
+  }
+
+  // Whole leaves, hashed in parallel where possible
+  while (dataByteLen >= blockLen) {
+    n = dataByteLen / blockLen;
+    if (n > ParallelHash_leavesPerUpdate) n = ParallelHash_leavesPerUpdate;
+    if (ParallelHash_HashLeaves(phInstance, input, n, chainingValues) !=
+        SUCCESS)
+      return FAIL;
+    if (ParallelHash_UpdateChainingValues(phInstance, chainingValues, n) !=
+        SUCCESS)
+      return FAIL;
+    input += n * blockLen;
+    dataByteLen -= n * blockLen;
+  }
+
+  // Start a new leaf with what remains
+  if (dataByteLen > 0) {
+    if (Keccak_HashInitialize(&phInstance->queueNode,
+                              rate,
+                              KeccakF_width - rate,
+                              KeccakF_width - rate,
+                              0x1F) != SUCCESS)
+      return FAIL;
+    if (Keccak_HashUpdate(&phInstance->queueNode, input, dataByteLen * 8) !=
+        SUCCESS)
+      return FAIL;
+    phInstance->queueAbsorbedLen = dataByteLen;
+  }
+  return SUCCESS;
+}
+
+HashReturn ParallelHash_Final(ParallelHash_Instance* phInstance,
+                              BitSequence* output) {
+  unsigned char encbuf[sizeof(DataLength) + 1];
+  unsigned int n;
+
+  if (phInstance->squeezing) return FAIL;
+  if (phInstance->queueAbsorbedLen != 0)
+    if (ParallelHash_FlushQueue(phInstance) != SUCCESS) return FAIL;
+  // right_encode(n) || right_encode(L), with L = 0 for ParallelHashXOF
+  n = SP800_185_RightEncode(encbuf, phInstance->leafCount);
+  if (cSHAKE_Update(&phInstance->finalNode, encbuf, n * 8) != SUCCESS)
+    return FAIL;
+  n = SP800_185_RightEncode(encbuf, phInstance->outputBitLen);
+  if (cSHAKE_Update(&phInstance->finalNode, encbuf, n * 8) != SUCCESS)
+    return FAIL;
+  phInstance->squeezing = 1;
+  return cSHAKE_Final(&phInstance->finalNode, output);
+}
+
+HashReturn ParallelHash_Squeeze(ParallelHash_Instance* phInstance,
+                                BitSequence* output,
+                                DataLength outputBitLen) {
+  if (!phInstance->squeezing) return FAIL;
+  if (phInstance->outputBitLen != 0) return FAIL;
+  return cSHAKE_Squeeze(&phInstance->finalNode, output, outputBitLen);
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn ParallelHash128(const BitSequence* input,
+                           DataLength inputBitLen,
+                           unsigned long long blockByteLen,
+                           BitSequence* output,
+                           DataLength outputBitLen,
+                           const BitSequence* customization,
+                           DataLength customBitLen) {
+  ParallelHash_Instance phInstance;
+
+  if (outputBitLen == 0) return FAIL;
+  if (ParallelHash128_Initialize(&phInstance,
+                                 blockByteLen,
+                                 outputBitLen,
+                                 customization,
+                                 customBitLen) != SUCCESS)
+    return FAIL;
+  if (ParallelHash_Update(&phInstance, input, inputBitLen) != SUCCESS)
+    return FAIL;
+  return ParallelHash_Final(&phInstance, output);
+}
+
+HashReturn ParallelHash256(const BitSequence* input,
+                           DataLength inputBitLen,
+                           unsigned long long blockByteLen,
+                           BitSequence* output,
+                           DataLength outputBitLen,
+                           const BitSequence* customization,
+                           DataLength customBitLen) {
+  ParallelHash_Instance phInstance;
+
+  if (outputBitLen == 0) return FAIL;
+  if (ParallelHash256_Initialize(&phInstance,
+                                 blockByteLen,
+                                 outputBitLen,
+                                 customization,
+                                 customBitLen) != SUCCESS)
+    return FAIL;
+  if (ParallelHash_Update(&phInstance, input, inputBitLen) != SUCCESS)
+    return FAIL;
+  return ParallelHash_Final(&phInstance, output);
+}
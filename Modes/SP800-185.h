@@ -0,0 +1,422 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _SP800_185_h_
+#define _SP800_185_h_
+
+#include "Modes/KeccakHash.h"
+
+/**
+  * The functions below implement cSHAKE and KMAC as specified in
+  * NIST SP 800-185. The function name, customization string and key
+  * must be a whole number of bytes; their lengths are still given in bits
+  * for consistency with the rest of the interface.
+  */
+
+/**
+  * A cSHAKE instance is a hash instance whose state already contains
+  * bytepad(encode_string(N) || encode_string(S), rate).
+  */
+typedef Keccak_HashInstance cSHAKE_Instance;
+
+/**
+  * Function to initialize a cSHAKE128 instance.
+  * @param  cskInstance     Pointer to the instance to be initialized.
+  * @param  outputBitLen    The desired number of output bits,
+  *                         or 0 for an arbitrarily-long output.
+  * @param  name            Pointer to the function name string N.
+  * @param  nameBitLen      The length of the function name in bits.
+  * @param  customization   Pointer to the customization string S.
+  * @param  customBitLen    The length of the customization string in bits.
+  * @pre    @a nameBitLen and @a customBitLen are multiples of 8.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn cSHAKE128_Initialize(cSHAKE_Instance* cskInstance,
+                                DataLength outputBitLen,
+                                const BitSequence* name,
+                                DataLength nameBitLen,
+                                const BitSequence* customization,
+                                DataLength customBitLen);
+
+/**
+  * Function to initialize a cSHAKE256 instance.
+  * See cSHAKE128_Initialize() for the parameters.
+  */
+HashReturn cSHAKE256_Initialize(cSHAKE_Instance* cskInstance,
+                                DataLength outputBitLen,
+                                const BitSequence* name,
+                                DataLength nameBitLen,
+                                const BitSequence* customization,
+                                DataLength customBitLen);
+
+/**
+  * Function to give input data to be absorbed by cSHAKE.
+  * Same semantics as Keccak_HashUpdate().
+  */
+HashReturn cSHAKE_Update(cSHAKE_Instance* cskInstance,
+                         const BitSequence* input,
+                         DataLength inputBitLen);
+
+/**
+  * Function to call after all the input has been given.
+  * Same semantics as Keccak_HashFinal().
+  */
+HashReturn cSHAKE_Final(cSHAKE_Instance* cskInstance, BitSequence* output);
+
+/**
+  * Function to squeeze output data, when the output length given to
+  * the initialization function was 0.
+  * Same semantics as Keccak_HashSqueeze().
+  */
+HashReturn cSHAKE_Squeeze(cSHAKE_Instance* cskInstance,
+                          BitSequence* output,
+                          DataLength outputBitLen);
+
+/**
+  * One-shot cSHAKE128 function.
+  * @param  input           Pointer to the input message X.
+  * @param  inputBitLen     The length of X in bits.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputBitLen    The number of output bits L (a multiple of 8).
+  * @param  name            Pointer to the function name string N.
+  * @param  nameBitLen      The length of the function name in bits.
+  * @param  customization   Pointer to the customization string S.
+  * @param  customBitLen    The length of the customization string in bits.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn cSHAKE128(const BitSequence* input,
+                     DataLength inputBitLen,
+                     BitSequence* output,
+                     DataLength outputBitLen,
+                     const BitSequence* name,
+                     DataLength nameBitLen,
+                     const BitSequence* customization,
+                     DataLength customBitLen);
+
+/**
+  * One-shot cSHAKE256 function.
+  * See cSHAKE128() for the parameters.
+  */
+HashReturn cSHAKE256(const BitSequence* input,
+                     DataLength inputBitLen,
+                     BitSequence* output,
+                     DataLength outputBitLen,
+                     const BitSequence* name,
+                     DataLength nameBitLen,
+                     const BitSequence* customization,
+                     DataLength customBitLen);
+
+/* ---------------------------------------------------------------- */
+
+/**
+  * Structure that holds a KMAC key in precomputed form: the cSHAKE state
+  * after absorbing bytepad(encode_string("KMAC") || encode_string(S), rate)
+  * and bytepad(encode_string(K), rate).
+  * Both paddings end on a block boundary, so starting a MAC from a copy of
+  * this state costs no permutation.
+  */
+typedef struct {
+  cSHAKE_Instance csi;
+} KMAC_KeyInstance;
+
+/**
+  * Structure that contains a KMAC computation in progress.
+  */
+typedef struct {
+  cSHAKE_Instance csi;
+  /** The requested output length in bits, or 0 for KMACXOF. */
+  DataLength outputBitLen;
+  /** If set to 0, in the absorbing phase; otherwise, in the squeezing phase. */
+  int squeezing;
+} KMAC_Instance;
+
+/**
+  * Function to precompute a KMAC128 key.
+  * @param  keyInstance     Pointer to the key instance to be initialized.
+  * @param  key             Pointer to the key K.
+  * @param  keyBitLen       The length of the key in bits.
+  * @param  customization   Pointer to the customization string S.
+  * @param  customBitLen    The length of the customization string in bits.
+  * @pre    @a keyBitLen and @a customBitLen are multiples of 8.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC128_KeyInitialize(KMAC_KeyInstance* keyInstance,
+                                 const BitSequence* key,
+                                 DataLength keyBitLen,
+                                 const BitSequence* customization,
+                                 DataLength customBitLen);
+
+/**
+  * Function to precompute a KMAC256 key.
+  * See KMAC128_KeyInitialize() for the parameters.
+  */
+HashReturn KMAC256_KeyInitialize(KMAC_KeyInstance* keyInstance,
+                                 const BitSequence* key,
+                                 DataLength keyBitLen,
+                                 const BitSequence* customization,
+                                 DataLength customBitLen);
+
+/**
+  * Function to start a KMAC computation from a precomputed key.
+  * The key instance is not modified and can be reused for any number of
+  * computations.
+  * @param  kmacInstance    Pointer to the instance to be initialized.
+  * @param  keyInstance     Pointer to a key instance initialized by
+  *                         KMAC128_KeyInitialize() or KMAC256_KeyInitialize().
+  * @param  outputBitLen    The desired number of output bits,
+  *                         or 0 for KMACXOF (arbitrarily-long output).
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC_Initialize(KMAC_Instance* kmacInstance,
+                           const KMAC_KeyInstance* keyInstance,
+                           DataLength outputBitLen);
+
+/**
+  * Function to give input data to be authenticated.
+  * @param  kmacInstance    Pointer to the instance initialized by
+  *                         KMAC_Initialize().
+  * @param  input           Pointer to the input data.
+  * @param  inputBitLen     The number of input bits (a multiple of 8).
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC_Update(KMAC_Instance* kmacInstance,
+                       const BitSequence* input,
+                       DataLength inputBitLen);
+
+/**
+  * Function to call after all the input has been given.
+  * If the output length given to KMAC_Initialize() was not 0, the tag is
+  * written to @a output; otherwise the output must be extracted using
+  * KMAC_Squeeze().
+  * @param  kmacInstance    Pointer to the instance initialized by
+  *                         KMAC_Initialize().
+  * @param  output          Pointer to the buffer where to store the tag.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC_Final(KMAC_Instance* kmacInstance, BitSequence* output);
+
+/**
+  * Function to squeeze KMACXOF output data.
+  * @param  kmacInstance    Pointer to the instance initialized by
+  *                         KMAC_Initialize() with an output length of 0.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputBitLen    The number of output bits (a multiple of 8).
+  * @pre    KMAC_Final() must have been already called.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC_Squeeze(KMAC_Instance* kmacInstance,
+                        BitSequence* output,
+                        DataLength outputBitLen);
+
+/**
+  * One-shot KMAC function using a precomputed key.
+  * @param  keyInstance     Pointer to a precomputed key.
+  * @param  input           Pointer to the input message X.
+  * @param  inputBitLen     The length of X in bits (a multiple of 8).
+  * @param  output          Pointer to the buffer where to store the tag.
+  * @param  outputBitLen    The number of output bits L (a multiple of 8).
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC_WithKey(const KMAC_KeyInstance* keyInstance,
+                        const BitSequence* input,
+                        DataLength inputBitLen,
+                        BitSequence* output,
+                        DataLength outputBitLen);
+
+/**
+  * One-shot KMAC128 function.
+  * @param  key             Pointer to the key K.
+  * @param  keyBitLen       The length of the key in bits.
+  * @param  input           Pointer to the input message X.
+  * @param  inputBitLen     The length of X in bits (a multiple of 8).
+  * @param  output          Pointer to the buffer where to store the tag.
+  * @param  outputBitLen    The number of output bits L (a multiple of 8).
+  * @param  customization   Pointer to the customization string S.
+  * @param  customBitLen    The length of the customization string in bits.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn KMAC128(const BitSequence* key,
+                   DataLength keyBitLen,
+                   const BitSequence* input,
+                   DataLength inputBitLen,
+                   BitSequence* output,
+                   DataLength outputBitLen,
+                   const BitSequence* customization,
+                   DataLength customBitLen);
+
+/**
+  * One-shot KMAC256 function.
+  * See KMAC128() for the parameters.
+  */
+HashReturn KMAC256(const BitSequence* key,
+                   DataLength keyBitLen,
+                   const BitSequence* input,
+                   DataLength inputBitLen,
+                   BitSequence* output,
+                   DataLength outputBitLen,
+                   const BitSequence* customization,
+                   DataLength customBitLen);
+
+/* ---------------------------------------------------------------- */
+
+/**
+  * Structure that contains a ParallelHash computation in progress.
+  * The input is cut in blocks of @a blockLen bytes, the leaves, that are
+  * hashed independently into chaining values; whole groups of four leaves
+  * are hashed with KeccakF1600times4_* when a parallel permutation is
+  * available.
+  */
+typedef struct {
+  /** The final node, cSHAKE with N = "ParallelHash". */
+  cSHAKE_Instance finalNode;
+  /** The leaf currently being absorbed, if it is not complete yet. */
+  Keccak_HashInstance queueNode;
+  /** The block size B in bytes. */
+  unsigned long long blockLen;
+  /** The number of bytes already absorbed into @a queueNode. */
+  unsigned long long queueAbsorbedLen;
+  /** The number of leaves processed so far. */
+  unsigned long long leafCount;
+  /** The requested output length in bits, or 0 for ParallelHashXOF. */
+  DataLength outputBitLen;
+  /** If set to 0, in the absorbing phase; otherwise, in the squeezing phase. */
+  int squeezing;
+} ParallelHash_Instance;
+
+/**
+  * Function to initialize a ParallelHash128 instance.
+  * @param  phInstance      Pointer to the instance to be initialized.
+  * @param  blockByteLen    The block size B in bytes.
+  * @param  outputBitLen    The desired number of output bits,
+  *                         or 0 for ParallelHashXOF128.
+  * @param  customization   Pointer to the customization string S.
+  * @param  customBitLen    The length of the customization string in bits.
+  * @pre    @a blockByteLen > 0
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash128_Initialize(ParallelHash_Instance* phInstance,
+                                      unsigned long long blockByteLen,
+                                      DataLength outputBitLen,
+                                      const BitSequence* customization,
+                                      DataLength customBitLen);
+
+/**
+  * Function to initialize a ParallelHash256 instance.
+  * See ParallelHash128_Initialize() for the parameters.
+  */
+HashReturn ParallelHash256_Initialize(ParallelHash_Instance* phInstance,
+                                      unsigned long long blockByteLen,
+                                      DataLength outputBitLen,
+                                      const BitSequence* customization,
+                                      DataLength customBitLen);
+
+/**
+  * Function to give input data to be hashed.
+  * @param  phInstance      Pointer to the instance initialized by
+  *                         ParallelHash128_Initialize() or
+  *                         ParallelHash256_Initialize().
+  * @param  input           Pointer to the input data.
+  * @param  inputBitLen     The number of input bits (a multiple of 8).
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash_Update(ParallelHash_Instance* phInstance,
+                               const BitSequence* input,
+                               DataLength inputBitLen);
+
+/**
+  * Function to hash whole leaves into chaining values, independently of any
+  * instance. The leaves are consecutive blocks of @a blockByteLen bytes.
+  * This function has no side effect other than writing @a chainingValues,
+  * so a large input can be split in ranges of leaves that are processed
+  * concurrently, e.g., by different threads, before being given in order to
+  * ParallelHash_UpdateChainingValues().
+  * @param  phInstance      Pointer to an instance, only used to read the
+  *                         security strength and the block size.
+  * @param  input           Pointer to the first leaf.
+  * @param  leafCount       The number of leaves.
+  * @param  chainingValues  Pointer to the buffer where to store the
+  *                         chaining values, 32 bytes per leaf for
+  *                         ParallelHash128 and 64 bytes for ParallelHash256.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash_HashLeaves(const ParallelHash_Instance* phInstance,
+                                   const BitSequence* input,
+                                   unsigned long long leafCount,
+                                   BitSequence* chainingValues);
+
+/**
+  * Function to give chaining values computed by ParallelHash_HashLeaves(),
+  * in the order of the leaves they correspond to.
+  * @param  phInstance      Pointer to the instance.
+  * @param  chainingValues  Pointer to the chaining values.
+  * @param  leafCount       The number of chaining values.
+  * @pre    The input given so far through ParallelHash_Update(), if any,
+  *         must be a whole number of blocks.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash_UpdateChainingValues(
+    ParallelHash_Instance* phInstance,
+    const BitSequence* chainingValues,
+    unsigned long long leafCount);
+
+/**
+  * Function to call after all the input has been given.
+  * If the output length given to the initialization function was not 0,
+  * the digest is written to @a output; otherwise the output must be
+  * extracted using ParallelHash_Squeeze().
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash_Final(ParallelHash_Instance* phInstance,
+                              BitSequence* output);
+
+/**
+  * Function to squeeze ParallelHashXOF output data.
+  * @pre    ParallelHash_Final() must have been already called.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash_Squeeze(ParallelHash_Instance* phInstance,
+                                BitSequence* output,
+                                DataLength outputBitLen);
+
+/**
+  * One-shot ParallelHash128 function.
+  * @param  input           Pointer to the input message X.
+  * @param  inputBitLen     The length of X in bits (a multiple of 8).
+  * @param  blockByteLen    The block size B in bytes.
+  * @param  output          Pointer to the buffer where to store the output.
+  * @param  outputBitLen    The number of output bits L (a multiple of 8).
+  * @param  customization   Pointer to the customization string S.
+  * @param  customBitLen    The length of the customization string in bits.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn ParallelHash128(const BitSequence* input,
+                           DataLength inputBitLen,
+                           unsigned long long blockByteLen,
+                           BitSequence* output,
+                           DataLength outputBitLen,
+                           const BitSequence* customization,
+                           DataLength customBitLen);
+
+/**
+  * One-shot ParallelHash256 function.
+  * See ParallelHash128() for the parameters.
+  */
+HashReturn ParallelHash256(const BitSequence* input,
+                           DataLength inputBitLen,
+                           unsigned long long blockByteLen,
+                           BitSequence* output,
+                           DataLength outputBitLen,
+                           const BitSequence* customization,
+                           DataLength customBitLen);
+
+#endif
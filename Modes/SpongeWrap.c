@@ -0,0 +1,233 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/SpongeWrap.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// The last bits of σ, i.e., the frame bit followed by the delimiter
+#define SpongeWrap_frameBit0 0x02
+#define SpongeWrap_frameBit1 0x03
+
+// Pads the first byteLen bytes of the rate, which already hold the block,
+// with the given frame bit and applies the permutation. This is the second
+// half of a duplexing call whose input was added to the state directly.
+static void SpongeWrap_Duplex(SpongeWrap_Instance* instance,
+                              unsigned int byteLen,
+                              unsigned char frameBit) {
+  KeccakF1600_StateXORBytesInLane(instance->duplex.state,
+                                  byteLen / KeccakF_laneInBytes,
+                                  &frameBit,
+                                  byteLen % KeccakF_laneInBytes,
+                                  1);
+  KeccakF1600_StateComplementBit(instance->duplex.state,
+                                 instance->duplex.rate - 1);
+  KeccakF1600_StatePermute(instance->duplex.state);
+}
+
+// C = P ⊕ Z: the plaintext is added to the state, which then holds the
+// ciphertext, so that the next duplexing call absorbs P without another
+// pass.
+static void SpongeWrap_Encrypt(SpongeWrap_Instance* instance,
+                               const unsigned char* input,
+                               unsigned char* output,
+                               unsigned int byteLen) {
+  unsigned int laneCount = byteLen / KeccakF_laneInBytes;
+  unsigned int tail = byteLen % KeccakF_laneInBytes;
+  unsigned int offset = laneCount * KeccakF_laneInBytes;
+
+  KeccakF1600_StateXORLanes(instance->duplex.state, input, laneCount);
+  KeccakF1600_StateExtractLanes(instance->duplex.state, output, laneCount);
+  if (tail > 0) {
+    KeccakF1600_StateXORBytesInLane(
+        instance->duplex.state, laneCount, input + offset, 0, tail);
+    KeccakF1600_StateExtractBytesInLane(
+        instance->duplex.state, laneCount, output + offset, 0, tail);
+  }
+}
+
+// P = C ⊕ Z: since Z ⊕ P = C, the state is overwritten with the ciphertext,
+// which is kept aside while the plaintext may replace it in memory.
+static void SpongeWrap_Decrypt(SpongeWrap_Instance* instance,
+                               const unsigned char* input,
+                               unsigned char* output,
+                               unsigned int byteLen) {
+  unsigned char block[KeccakF_width / 8];
+  unsigned int laneCount = byteLen / KeccakF_laneInBytes;
+  unsigned int tail = byteLen % KeccakF_laneInBytes;
+  unsigned int offset = laneCount * KeccakF_laneInBytes;
+  unsigned int i;
+  unsigned char c;
+
+  KeccakF1600_StateExtractLanes(instance->duplex.state, block, laneCount);
+  if (tail > 0)
+    KeccakF1600_StateExtractBytesInLane(
+        instance->duplex.state, laneCount, block + offset, 0, tail);
+  for (i = 0; i < byteLen; i++) {
+    c = input[i];
+    output[i] = c ^ block[i];
+    block[i] = c;
+  }
+  KeccakF1600_StateOverwriteLanes(instance->duplex.state, block, laneCount);
+  if (tail > 0)
+    KeccakF1600_StateOverwriteBytesInLane(
+        instance->duplex.state, laneCount, block + offset, 0, tail);
+}
+
+// Absorbs data cut in blocks, the last one with its own frame bit.
+static void SpongeWrap_AbsorbBlocks(SpongeWrap_Instance* instance,
+                                    const unsigned char* data,
+                                    unsigned long long dataByteLen,
+                                    unsigned char frameBit,
+                                    unsigned char lastFrameBit) {
+  while (dataByteLen > instance->blockSize) {
+    Keccak_Duplexing(
+        &instance->duplex, data, instance->blockSize, 0, 0, frameBit);
+    data += instance->blockSize;
+    dataByteLen -= instance->blockSize;
+  }
+  Keccak_Duplexing(&instance->duplex,
+                   data,
+                   (unsigned int)dataByteLen,
+                   0,
+                   0,
+                   lastFrameBit);
+}
+
+// Processes the associated data and the message, leaving the first part of
+// the tag in the state.
+static void SpongeWrap_Process(SpongeWrap_Instance* instance,
+                               const unsigned char* AD,
+                               unsigned long long ADByteLen,
+                               const unsigned char* input,
+                               unsigned char* output,
+                               unsigned long long dataByteLen,
+                               int unwrap) {
+  unsigned int n;
+  int last;
+
+  SpongeWrap_AbsorbBlocks(
+      instance, AD, ADByteLen, SpongeWrap_frameBit0, SpongeWrap_frameBit1);
+  do {
+    n = instance->blockSize;
+    if (n > dataByteLen) n = (unsigned int)dataByteLen;
+    if (unwrap)
+      SpongeWrap_Decrypt(instance, input, output, n);
+    else
+      SpongeWrap_Encrypt(instance, input, output, n);
+    input += n;
+    output += n;
+    dataByteLen -= n;
+    last = (dataByteLen == 0);
+    SpongeWrap_Duplex(
+        instance, n, last ? SpongeWrap_frameBit0 : SpongeWrap_frameBit1);
+  } while (!last);
+}
+
+// Gets the tag, the first block from the state and then with blank
+// duplexing calls.
+static void SpongeWrap_Squeeze(SpongeWrap_Instance* instance,
+                               unsigned char* tag,
+                               unsigned int tagByteLen) {
+  unsigned int n = instance->blockSize;
+  unsigned int laneCount, tail;
+
+  if (n > tagByteLen) n = tagByteLen;
+  laneCount = n / KeccakF_laneInBytes;
+  tail = n % KeccakF_laneInBytes;
+  KeccakF1600_StateExtractLanes(instance->duplex.state, tag, laneCount);
+  if (tail > 0)
+    KeccakF1600_StateExtractBytesInLane(instance->duplex.state,
+                                        laneCount,
+                                        tag + laneCount * KeccakF_laneInBytes,
+                                        0,
+                                        tail);
+  tag += n;
+  tagByteLen -= n;
+  while (tagByteLen > 0) {
+    n = instance->blockSize;
+    if (n > tagByteLen) n = tagByteLen;
+    Keccak_Duplexing(&instance->duplex, 0, 0, tag, n, SpongeWrap_frameBit0);
+    tag += n;
+    tagByteLen -= n;
+  }
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn SpongeWrap_Initialize(SpongeWrap_Instance* instance,
+                                 unsigned int rate,
+                                 unsigned int capacity,
+                                 const unsigned char* key,
+                                 unsigned long long keyByteLen) {
+  if ((rate % 8) != 0) return FAIL;
+  if (rate < 16) return FAIL;
+  if (Keccak_DuplexInitialize(&instance->duplex, rate, capacity) != 0)
+    return FAIL;
+  // One frame bit and the two padding bits must fit after a block
+  instance->blockSize = (rate - 3) / 8;
+  SpongeWrap_AbsorbBlocks(
+      instance, key, keyByteLen, SpongeWrap_frameBit1, SpongeWrap_frameBit0);
+  return SUCCESS;
+}
+
+HashReturn SpongeWrap_Wrap(SpongeWrap_Instance* instance,
+                           const unsigned char* AD,
+                           unsigned long long ADByteLen,
+                           const unsigned char* input,
+                           unsigned char* output,
+                           unsigned long long dataByteLen,
+                           unsigned char* tag,
+                           unsigned int tagByteLen) {
+  SpongeWrap_Process(instance, AD, ADByteLen, input, output, dataByteLen, 0);
+  SpongeWrap_Squeeze(instance, tag, tagByteLen);
+  return SUCCESS;
+}
+
+HashReturn SpongeWrap_Unwrap(SpongeWrap_Instance* instance,
+                             const unsigned char* AD,
+                             unsigned long long ADByteLen,
+                             const unsigned char* input,
+                             unsigned char* output,
+                             unsigned long long dataByteLen,
+                             const unsigned char* tag,
+                             unsigned int tagByteLen) {
+  unsigned char tagPrime[KeccakF_width / 8];
+  unsigned char difference = 0;
+  unsigned int i, n;
+
+  SpongeWrap_Process(instance, AD, ADByteLen, input, output, dataByteLen, 1);
+  // The tag is computed and compared block by block, in constant time
+  n = instance->blockSize;
+  if (n > tagByteLen) n = tagByteLen;
+  SpongeWrap_Squeeze(instance, tagPrime, n);
+  for (i = 0; i < n; i++) difference |= tagPrime[i] ^ tag[i];
+  tag += n;
+  tagByteLen -= n;
+  while (tagByteLen > 0) {
+    n = instance->blockSize;
+    if (n > tagByteLen) n = tagByteLen;
+    Keccak_Duplexing(
+        &instance->duplex, 0, 0, tagPrime, n, SpongeWrap_frameBit0);
+    for (i = 0; i < n; i++) difference |= tagPrime[i] ^ tag[i];
+    tag += n;
+    tagByteLen -= n;
+  }
+  if (difference != 0) {
+    memset(output, 0, (size_t)dataByteLen);
+    return FAIL;
+  }
+  return SUCCESS;
+}
@@ -0,0 +1,105 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _SpongeWrap_h_
+#define _SpongeWrap_h_
+
+#include "Constructions/KeccakDuplex.h"
+#include "Modes/KeccakHash.h"
+
+/**
+  * SpongeWrap is an authenticated encryption mode on top of the duplex
+  * construction, here Duplex[Keccak-f[r+c], pad10*1, r]. The key, the
+  * associated data and the message are cut into blocks of ρ bytes, with ρ
+  * the largest whole number of bytes such that a block and its frame bit fit
+  * in one duplexing call. Each message block is encrypted with the output of
+  * the previous duplexing call, and the plaintext block is absorbed by the
+  * next one.
+  * Encryption and decryption work in place and go over the message once:
+  * the plaintext is XORed into the state, which then holds the ciphertext,
+  * and decryption overwrites the state with the ciphertext.
+  */
+
+/**
+  * Structure that contains a SpongeWrap session.
+  */
+typedef struct {
+  /** The underlying duplex object. */
+  Keccak_DuplexInstance duplex;
+  /** The block size ρ in bytes. */
+  unsigned int blockSize;
+} SpongeWrap_Instance;
+
+/**
+  * Function to start a SpongeWrap session with a key.
+  * @param  instance        Pointer to the instance to be initialized.
+  * @param  rate            The value of the rate r.
+  * @param  capacity        The value of the capacity c.
+  * @param  key             Pointer to the key.
+  * @param  keyByteLen      The length of the key in bytes.
+  * @pre    One must have r+c=1600, and r must be a multiple of 8 with
+  *         r ≥ 16.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn SpongeWrap_Initialize(SpongeWrap_Instance* instance,
+                                 unsigned int rate,
+                                 unsigned int capacity,
+                                 const unsigned char* key,
+                                 unsigned long long keyByteLen);
+
+/**
+  * Function to encrypt and authenticate a message with its associated data.
+  * @param  instance        Pointer to the instance.
+  * @param  AD              Pointer to the associated data.
+  * @param  ADByteLen       The length of the associated data in bytes.
+  * @param  input           Pointer to the plaintext.
+  * @param  output          Pointer to the buffer where to store the
+  *                         ciphertext. It may be equal to @a input.
+  * @param  dataByteLen     The length of the message in bytes.
+  * @param  tag             Pointer to the buffer where to store the tag.
+  * @param  tagByteLen      The length of the tag in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn SpongeWrap_Wrap(SpongeWrap_Instance* instance,
+                           const unsigned char* AD,
+                           unsigned long long ADByteLen,
+                           const unsigned char* input,
+                           unsigned char* output,
+                           unsigned long long dataByteLen,
+                           unsigned char* tag,
+                           unsigned int tagByteLen);
+
+/**
+  * Function to decrypt and check a message with its associated data.
+  * If the tag does not match, the output is cleared.
+  * @param  instance        Pointer to the instance.
+  * @param  AD              Pointer to the associated data.
+  * @param  ADByteLen       The length of the associated data in bytes.
+  * @param  input           Pointer to the ciphertext.
+  * @param  output          Pointer to the buffer where to store the
+  *                         plaintext. It may be equal to @a input.
+  * @param  dataByteLen     The length of the message in bytes.
+  * @param  tag             Pointer to the tag to check.
+  * @param  tagByteLen      The length of the tag in bytes.
+  * @return SUCCESS if the tag is valid, FAIL otherwise.
+  */
+HashReturn SpongeWrap_Unwrap(SpongeWrap_Instance* instance,
+                             const unsigned char* AD,
+                             unsigned long long ADByteLen,
+                             const unsigned char* input,
+                             unsigned char* output,
+                             unsigned long long dataByteLen,
+                             const unsigned char* tag,
+                             unsigned int tagByteLen);
+
+#endif
@@ -0,0 +1,193 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/Strobe.h"
+
+#include <string.h>
+
+/* ---------------------------------------------------------------- */
+
+// Pads the block with the position where the current operation began, as
+// STROBE does, and applies the permutation.
+static void Strobe_RunF(Strobe_Instance* instance) {
+  unsigned char padding[3];
+  unsigned int positions[3];
+  unsigned int i;
+
+  padding[0] = (unsigned char)instance->positionBegin;
+  positions[0] = instance->position;
+  padding[1] = 0x04;
+  positions[1] = instance->position + 1;
+  padding[2] = 0x80;
+  positions[2] = instance->blockSize + 1;
+  for (i = 0; i < 3; i++)
+    KeccakF1600_StateXORBytesInLane(instance->duplex.state,
+                                    positions[i] / KeccakF_laneInBytes,
+                                    padding + i,
+                                    positions[i] % KeccakF_laneInBytes,
+                                    1);
+  KeccakF1600_StatePermute(instance->duplex.state);
+  instance->position = 0;
+  instance->positionBegin = 0;
+}
+
+// Processes data one lane at a time, permuting only when the block is
+// full. The output is the input XORed with the state before it is
+// overwritten with the input if cBefore is set, the state after the input
+// is XORed into it if cAfter is set, and the input otherwise. A null input
+// stands for zeroes, and the output is discarded if null. Returns the OR of
+// all output bytes, which is zero if a MAC matches.
+static unsigned char Strobe_Duplex(Strobe_Instance* instance,
+                                   const unsigned char* input,
+                                   unsigned char* output,
+                                   unsigned long long length,
+                                   int cBefore,
+                                   int cAfter) {
+  unsigned char in[KeccakF_laneInBytes];
+  unsigned char out[KeccakF_laneInBytes];
+  unsigned char difference = 0;
+  unsigned int i;
+
+  while (length > 0) {
+    unsigned int lanePosition = instance->position / KeccakF_laneInBytes;
+    unsigned int offsetInLane = instance->position % KeccakF_laneInBytes;
+    unsigned int bytesInLane = KeccakF_laneInBytes - offsetInLane;
+    if (bytesInLane > instance->blockSize - instance->position)
+      bytesInLane = instance->blockSize - instance->position;
+    if (bytesInLane > length) bytesInLane = (unsigned int)length;
+
+    if (input != NULL)
+      memcpy(in, input, bytesInLane);
+    else
+      memset(in, 0, bytesInLane);
+    if (cBefore) {
+      memcpy(out, in, bytesInLane);
+      KeccakF1600_StateExtractAndXORBytesInLane(
+          instance->duplex.state, lanePosition, out, offsetInLane, bytesInLane);
+      KeccakF1600_StateOverwriteBytesInLane(
+          instance->duplex.state, lanePosition, in, offsetInLane, bytesInLane);
+    } else {
+      KeccakF1600_StateXORBytesInLane(
+          instance->duplex.state, lanePosition, in, offsetInLane, bytesInLane);
+      if (cAfter)
+        KeccakF1600_StateExtractBytesInLane(instance->duplex.state,
+                                            lanePosition,
+                                            out,
+                                            offsetInLane,
+                                            bytesInLane);
+      else
+        memcpy(out, in, bytesInLane);
+    }
+    for (i = 0; i < bytesInLane; i++)
+      difference |= out[i];
+
+    if (input != NULL) input += bytesInLane;
+    if (output != NULL) {
+      memcpy(output, out, bytesInLane);
+      output += bytesInLane;
+    }
+    length -= bytesInLane;
+    instance->position += bytesInLane;
+    if (instance->position == instance->blockSize) Strobe_RunF(instance);
+  }
+  return difference;
+}
+
+/* ---------------------------------------------------------------- */
+
+HashReturn Strobe_Initialize(Strobe_Instance* instance,
+                             unsigned int securityLevel,
+                             const unsigned char* protocol,
+                             unsigned int protocolByteLen) {
+  static const unsigned char version[] = "STROBEv1.0.2";
+  unsigned char block[6 + sizeof(version) - 1];
+  unsigned int rate;
+
+  if ((securityLevel != 128) && (securityLevel != 256)) return FAIL;
+  instance->blockSize = KeccakF_width / 8 - securityLevel / 4 - 2;
+  rate = (instance->blockSize + 2) * 8;
+  if (Keccak_DuplexInitialize(&instance->duplex, rate, KeccakF_width - rate) !=
+      0)
+    return FAIL;
+  // The first block is the cSHAKE-like encoding of the version
+  block[0] = 1;
+  block[1] = (unsigned char)(instance->blockSize + 2);
+  block[2] = 1;
+  block[3] = 0;
+  block[4] = 1;
+  block[5] = (sizeof(version) - 1) * 8;
+  memcpy(block + 6, version, sizeof(version) - 1);
+  instance->position = 0;
+  instance->positionBegin = 0;
+  instance->flags = 0;
+  instance->role = -1;
+  Strobe_Duplex(instance, block, NULL, sizeof(block), 0, 0);
+  KeccakF1600_StatePermute(instance->duplex.state);
+  instance->position = 0;
+  return Strobe_Operate(instance,
+                        Strobe_AD | Strobe_flagM,
+                        protocol,
+                        NULL,
+                        protocolByteLen,
+                        0);
+}
+
+HashReturn Strobe_Operate(Strobe_Instance* instance,
+                          unsigned int operation,
+                          const unsigned char* input,
+                          unsigned char* output,
+                          unsigned long long dataByteLen,
+                          int more) {
+  const unsigned int kind = operation & ~(unsigned int)Strobe_flagM;
+  const int cAfter =
+      (operation & (Strobe_flagC | Strobe_flagI | Strobe_flagT)) ==
+      (Strobe_flagC | Strobe_flagT);
+  const int cBefore = ((operation & Strobe_flagC) != 0) && !cAfter;
+  unsigned char difference;
+
+  if ((kind != Strobe_AD) && (kind != Strobe_KEY) && (kind != Strobe_PRF) &&
+      (kind != Strobe_sendCLR) && (kind != Strobe_recvCLR) &&
+      (kind != Strobe_sendENC) && (kind != Strobe_recvENC) &&
+      (kind != Strobe_sendMAC) && (kind != Strobe_recvMAC) &&
+      (kind != Strobe_RATCHET))
+    return FAIL;
+  if (more) {
+    if (operation != instance->flags) return FAIL;
+  } else {
+    unsigned char header[2];
+    header[0] = (unsigned char)instance->positionBegin;
+    header[1] = (unsigned char)operation;
+    // With the T flag, the I flag is relative to the role, so that both
+    // parties absorb the same flags
+    if ((operation & Strobe_flagT) != 0) {
+      if (instance->role < 0) instance->role = operation & Strobe_flagI;
+      header[1] ^= (unsigned char)instance->role;
+    }
+    instance->positionBegin = instance->position + 1;
+    instance->flags = operation;
+    Strobe_Duplex(instance, header, NULL, 2, 0, 0);
+    if (((operation & Strobe_flagC) != 0) && (instance->position != 0))
+      Strobe_RunF(instance);
+  }
+
+  if ((kind == Strobe_PRF) || (kind == Strobe_sendMAC) ||
+      (kind == Strobe_RATCHET))
+    input = NULL;
+  if ((kind != Strobe_PRF) && (kind != Strobe_sendENC) &&
+      (kind != Strobe_recvENC) && (kind != Strobe_sendMAC))
+    output = NULL;
+  difference =
+      Strobe_Duplex(instance, input, output, dataByteLen, cBefore, cAfter);
+  if ((kind == Strobe_recvMAC) && (difference != 0)) return FAIL;
+  return SUCCESS;
+}
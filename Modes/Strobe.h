@@ -0,0 +1,117 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _Strobe_h_
+#define _Strobe_h_
+
+#include "Constructions/KeccakDuplex.h"
+#include "Modes/KeccakHash.h"
+
+/**
+  * STROBE v1.0.2 is a framework for protocols built on a single duplex
+  * object, here on Keccak-f[1600]. The parties absorb everything they
+  * exchange into a transcript state, and use the same state to encrypt,
+  * authenticate and derive keys or challenges (e.g., in the Fiat-Shamir
+  * transform). Each operation begins by absorbing its flags, and the state
+  * is only permuted when a block of R bytes is full or when an operation
+  * with the C flag starts, so that a series of small operations costs far
+  * less than one permutation each.
+  */
+
+/** The flags that make up the operations. */
+#define Strobe_flagI 0x01
+#define Strobe_flagA 0x02
+#define Strobe_flagC 0x04
+#define Strobe_flagT 0x08
+#define Strobe_flagM 0x10
+#define Strobe_flagK 0x20
+
+/** The operations. Any of them can be combined with Strobe_flagM to make
+  * it a metadata operation, e.g., Strobe_AD|Strobe_flagM for meta-AD. */
+#define Strobe_AD (Strobe_flagA)
+#define Strobe_KEY (Strobe_flagA | Strobe_flagC)
+#define Strobe_PRF (Strobe_flagI | Strobe_flagA | Strobe_flagC)
+#define Strobe_sendCLR (Strobe_flagA | Strobe_flagT)
+#define Strobe_recvCLR (Strobe_flagI | Strobe_flagA | Strobe_flagT)
+#define Strobe_sendENC (Strobe_flagA | Strobe_flagC | Strobe_flagT)
+#define Strobe_recvENC \
+  (Strobe_flagI | Strobe_flagA | Strobe_flagC | Strobe_flagT)
+#define Strobe_sendMAC (Strobe_flagC | Strobe_flagT)
+#define Strobe_recvMAC (Strobe_flagI | Strobe_flagC | Strobe_flagT)
+#define Strobe_RATCHET (Strobe_flagC)
+
+/**
+  * Structure that contains a STROBE object.
+  */
+typedef struct {
+  /** The underlying duplex object, whose state is used directly with the
+    * padding of STROBE. */
+  Keccak_DuplexInstance duplex;
+  /** The block size R in bytes. */
+  unsigned int blockSize;
+  /** The position of the next byte in the block. */
+  unsigned int position;
+  /** The position where the current operation began in the block. */
+  unsigned int positionBegin;
+  /** The flags of the current operation. */
+  unsigned int flags;
+  /** The role in the protocol, i.e., the I flag of the first operation with
+    * the T flag, or -1 as long as it is undecided. */
+  int role;
+} Strobe_Instance;
+
+/**
+  * Function to initialize a STROBE object for a given protocol.
+  * @param  instance        Pointer to the instance to be initialized.
+  * @param  securityLevel   The security level in bits, 128 or 256.
+  * @param  protocol        Pointer to the name of the protocol.
+  * @param  protocolByteLen The length of the name in bytes.
+  * @return SUCCESS if successful, FAIL otherwise.
+  */
+HashReturn Strobe_Initialize(Strobe_Instance* instance,
+                             unsigned int securityLevel,
+                             const unsigned char* protocol,
+                             unsigned int protocolByteLen);
+
+/**
+  * Function to perform an operation, or to continue it with more data.
+  * @param  instance        Pointer to the instance.
+  * @param  operation       The operation, e.g., Strobe_KEY, possibly with
+  *                         Strobe_flagM.
+  * @param  input           Pointer to the input data: the data for
+  *                         Strobe_AD, Strobe_KEY, Strobe_sendCLR and
+  *                         Strobe_recvCLR, the plaintext for
+  *                         Strobe_sendENC, the ciphertext for
+  *                         Strobe_recvENC and the received MAC for
+  *                         Strobe_recvMAC. It is ignored by the other
+  *                         operations and can be null.
+  * @param  output          Pointer to the buffer where to store the output
+  *                         data: the ciphertext for Strobe_sendENC, the
+  *                         plaintext for Strobe_recvENC, the MAC for
+  *                         Strobe_sendMAC and the output of Strobe_PRF. It
+  *                         may be equal to @a input, and is ignored by the
+  *                         other operations.
+  * @param  dataByteLen     The length of the data in bytes.
+  * @param  more            If set, the data continues the previous
+  *                         operation, which must be the same.
+  * @return SUCCESS if successful, FAIL otherwise, including when a MAC
+  *         received with Strobe_recvMAC does not match.
+  */
+HashReturn Strobe_Operate(Strobe_Instance* instance,
+                          unsigned int operation,
+                          const unsigned char* input,
+                          unsigned char* output,
+                          unsigned long long dataByteLen,
+                          int more);
+
+#endif
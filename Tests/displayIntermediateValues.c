@@ -12,7 +12,7 @@ http://creativecommons.org/publicdomain/zero/1.0/
 */
 
 #include <stdio.h>
-#include "Tests/Tests.h"
+#include "Tests/tests.h"
 #include "KeccakF-1600/KeccakF-1600-interface.h"
 
 FILE* intermediateValueFile = 0;
@@ -89,7 +89,7 @@ void displayStateAs32bitWords(int level,
 
 void displayStateAs64bitWords(int level,
                               const char* text,
-                              const unsigned long long int* state) {
+                              const uint64_t* state) {
   unsigned int i;
 
   if ((intermediateValueFile) && (level <= displayLevel)) {
@@ -1,6 +1,7 @@
 #include "Constructions/KeccakDuplex.h"
 #include "Constructions/KeccakSponge.h"
 #include "KeccakF-1600/KeccakF-1600-interface.h"
+#include "Modes/Kravatte.h"
 #include "Tests/timing.h"
 #include "Tests/dotiming.h"
 
@@ -82,6 +83,16 @@ static inline uint32_t measureKeccakF1600_StateXORPermuteExtract_0_21(uint32_t d
   measureTimingEnd
 }
 
+static inline uint32_t measureKeccakP1600_StateXORPermuteExtract12rounds_21_0(
+    uint32_t dtMin) {
+  ALIGN unsigned char state[KeccakF_width / 8];
+  ALIGN unsigned char data[200];
+
+  measureTimingBegin KeccakP1600_StateXORPermuteExtract12rounds(
+      state, data, 21, 0, 0);
+  measureTimingEnd
+}
+
 static inline uint32_t measureKeccakAbsorb1000blocks(uint32_t dtMin) {
   Keccak_SpongeInstance sponge;
   ALIGN unsigned char data[1000 * 200];
@@ -101,6 +112,26 @@ static inline uint32_t measureKeccakSqueeze1000blocks(uint32_t dtMin) {
   measureTimingEnd
 }
 
+static inline uint32_t measureTurboSHAKE128Absorb1000blocks(uint32_t dtMin) {
+  Keccak_SpongeInstance sponge;
+  ALIGN unsigned char data[1000 * 200];
+
+  measureTimingBegin Keccak_SpongeInitializeWithRounds(&sponge, 1344, 256, 12);
+  Keccak_SpongeAbsorb(&sponge, data, 999 * 1344 / 8 + 1);
+  Keccak_SpongeAbsorbLastFewBits(&sponge, 0x1F);
+  measureTimingEnd
+}
+
+static inline uint32_t measureKravatteExpand1000blocks(uint32_t dtMin) {
+  Kravatte_Instance kv;
+  ALIGN unsigned char data[1000 * 200];
+
+  measureTimingBegin Kravatte_MaskDerivation(&kv, data, 32);
+  Kravatte_Compress(&kv, 0, 0, 1);
+  Kravatte_Expand(&kv, data, 1000 * 200);
+  measureTimingEnd
+}
+
 static inline uint32_t measureKeccakDuplexing1000blocks(uint32_t dtMin) {
   Keccak_DuplexInstance duplex;
   int j;
@@ -113,6 +144,35 @@ static inline uint32_t measureKeccakDuplexing1000blocks(uint32_t dtMin) {
   measureTimingEnd
 }
 
+static inline uint32_t measureKeccakDuplexingTimes4_1000blocks(
+    uint32_t dtMin) {
+  Keccak_DuplexInstance duplex[4];
+  Keccak_DuplexInstance* duplexPointers[4];
+  int j, k;
+  ALIGN unsigned char dataIn[4][200];
+  ALIGN unsigned char dataOut[4][200];
+  const unsigned char* dataInPointers[4];
+  unsigned char* dataOutPointers[4];
+  const unsigned int byteLen[4] = {1344 / 8, 1344 / 8, 1344 / 8, 1344 / 8};
+  const unsigned char delimitedSigmaEnd[4] = {0x03, 0x03, 0x03, 0x03};
+
+  for (k = 0; k < 4; k++) {
+    duplexPointers[k] = &duplex[k];
+    dataInPointers[k] = dataIn[k];
+    dataOutPointers[k] = dataOut[k];
+  }
+  measureTimingBegin for (k = 0; k < 4; k++)
+      Keccak_DuplexInitialize(&duplex[k], 1344 + 3, 256 - 3);
+  for (j = 0; j < 1000; j++)
+    Keccak_DuplexingTimes4(duplexPointers,
+                           dataInPointers,
+                           byteLen,
+                           dataOutPointers,
+                           byteLen,
+                           delimitedSigmaEnd);
+  measureTimingEnd
+}
+
 void doTiming(void) {
   uint32_t calibration;
   uint32_t measurement;
@@ -171,6 +231,14 @@ void doTiming(void) {
       measurement);
   printf("Cycles per byte for rate 1344: %f\n\n", measurement / 168.0);
 
+  measurement =
+      measureKeccakP1600_StateXORPermuteExtract12rounds_21_0(calibration);
+  printf(
+      "Cycles for KeccakP1600_StateXORPermuteExtract12rounds(state, data, 21, "
+      "0, 0): %d\n",
+      measurement);
+  printf("Cycles per byte for rate 1344: %f\n\n", measurement / 168.0);
+
   measurement = measureKeccakAbsorb1000blocks(calibration);
   printf(
       "Cycles for Keccak_SpongeInitialize, Absorb (1000 blocks) and "
@@ -181,8 +249,27 @@ void doTiming(void) {
   printf("Cycles for Keccak_SpongeInitialize and Squeeze (1000 blocks): %d\n\n",
          measurement);
 
+  measurement = measureTurboSHAKE128Absorb1000blocks(calibration);
+  printf(
+      "Cycles for TurboSHAKE128 Initialize, Absorb (1000 blocks) and "
+      "AbsorbLastFewBits: %d\n\n",
+      measurement);
+
+  measurement = measureKravatteExpand1000blocks(calibration);
+  printf(
+      "Cycles for Kravatte_MaskDerivation, Compress (empty) and Expand (1000 "
+      "blocks): %d\n",
+      measurement);
+  printf("Cycles per byte: %f\n\n", measurement / 200000.0);
+
   measurement = measureKeccakDuplexing1000blocks(calibration);
   printf(
       "Cycles for Keccak_DuplexInitialize and Duplexing (1000 blocks): %d\n\n",
       measurement);
+
+  measurement = measureKeccakDuplexingTimes4_1000blocks(calibration);
+  printf(
+      "Cycles for 4 x Keccak_DuplexInitialize and DuplexingTimes4 (1000 "
+      "blocks): %d\n\n",
+      measurement);
 }
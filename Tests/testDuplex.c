@@ -22,8 +22,9 @@ void testDuplexOneInstance(FILE* f, unsigned int rate, unsigned int capacity) {
   unsigned char acc[KeccakF_width / 8];
   unsigned char sigma[KeccakF_width / 8];
   unsigned char Z[KeccakF_width / 8];
+  unsigned char ZXOR[KeccakF_width / 8];
   unsigned int sigmaBitLength, ZByteLen, i;
-  Keccak_DuplexInstance duplex;
+  Keccak_DuplexInstance duplex, duplexXOR;
 
   // Acumulated test vector
   memset(acc, 0x00, sizeof(acc));
@@ -47,9 +48,29 @@ void testDuplexOneInstance(FILE* f, unsigned int rate, unsigned int capacity) {
       delimitedSigmaEnd = 0x01;
 
     memset(Z, filler, sizeof(Z));
+    duplexXOR = duplex;
     Keccak_Duplexing(
         &duplex, sigma, sigmaBitLength / 8, Z, ZByteLen, delimitedSigmaEnd);
 
+    // Same output, XORed into a buffer
+    for (i = 0; i < sizeof(ZXOR); i++)
+      ZXOR[i] = (unsigned char)(0x95 + 13 * i);
+    Keccak_DuplexingXOR(&duplexXOR,
+                        sigma,
+                        sigmaBitLength / 8,
+                        ZXOR,
+                        ZByteLen,
+                        delimitedSigmaEnd);
+    for (i = 0; i < sizeof(ZXOR); i++) {
+      unsigned char expected = (unsigned char)(0x95 + 13 * i);
+      if (i < ZByteLen) expected ^= Z[i];
+      if ((ZXOR[i] != expected) ||
+          (memcmp(duplexXOR.state, duplex.state, sizeof(duplex.state)) != 0)) {
+        printf("Keccak_DuplexingXOR() differs!\n");
+        abort();
+      }
+    }
+
     for (i = 0; i < ZByteLen; i++)
       acc[i] ^= Z[i];
     for (i = ZByteLen; i < sizeof(Z); i++)
@@ -81,6 +102,118 @@ void testDuplexOneInstance(FILE* f, unsigned int rate, unsigned int capacity) {
   fprintf(f, "\n\n");
 }
 
+// Checks that a duplexing call with its input and output given in fragments
+// gives the same output and state as the same call in one piece.
+void testDuplexStreaming(unsigned int rate);
+void testDuplexStreaming(unsigned int rate) {
+  unsigned char sigma[KeccakF_width / 8];
+  unsigned char Z[KeccakF_width / 8];
+  unsigned char ZStreamed[KeccakF_width / 8];
+  unsigned int maxSigmaByteLen = (rate - 2) / 8;
+  unsigned int maxZByteLen = (rate + 7) / 8;
+  unsigned int call, sigmaByteLen, ZByteLen, fed, got, i;
+  Keccak_DuplexInstance duplex, duplexStreamed;
+
+  Keccak_DuplexInitialize(&duplex, rate, 1600 - rate);
+  Keccak_DuplexInitialize(&duplexStreamed, rate, 1600 - rate);
+  for (call = 0; call < 50; call++) {
+    sigmaByteLen = (call * 37) % (maxSigmaByteLen + 1);
+    ZByteLen = (call * 53) % (maxZByteLen + 1);
+    for (i = 0; i < sigmaByteLen; i++)
+      sigma[i] = (unsigned char)(call + 3 * i);
+    Keccak_Duplexing(&duplex, sigma, sigmaByteLen, Z, ZByteLen, 0x01);
+
+    // Input in fragments of call%7+1 bytes, the rest in the duplexing call
+    for (fed = 0; fed + call % 7 + 1 < sigmaByteLen; fed += call % 7 + 1)
+      Keccak_DuplexingFeedPartialInput(
+          &duplexStreamed, sigma + fed, call % 7 + 1);
+    // Output in the duplexing call up to the middle, then in fragments, the
+    // last one XORed into a buffer of zeroes
+    got = ZByteLen / 2;
+    memset(ZStreamed, 0, sizeof(ZStreamed));
+    Keccak_Duplexing(&duplexStreamed,
+                     sigma + fed,
+                     sigmaByteLen - fed,
+                     ZStreamed,
+                     got,
+                     0x01);
+    for (; got + call % 5 + 1 < ZByteLen; got += call % 5 + 1)
+      Keccak_DuplexingGetFurtherOutput(
+          &duplexStreamed, ZStreamed + got, call % 5 + 1);
+    Keccak_DuplexingGetFurtherOutputAndXOR(
+        &duplexStreamed, ZStreamed + got, ZByteLen - got);
+
+    if ((memcmp(Z, ZStreamed, ZByteLen) != 0) ||
+        (memcmp(duplex.state, duplexStreamed.state, sizeof(duplex.state)) !=
+         0)) {
+      printf("Streaming duplex differs for r=%u!\n", rate);
+      abort();
+    }
+  }
+}
+
+void testDuplexTimes4(void);
+void testDuplexTimes4(void) {
+  const unsigned int rates[4] = {5, 1027, 1344, 1597};
+  unsigned char sigma[4][KeccakF_width / 8];
+  unsigned char Z[4][KeccakF_width / 8];
+  unsigned char ZTimes4[4][KeccakF_width / 8];
+  const unsigned char* sigmaPointers[4];
+  unsigned char* ZPointers[4];
+  unsigned int sigmaByteLen[4], ZByteLen[4];
+  unsigned char delimitedSigmaEnd[4];
+  Keccak_DuplexInstance duplex[4], duplexTimes4[4];
+  Keccak_DuplexInstance* duplexPointers[4];
+  unsigned int call, j, i, fed;
+
+  for (j = 0; j < 4; j++) {
+    Keccak_DuplexInitialize(&duplex[j], rates[j], 1600 - rates[j]);
+    Keccak_DuplexInitialize(&duplexTimes4[j], rates[j], 1600 - rates[j]);
+    sigmaPointers[j] = sigma[j];
+    ZPointers[j] = ZTimes4[j];
+    duplexPointers[j] = &duplexTimes4[j];
+  }
+  for (call = 0; call < 50; call++) {
+    for (j = 0; j < 4; j++) {
+      sigmaByteLen[j] = (call * 37 + j * 11) % ((rates[j] - 2) / 8 + 1);
+      ZByteLen[j] = (call * 53 + j * 29) % ((rates[j] + 7) / 8 + 1);
+      delimitedSigmaEnd[j] = (sigmaByteLen[j] * 8 + 1 < rates[j] - 2)
+                                 ? (unsigned char)(0x02 + (call + j) % 2)
+                                 : 0x01;
+      for (i = 0; i < sigmaByteLen[j]; i++)
+        sigma[j][i] = (unsigned char)(call + 5 * i + 17 * j);
+      Keccak_Duplexing(&duplex[j],
+                       sigma[j],
+                       sigmaByteLen[j],
+                       Z[j],
+                       ZByteLen[j],
+                       delimitedSigmaEnd[j]);
+    }
+    // The first instance receives part of its input beforehand
+    fed = sigmaByteLen[0] / 2;
+    Keccak_DuplexingFeedPartialInput(&duplexTimes4[0], sigma[0], fed);
+    sigmaPointers[0] = sigma[0] + fed;
+    sigmaByteLen[0] -= fed;
+    if (Keccak_DuplexingTimes4(duplexPointers,
+                               sigmaPointers,
+                               sigmaByteLen,
+                               ZPointers,
+                               ZByteLen,
+                               delimitedSigmaEnd) != 0) {
+      printf("Keccak_DuplexingTimes4() failed!\n");
+      abort();
+    }
+    for (j = 0; j < 4; j++)
+      if ((memcmp(Z[j], ZTimes4[j], ZByteLen[j]) != 0) ||
+          (memcmp(duplex[j].state,
+                  duplexTimes4[j].state,
+                  sizeof(duplex[j].state)) != 0)) {
+        printf("Keccak_DuplexingTimes4() differs for r=%u!\n", rates[j]);
+        abort();
+      }
+  }
+}
+
 void testDuplex(void) {
   FILE* f;
   unsigned int rate;
@@ -90,4 +223,9 @@ void testDuplex(void) {
        rate += (rate < 68) ? 1 : ((rate < 220) ? 5 : 25))
     testDuplexOneInstance(f, rate, 1600 - rate);
   fclose(f);
+
+  testDuplexStreaming(5);
+  testDuplexStreaming(1027);
+  testDuplexStreaming(1344);
+  testDuplexTimes4();
 }
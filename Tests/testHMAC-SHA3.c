@@ -0,0 +1,123 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/HMAC-SHA3.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The expected tags below were computed with Python's hmac and hashlib
+// modules, with the key ptn(n), the pattern 00 01 02 .. F9 FA 00 01 ..
+// truncated to n bytes, and the message 01 04 07 .. (3i+1 mod 256).
+
+typedef struct {
+  unsigned int hashbitlen;
+  unsigned int keyByteLen;
+  unsigned int messageByteLen;
+  const char* tag;
+} HMACTestVector;
+
+static const HMACTestVector vectors[] = {
+    {224,
+     28,
+     34,
+     "\x90\x5C\xCB\x81\xE3\xF5\x21\xEF\xA8\x3C\xD2\xDE\xF9\x8F\xEA\x7F"
+     "\x7A\x8D\x2B\xB8\xDF\x5A\xAB\x9D\x2D\x7C\x84\x77"},
+    {256,
+     32,
+     0,
+     "\x50\xAB\x16\x06\x03\x43\x83\xFE\x4B\x3B\x4B\xC0\xA3\x41\xA8\x2E"
+     "\x40\xAC\x85\xE4\x55\xCD\xFE\xED\x4C\xAC\x90\x2A\x7B\x8C\xCF\xC1"},
+    // Key longer than the block, hashed first
+    {256,
+     200,
+     300,
+     "\x14\x7D\xF2\x46\x88\x82\x69\xF8\xB7\xB9\x94\xAF\x0E\x90\xFC\xCC"
+     "\xE1\x37\x72\xED\xEE\xA4\xB5\xBD\xA3\x09\x26\x07\xA1\xC9\xD6\x1B"},
+    {384,
+     104,
+     100,
+     "\x7C\xF7\xF8\x00\x1F\xBC\xA1\x01\x22\x89\x72\xA8\x55\x83\xB8\x94"
+     "\x8B\x1E\x09\xB6\x15\x1F\x6C\x79\x91\x92\x77\x26\x20\xF8\x85\x1E"
+     "\xE2\x5D\xA1\xB1\x5E\x01\xC2\x8F\xBE\x0D\xD8\xD4\x7E\x99\x2B\x0F"},
+    {512,
+     20,
+     1000,
+     "\x4E\x63\x08\xCD\xAF\x5D\xA2\xD9\xC2\x82\xB3\x26\xE7\xE9\xAD\x44"
+     "\x58\x53\x7B\x0C\x16\xB9\xE5\x2A\x0A\x98\x06\xB3\x49\x51\x1D\xFF"
+     "\xAF\x9F\xD3\x63\xC3\x87\x35\xF2\xAF\xD7\x00\xF6\xF2\x38\xE2\x95"
+     "\x73\xF0\x0C\x24\x35\x08\x85\x29\xBF\xE2\xB3\x10\x2C\xB6\x9F\xF5"},
+    // Key of exactly one block
+    {512,
+     72,
+     72,
+     "\x14\x28\xBB\x46\x04\x45\x18\xEB\x7B\x4D\xE4\x1C\xA4\xC0\x14\x7B"
+     "\x0B\xF6\x40\x6B\x88\x13\x08\x13\x18\xAA\x43\xF2\x6D\xA3\x90\xC7"
+     "\xE5\xDB\x27\xBA\x2D\x3C\xBA\x17\x56\xAA\x74\x0C\x9E\x05\xD6\xB7"
+     "\xDA\x09\x38\xAA\xA7\x78\x4A\x02\x92\x0F\xF8\x96\x80\x33\x56\xA7"}};
+
+static void checkTag(const HMACTestVector* vector, const unsigned char* tag) {
+  char text[32];
+
+  sprintf(text, "HMAC-SHA3-%u", vector->hashbitlen);
+  checkOutput(text, tag, vector->tag, vector->hashbitlen / 8);
+}
+
+void testHMAC_SHA3(void) {
+  unsigned char key[200];
+  unsigned char message[1000];
+  unsigned char tag[64];
+  HMAC_SHA3_KeyInstance keyInstance;
+  HMAC_SHA3_Instance hmac;
+  unsigned int v, i, offset, length;
+
+  ptn(key, sizeof(key));
+  for (i = 0; i < sizeof(message); i++)
+    message[i] = (unsigned char)(3 * i + 1);
+
+  for (v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+    const HMACTestVector* vector = &vectors[v];
+
+    memset(tag, 0, sizeof(tag));
+    HMAC_SHA3(vector->hashbitlen,
+              key,
+              vector->keyByteLen * 8,
+              message,
+              vector->messageByteLen * 8,
+              tag);
+    checkTag(vector, tag);
+
+    // The same key instance, used twice, with the message in pieces
+    HMAC_SHA3_KeyInitialize(
+        &keyInstance, vector->hashbitlen, key, vector->keyByteLen * 8);
+    for (i = 0; i < 2; i++) {
+      memset(tag, 0, sizeof(tag));
+      HMAC_SHA3_Initialize(&hmac, &keyInstance);
+      for (offset = 0; offset < vector->messageByteLen; offset += length) {
+        length = (offset + i) % 97 + 1;
+        if (length > vector->messageByteLen - offset)
+          length = vector->messageByteLen - offset;
+        HMAC_SHA3_Update(&hmac, message + offset, length * 8);
+      }
+      HMAC_SHA3_Final(&hmac, tag);
+      checkTag(vector, tag);
+    }
+  }
+
+  if (HMAC_SHA3_KeyInitialize(&keyInstance, 128, key, 128) != FAIL) {
+    printf("HMAC-SHA3 accepts an invalid output length!\n");
+    abort();
+  }
+}
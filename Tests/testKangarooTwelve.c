@@ -0,0 +1,164 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KangarooTwelve.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The KangarooTwelve test vectors below are from its specification, with
+// ptn(n) the pattern 00 01 02 .. F9 FA 00 01 .. truncated to n bytes. Those
+// of MarsupilamiFourteen use the same inputs.
+
+static unsigned char buffer[83521];
+
+void testKangarooTwelve(void) {
+  unsigned char output[32];
+  unsigned char chainingValues[10 * KangarooTwelve_chainingValueSize];
+  unsigned char M[7];
+  KangarooTwelve_Instance kt;
+
+  KangarooTwelve(0, 0, output, 32, 0, 0);
+  checkOutput("KangarooTwelve(M=empty, C=empty)",
+              output,
+              "\x1A\xC2\xD4\x50\xFC\x3B\x42\x05\xD1\x9D\xA7\xBF\xCA\x1B\x37\x51"
+              "\x3C\x08\x03\x57\x7A\xC7\x16\x7F\x06\xFE\x2C\xE1\xF0\xEF\x39\xE5",
+              32);
+
+  // Last 32 bytes of a 10032-byte output
+  KangarooTwelve_Initialize(&kt, 0);
+  KangarooTwelve_Final(&kt, 0, 0, 0);
+  KangarooTwelve_Squeeze(&kt, buffer, 10000);
+  KangarooTwelve_Squeeze(&kt, output, 32);
+  checkOutput("KangarooTwelve(M=empty, C=empty), 10032 bytes",
+              output,
+              "\xE8\xDC\x56\x36\x42\xF7\x22\x8C\x84\x68\x4C\x89\x84\x05\xD3\xA8"
+              "\x34\x79\x91\x58\xC0\x79\xB1\x28\x80\x27\x7A\x1D\x28\xE2\xFF\x6D",
+              32);
+
+  ptn(buffer, sizeof(buffer));
+  KangarooTwelve(buffer, 4913, output, 32, 0, 0);
+  checkOutput("KangarooTwelve(M=ptn(17^3), C=empty)",
+              output,
+              "\xCB\x55\x2E\x2E\xC7\x7D\x99\x10\x70\x1D\x57\x8B\x45\x7D\xDF\x77"
+              "\x2C\x12\xE3\x22\xE4\xEE\x7F\xE4\x17\xF9\x2C\x75\x8F\x0D\x59\xD0",
+              32);
+
+  // 11 chunks, given in pieces that do not follow chunk boundaries
+  KangarooTwelve_Initialize(&kt, 32);
+  KangarooTwelve_Update(&kt, buffer, 100);
+  KangarooTwelve_Update(&kt, buffer + 100, 8192);
+  KangarooTwelve_Update(&kt, buffer + 8292, 83521 - 8292);
+  KangarooTwelve_Final(&kt, output, 0, 0);
+  checkOutput("KangarooTwelve(M=ptn(17^4), C=empty)",
+              output,
+              "\x87\x01\x04\x5E\x22\x20\x53\x45\xFF\x4D\xDA\x05\x55\x5C\xBB\x5C"
+              "\x3A\xF1\xA7\x71\xC2\xB8\x9B\xAE\xF3\x7D\xB4\x3D\x99\x98\xB9\xFE",
+              32);
+
+  // Same, with the chunks after the first one hashed outside the instance
+  KangarooTwelve_Initialize(&kt, 32);
+  KangarooTwelve_Update(&kt, buffer, KangarooTwelve_chunkSize);
+  KangarooTwelve_HashChunks(
+      buffer + KangarooTwelve_chunkSize, 3, chainingValues);
+  KangarooTwelve_HashChunks(buffer + 4 * KangarooTwelve_chunkSize,
+                            6,
+                            chainingValues + 3 * 32);
+  KangarooTwelve_UpdateChainingValues(&kt, chainingValues, 9);
+  KangarooTwelve_Update(&kt,
+                        buffer + 10 * KangarooTwelve_chunkSize,
+                        83521 - 10 * KangarooTwelve_chunkSize);
+  KangarooTwelve_Final(&kt, output, 0, 0);
+  checkOutput("KangarooTwelve(M=ptn(17^4), C=empty), external chunks",
+              output,
+              "\x87\x01\x04\x5E\x22\x20\x53\x45\xFF\x4D\xDA\x05\x55\x5C\xBB\x5C"
+              "\x3A\xF1\xA7\x71\xC2\xB8\x9B\xAE\xF3\x7D\xB4\x3D\x99\x98\xB9\xFE",
+              32);
+
+  // A customization string spanning several chunks
+  memset(M, 0xFF, sizeof(M));
+  KangarooTwelve(M, 7, output, 32, buffer, 68921);
+  checkOutput("KangarooTwelve(M=7 bytes 0xFF, C=ptn(41^3))",
+              output,
+              "\x75\xD2\xF8\x6A\x2E\x64\x45\x66\x72\x6B\x4F\xBC\xFC\x56\x57\xB9"
+              "\xDB\xCF\x07\x0C\x7B\x0D\xCA\x06\x45\x0A\xB2\x91\xD7\x44\x3B\xCF",
+              32);
+}
+
+void testMarsupilamiFourteen(void) {
+  unsigned char output[64];
+  unsigned char chainingValues[10 * MarsupilamiFourteen_chainingValueSize];
+  unsigned char M[7];
+  MarsupilamiFourteen_Instance mf;
+
+  MarsupilamiFourteen(0, 0, output, 64, 0, 0);
+  checkOutput("MarsupilamiFourteen(M=empty, C=empty)",
+              output,
+              "\x6F\x66\xEF\x14\x74\xEB\x53\x80\x7A\xA3\x29\x25\x7C\x76\x8B\xB8"
+              "\x88\x93\xD9\xF0\x86\xE5\x1D\xA2\xF5\xC8\x0D\x17\xCA\x0F\xC5\x7D"
+              "\x5A\x24\xFA\xC8\x79\x01\x4F\x8B\x30\xA3\xFD\xF5\xAC\x56\xEB\xAF"
+              "\xA2\x19\xEB\x89\x1D\x4B\xBB\xAB\x7E\x1D\xF3\xB2\x72\x05\xB4\x59",
+              64);
+
+  ptn(buffer, sizeof(buffer));
+  MarsupilamiFourteen(buffer, 4913, output, 64, 0, 0);
+  checkOutput("MarsupilamiFourteen(M=ptn(17^3), C=empty)",
+              output,
+              "\x0A\xC8\x9B\x11\xA0\x6F\x46\xB2\xF6\xFE\xEF\xF0\x46\xC9\x7E\x90"
+              "\xDC\x02\x91\x0A\xE5\x09\xB8\x73\x9C\xFE\xA5\xDF\x1D\xF9\x0B\x82"
+              "\x89\x5A\x5F\xAD\x67\xAD\x2F\xA4\x12\x59\x09\x07\x56\xC0\xD9\x88"
+              "\x44\x0F\xA3\x26\x7A\x48\x38\x0A\xDA\x5D\xF9\xC7\xF0\x29\x07\x57",
+              64);
+
+  MarsupilamiFourteen_Initialize(&mf, 64);
+  MarsupilamiFourteen_Update(&mf, buffer, 100);
+  MarsupilamiFourteen_Update(&mf, buffer + 100, 83521 - 100);
+  MarsupilamiFourteen_Final(&mf, output, 0, 0);
+  checkOutput("MarsupilamiFourteen(M=ptn(17^4), C=empty)",
+              output,
+              "\x35\xAF\x0A\x5F\xC6\xC4\xD1\x11\xFB\xC6\x8F\x87\x9D\x05\x50\x6A"
+              "\xAF\xD3\x00\xB5\xAB\x13\x69\x86\xD7\xAE\xD8\xA9\xF1\xBE\x33\x1E"
+              "\x86\x64\x38\x18\x64\x67\x2E\x81\xBA\x32\xD8\x28\xB2\xC0\x51\x92"
+              "\xA5\x88\x68\x46\xF6\xC7\x57\x0E\x7E\xBA\xEB\x97\xB5\x9B\xD7\x3E",
+              64);
+
+  // Same, with the chunks after the first one hashed outside the instance
+  MarsupilamiFourteen_Initialize(&mf, 64);
+  MarsupilamiFourteen_Update(&mf, buffer, KangarooTwelve_chunkSize);
+  MarsupilamiFourteen_HashChunks(
+      buffer + KangarooTwelve_chunkSize, 9, chainingValues);
+  MarsupilamiFourteen_UpdateChainingValues(&mf, chainingValues, 9);
+  MarsupilamiFourteen_Update(&mf,
+                             buffer + 10 * KangarooTwelve_chunkSize,
+                             83521 - 10 * KangarooTwelve_chunkSize);
+  MarsupilamiFourteen_Final(&mf, output, 0, 0);
+  checkOutput("MarsupilamiFourteen(M=ptn(17^4), C=empty), external chunks",
+              output,
+              "\x35\xAF\x0A\x5F\xC6\xC4\xD1\x11\xFB\xC6\x8F\x87\x9D\x05\x50\x6A"
+              "\xAF\xD3\x00\xB5\xAB\x13\x69\x86\xD7\xAE\xD8\xA9\xF1\xBE\x33\x1E"
+              "\x86\x64\x38\x18\x64\x67\x2E\x81\xBA\x32\xD8\x28\xB2\xC0\x51\x92"
+              "\xA5\x88\x68\x46\xF6\xC7\x57\x0E\x7E\xBA\xEB\x97\xB5\x9B\xD7\x3E",
+              64);
+
+  memset(M, 0xFF, sizeof(M));
+  MarsupilamiFourteen(M, 7, output, 64, buffer, 68921);
+  checkOutput("MarsupilamiFourteen(M=7 bytes 0xFF, C=ptn(41^3))",
+              output,
+              "\x61\x58\x3C\xDF\xAA\x64\xAB\x60\xE7\x7B\x8C\x8B\xDD\x0A\xD0\x88"
+              "\xF9\xD7\x60\xB2\x94\x4F\x7D\x64\xC5\xDD\x81\xCE\x7E\x92\xD9\x6B"
+              "\xFF\x67\x84\x3A\x1E\xED\x51\xF3\x01\xDB\x51\xFF\x54\xFD\xCD\x44"
+              "\x62\xFD\x05\x14\x25\xD4\xC2\xED\xBA\x74\xAC\x2B\x15\x32\xEC\x14",
+              64);
+}
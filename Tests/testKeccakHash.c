@@ -0,0 +1,188 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KeccakHash.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define messageByteLen 2000
+
+// Hashes the message in fragments of 1 to 16 bytes, with a few longer
+// ones, and compares with hashing it in one call.
+static void testBufferedHashOne(const Keccak_HashInstance* initialized,
+                                const unsigned char* message) {
+  Keccak_HashInstance hash = *initialized;
+  Keccak_BufferedHashInstance buffered;
+  unsigned char expected[64];
+  unsigned char output[64];
+  unsigned int outputByteLen = (initialized->fixedOutputLength == 0)
+                                   ? sizeof(output)
+                                   : initialized->fixedOutputLength / 8;
+  unsigned int offset, length;
+
+  Keccak_HashUpdate(&hash, message, messageByteLen * 8);
+  Keccak_HashFinal(&hash, expected);
+  if (hash.fixedOutputLength == 0)
+    Keccak_HashSqueeze(&hash, expected, sizeof(expected) * 8);
+
+  Keccak_BufferedHashInitialize(&buffered, initialized);
+  for (offset = 0; offset < messageByteLen; offset += length) {
+    length = (offset % 23 == 0) ? 300 : offset % 16 + 1;
+    if (length > messageByteLen - offset) length = messageByteLen - offset;
+    Keccak_BufferedHashUpdate(&buffered, message + offset, length);
+  }
+  Keccak_BufferedHashFinal(&buffered, output);
+  if (buffered.hash.fixedOutputLength == 0)
+    Keccak_HashSqueeze(&buffered.hash, output, sizeof(output) * 8);
+
+  if (memcmp(output, expected, outputByteLen) != 0) {
+    printf("Keccak_BufferedHashUpdate() differs!\n");
+    abort();
+  }
+}
+
+#define fragmentCount 64
+
+// Hashes the message given as a list of fragments of various lengths,
+// including empty ones and ones longer than a block, and compares with
+// hashing it in one call.
+static void testHashUpdateIovOne(const Keccak_HashInstance* initialized,
+                                 const unsigned char* message) {
+  Keccak_HashInstance hash = *initialized;
+  Keccak_Iovec fragments[fragmentCount];
+  unsigned char expected[64];
+  unsigned char output[64];
+  unsigned int outputByteLen = (initialized->fixedOutputLength == 0)
+                                   ? sizeof(output)
+                                   : initialized->fixedOutputLength / 8;
+  unsigned int offset = 0, i;
+
+  Keccak_HashUpdate(&hash, message, messageByteLen * 8);
+  Keccak_HashFinal(&hash, expected);
+  if (hash.fixedOutputLength == 0)
+    Keccak_HashSqueeze(&hash, expected, sizeof(expected) * 8);
+
+  for (i = 0; i < fragmentCount; i++) {
+    unsigned int length = (i % 5 == 0) ? 0 : (i % 7 == 0) ? 400 : i * 3;
+    if (i == fragmentCount - 1) length = messageByteLen;
+    if (length > messageByteLen - offset) length = messageByteLen - offset;
+    fragments[i].data = message + offset;
+    fragments[i].dataByteLen = length;
+    offset += length;
+  }
+  hash = *initialized;
+  Keccak_HashUpdateIov(&hash, fragments, fragmentCount);
+  Keccak_HashFinal(&hash, output);
+  if (hash.fixedOutputLength == 0)
+    Keccak_HashSqueeze(&hash, output, sizeof(output) * 8);
+
+  if (memcmp(output, expected, outputByteLen) != 0) {
+    printf("Keccak_HashUpdateIov() differs!\n");
+    abort();
+  }
+}
+
+#define streamByteLen 3000
+
+// Reads the output of the hash instance with a mix of integer reads and
+// reads of various lengths, and compares with squeezing it in one call.
+static void testXOFReaderOne(const Keccak_HashInstance* finalized) {
+  Keccak_HashInstance hash = *finalized;
+  Keccak_XOFReader reader;
+  unsigned char expected[streamByteLen];
+  unsigned char stream[streamByteLen];
+  unsigned int offset, length, i;
+  uint64_t value;
+
+  Keccak_HashSqueeze(&hash, expected, streamByteLen * 8);
+
+  Keccak_XOFReaderInitialize(&reader, finalized);
+  for (offset = 0; offset + 1000 <= streamByteLen; offset += length) {
+    length = 1 << (offset % 4);
+    if (offset % 9 == 0) length = (offset % 7 == 0) ? 1000 : offset % 13 + 3;
+    switch (length) {
+      case 1:
+        value = Keccak_XOFReaderRead8(&reader);
+        break;
+      case 2:
+        value = Keccak_XOFReaderRead16(&reader);
+        break;
+      case 4:
+        value = Keccak_XOFReaderRead32(&reader);
+        break;
+      case 8:
+        value = Keccak_XOFReaderRead64(&reader);
+        break;
+      default:
+        Keccak_XOFReaderRead(&reader, stream + offset, length);
+        continue;
+    }
+    for (i = 0; i < length; i++)
+      stream[offset + i] = (unsigned char)(value >> (8 * i));
+  }
+  Keccak_XOFReaderRead(&reader, stream + offset, streamByteLen - offset);
+
+  if (memcmp(stream, expected, streamByteLen) != 0) {
+    printf("Keccak_XOFReader differs!\n");
+    abort();
+  }
+}
+
+void testKeccakHash(void) {
+  unsigned char message[messageByteLen];
+  Keccak_HashInstance hash;
+  Keccak_BufferedHashInstance buffered;
+  unsigned int i;
+
+  for (i = 0; i < messageByteLen; i++)
+    message[i] = (unsigned char)(i * 7 + 1);
+
+  Keccak_HashInitialize_SHA3_256(&hash);
+  testBufferedHashOne(&hash, message);
+  testHashUpdateIovOne(&hash, message);
+  Keccak_HashInitialize_SHA3_512(&hash);
+  testBufferedHashOne(&hash, message);
+  testHashUpdateIovOne(&hash, message);
+  Keccak_HashInitialize_SHAKE128(&hash);
+  testBufferedHashOne(&hash, message);
+  testHashUpdateIovOne(&hash, message);
+  Keccak_HashInitialize_TurboSHAKE256(&hash, 0x07);
+  testBufferedHashOne(&hash, message);
+  testHashUpdateIovOne(&hash, message);
+  // Starting after a whole block
+  Keccak_HashInitialize_SHA3_224(&hash);
+  Keccak_HashUpdate(&hash, message, 144 * 8);
+  testBufferedHashOne(&hash, message);
+
+  // Not on a block boundary
+  Keccak_HashUpdate(&hash, message, 8);
+  testHashUpdateIovOne(&hash, message);
+  if (Keccak_BufferedHashInitialize(&buffered, &hash) != FAIL) {
+    printf("Keccak_BufferedHashInitialize() accepts a partial block!\n");
+    abort();
+  }
+
+  Keccak_HashInitialize_SHAKE128(&hash);
+  Keccak_HashUpdate(&hash, message, 100 * 8);
+  Keccak_HashFinal(&hash, 0);
+  testXOFReaderOne(&hash);
+  // Starting after some output was squeezed
+  Keccak_HashSqueeze(&hash, message, 5 * 8);
+  testXOFReaderOne(&hash);
+  Keccak_HashInitialize_TurboSHAKE256(&hash, 0x1F);
+  Keccak_HashFinal(&hash, 0);
+  testXOFReaderOne(&hash);
+}
@@ -0,0 +1,89 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakHashChain.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define chainCount 7
+#define prefixByteLen 64
+#define indexOffset 60
+#define valueByteLen 32
+
+// Iterates one chain with a hash instance per step.
+static void referenceChain(unsigned char* value,
+                           const unsigned char* prefix,
+                           uint32_t start,
+                           unsigned int steps) {
+  unsigned char block[prefixByteLen];
+  Keccak_HashInstance hash;
+  unsigned int step;
+
+  memcpy(block, prefix, prefixByteLen);
+  for (step = 0; step < steps; step++) {
+    uint32_t index = start + step;
+    block[indexOffset] = (unsigned char)(index >> 24);
+    block[indexOffset + 1] = (unsigned char)(index >> 16);
+    block[indexOffset + 2] = (unsigned char)(index >> 8);
+    block[indexOffset + 3] = (unsigned char)index;
+    Keccak_HashInitialize_SHAKE256(&hash);
+    Keccak_HashUpdate(&hash, block, prefixByteLen * 8);
+    Keccak_HashUpdate(&hash, value, valueByteLen * 8);
+    Keccak_HashFinal(&hash, 0);
+    Keccak_HashSqueeze(&hash, value, valueByteLen * 8);
+  }
+}
+
+void testKeccakHashChain(void) {
+  // The first bytes of the values of the first two chains at their end
+  static const unsigned char expected[2][8] = {
+      {0x4a, 0xc8, 0x73, 0xe6, 0x99, 0x3f, 0x52, 0xf7},
+      {0x5f, 0xb8, 0x59, 0x42, 0x2e, 0x64, 0x83, 0x76}};
+  unsigned char prefixes[chainCount][prefixByteLen];
+  unsigned char values[chainCount][valueByteLen];
+  unsigned char referenceValues[chainCount][valueByteLen];
+  KeccakHashChain chains[chainCount];
+  unsigned int c, j;
+
+  // Four chains in parallel and three alone, with various numbers of steps
+  for (c = 0; c < chainCount; c++) {
+    for (j = 0; j < prefixByteLen; j++)
+      prefixes[c][j] = (unsigned char)(j * 3 + c);
+    for (j = 0; j < valueByteLen; j++)
+      values[c][j] = (unsigned char)(j + 5 * c);
+    memcpy(referenceValues[c], values[c], valueByteLen);
+    chains[c].value = values[c];
+    chains[c].prefix = prefixes[c];
+    chains[c].start = c;
+    chains[c].steps = (c * 5 + 7) % 16;
+    referenceChain(
+        referenceValues[c], prefixes[c], chains[c].start, chains[c].steps);
+  }
+  KeccakHashChain_Iterate(
+      chains, chainCount, prefixByteLen, indexOffset, valueByteLen);
+  if ((memcmp(values, referenceValues, sizeof(values)) != 0) ||
+      (memcmp(values[0], expected[0], 8) != 0) ||
+      (memcmp(values[1], expected[1], 8) != 0)) {
+    printf("KeccakHashChain_Iterate() differs!\n");
+    abort();
+  }
+
+  if (KeccakHashChain_Iterate(chains, chainCount, 64, 61, 32) != FAIL) {
+    printf("KeccakHashChain_Iterate() accepts an index out of the prefix!\n");
+    abort();
+  }
+}
@@ -0,0 +1,177 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakHashToField.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define messageCount 7
+#define elementByteLen 56
+
+// The expand_message_xof vectors of RFC 9380, Appendix K.6, and two more.
+static void testExpandMessage(void) {
+  static const unsigned char expectedEmpty[32] = {
+      0x86, 0x51, 0x8c, 0x9c, 0xd8, 0x65, 0x81, 0x48, 0x6e, 0x94, 0x85,
+      0xaa, 0x74, 0xab, 0x35, 0xba, 0x15, 0x0d, 0x1c, 0x75, 0xc8, 0x8e,
+      0x26, 0xb7, 0x04, 0x3e, 0x44, 0xe2, 0xac, 0xd7, 0x35, 0xa2};
+  static const unsigned char expectedABC[32] = {
+      0x86, 0x96, 0xaf, 0x52, 0xa4, 0xd8, 0x62, 0x41, 0x7c, 0x07, 0x63,
+      0x55, 0x60, 0x73, 0xf4, 0x7b, 0xc9, 0xb9, 0xba, 0x43, 0xc9, 0x9b,
+      0x50, 0x53, 0x05, 0xcb, 0x1e, 0xc0, 0x4a, 0x9a, 0xb4, 0x68};
+  static const unsigned char expectedABC256[32] = {
+      0xb3, 0x9e, 0x49, 0x38, 0x67, 0xe2, 0x76, 0x72, 0x16, 0x79, 0x2a,
+      0xbc, 0xe1, 0xf2, 0x67, 0x6c, 0x19, 0x7c, 0x06, 0x92, 0xae, 0xd0,
+      0x61, 0x56, 0x0e, 0xad, 0x25, 0x18, 0x21, 0x80, 0x8e, 0x07};
+  static const unsigned char expectedOversize[32] = {
+      0xa0, 0xdc, 0x44, 0x76, 0x72, 0xb0, 0xc4, 0x67, 0xec, 0xdf, 0x5b,
+      0x56, 0x2a, 0xf8, 0xee, 0x0f, 0x15, 0xa2, 0x16, 0x46, 0xed, 0x9c,
+      0x2d, 0x2b, 0x10, 0xf8, 0x92, 0x87, 0x44, 0x26, 0xad, 0x2e};
+  static const unsigned char dummyModulus[1] = {0xFB};
+  const char* DST128 = "QUUX-V01-CS02-with-expander-SHAKE128";
+  const char* DST256 = "QUUX-V01-CS02-with-expander-SHAKE256";
+  unsigned char longDST[300];
+  unsigned char output[32];
+  KeccakHashToField_Instance instance;
+
+  KeccakHashToField_Initialize(&instance,
+                               128,
+                               dummyModulus,
+                               1,
+                               1,
+                               (const unsigned char*)DST128,
+                               strlen(DST128));
+  KeccakHashToField_ExpandMessage(&instance, 0, 0, output, 32);
+  checkOutput("expand_message_xof(\"\")", output, expectedEmpty, 32);
+  KeccakHashToField_ExpandMessage(
+      &instance, (const unsigned char*)"abc", 3, output, 32);
+  checkOutput("expand_message_xof(\"abc\")", output, expectedABC, 32);
+
+  KeccakHashToField_Initialize(&instance,
+                               256,
+                               dummyModulus,
+                               1,
+                               1,
+                               (const unsigned char*)DST256,
+                               strlen(DST256));
+  KeccakHashToField_ExpandMessage(
+      &instance, (const unsigned char*)"abc", 3, output, 32);
+  checkOutput("expand_message_xof with SHAKE256", output, expectedABC256, 32);
+
+  memset(longDST, 'x', sizeof(longDST));
+  KeccakHashToField_Initialize(
+      &instance, 128, dummyModulus, 1, 1, longDST, sizeof(longDST));
+  KeccakHashToField_ExpandMessage(
+      &instance, (const unsigned char*)"abc", 3, output, 32);
+  checkOutput("expand_message_xof with a long DST",
+              output,
+              expectedOversize,
+              32);
+}
+
+void testKeccakHashToField(void) {
+  // The first elements of the first and last messages, mod p448
+  static const unsigned char expectedFirst[elementByteLen] = {
+      0x08, 0x47, 0xc5, 0xeb, 0xf9, 0x57, 0xd3, 0x37, 0x0b, 0x1f, 0x98, 0xfd,
+      0xe4, 0x99, 0xfb, 0x3e, 0x65, 0x99, 0x96, 0xd9, 0xfc, 0x9b, 0x57, 0x07,
+      0x17, 0x6a, 0xde, 0x78, 0x5b, 0xa7, 0x2c, 0xd8, 0x4b, 0x8a, 0x55, 0x97,
+      0xc1, 0x2b, 0x10, 0x24, 0xbe, 0x5f, 0x51, 0x0f, 0xa5, 0xba, 0x99, 0x64,
+      0x2c, 0x4c, 0xec, 0x7f, 0x3f, 0x69, 0xd3, 0xe7};
+  static const unsigned char expectedLast[elementByteLen] = {
+      0xcd, 0xba, 0xcd, 0x98, 0xe6, 0x91, 0xe7, 0xf0, 0x11, 0x59, 0xeb, 0x2c,
+      0x16, 0xfb, 0xbc, 0x2b, 0xff, 0x37, 0xe9, 0x97, 0x82, 0xb2, 0x29, 0xb5,
+      0xec, 0xb0, 0x4d, 0xc2, 0x2b, 0x54, 0xaa, 0xf7, 0x00, 0x33, 0xef, 0x1c,
+      0x28, 0x59, 0x07, 0x23, 0x1d, 0x3e, 0x12, 0xe1, 0xed, 0xba, 0x63, 0x55,
+      0xcf, 0xe1, 0x98, 0xe2, 0xab, 0x55, 0x06, 0x7a};
+  // Two elements of GF(65537^2), with p given on 4 bytes
+  static const unsigned char expectedSmall[16] = {
+      0x00, 0x00, 0x77, 0x23, 0x00, 0x00, 0xb1, 0x13,
+      0x00, 0x00, 0xff, 0x1a, 0x00, 0x00, 0xee, 0x0a};
+  static const unsigned char modulusSmall[4] = {0x00, 0x01, 0x00, 0x01};
+  static const unsigned long long messageByteLens[messageCount] = {
+      0, 1, 170, 3, 400, 136, 50};
+  const char* DST = "QUUX-V01-CS02-with-edwards448_XOF:SHAKE256_ELL2_RO_";
+  static unsigned char messageBytes[messageCount][400];
+  const unsigned char* messages[messageCount];
+  unsigned char modulus[elementByteLen];
+  unsigned char elements[messageCount][2 * elementByteLen];
+  unsigned char element[2 * elementByteLen];
+  unsigned char expanded[4][300];
+  unsigned char single[300];
+  unsigned char* outputs[4];
+  KeccakHashToField_Instance instance;
+  unsigned int i, j;
+
+  testExpandMessage();
+
+  // p448 = 2^448 - 2^224 - 1
+  memset(modulus, 0xFF, elementByteLen);
+  modulus[27] = 0xFE;
+  for (i = 0; i < messageCount; i++) {
+    for (j = 0; j < messageByteLens[i]; j++)
+      messageBytes[i][j] = (unsigned char)(j * 31 + i);
+    messages[i] = messageBytes[i];
+  }
+  KeccakHashToField_Initialize(&instance,
+                               224,
+                               modulus,
+                               elementByteLen,
+                               1,
+                               (const unsigned char*)DST,
+                               strlen(DST));
+
+  // Four messages of different lengths expanded in parallel
+  for (i = 0; i < 4; i++)
+    outputs[i] = expanded[i];
+  KeccakHashToField_ExpandMessageTimes4(
+      &instance, messages + 2, messageByteLens + 2, outputs, 300);
+  for (i = 0; i < 4; i++) {
+    KeccakHashToField_ExpandMessage(
+        &instance, messages[2 + i], messageByteLens[2 + i], single, 300);
+    checkOutput("expand_message_xof of four messages",
+                expanded[i],
+                single,
+                300);
+  }
+
+  // Four messages in parallel and three alone
+  KeccakHashToField_HashToField(
+      &instance, messages, messageByteLens, messageCount, 2, elements[0]);
+  checkOutput("hash_to_field with p448",
+              elements[0],
+              expectedFirst,
+              elementByteLen);
+  checkOutput("hash_to_field with p448",
+              elements[6],
+              expectedLast,
+              elementByteLen);
+  for (i = 0; i < messageCount; i++) {
+    KeccakHashToField_HashToField(
+        &instance, messages + i, messageByteLens + i, 1, 2, element);
+    checkOutput("hash_to_field of a single message",
+                elements[i],
+                element,
+                2 * elementByteLen);
+  }
+
+  memset(single, 'x', sizeof(single));
+  KeccakHashToField_Initialize(
+      &instance, 128, modulusSmall, 4, 2, single, sizeof(single));
+  messages[0] = (const unsigned char*)"abc";
+  KeccakHashToField_HashToField(
+      &instance, messages, messageByteLens + 3, 1, 2, element);
+  checkOutput("hash_to_field in GF(p^2)", element, expectedSmall, 16);
+}
@@ -0,0 +1,106 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakMerkleTree.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define maxLeafCount 40
+#define maxLeafByteLen 300
+
+// Builds trees of 1 to maxLeafCount leaves incrementally and checks the root
+// after each leaf against the one computed level by level, whose leaves and
+// nodes are hashed four at a time.
+static void testMerkleTreeOne(const KeccakMerkleTree_Parameters* parameters,
+                              const unsigned char* leaves,
+                              unsigned int leafByteLen) {
+  unsigned char workspace[maxLeafCount * KeccakMerkleTree_nodeSize];
+  unsigned char expected[KeccakMerkleTree_nodeSize];
+  unsigned char root[KeccakMerkleTree_nodeSize];
+  KeccakMerkleTree_Instance tree;
+  unsigned int leafCount;
+
+  KeccakMerkleTree_Initialize(&tree, parameters);
+  for (leafCount = 1; leafCount <= maxLeafCount; leafCount++) {
+    KeccakMerkleTree_Append(
+        &tree, leaves + (leafCount - 1) * leafByteLen, leafByteLen);
+    KeccakMerkleTree_Root(&tree, root);
+    KeccakMerkleTree_ComputeRoot(
+        parameters, leaves, leafByteLen, leafCount, workspace, expected);
+    if (memcmp(root, expected, sizeof(root)) != 0) {
+      printf("KeccakMerkleTree_Root() differs with arity %u and %u leaves!\n",
+             parameters->arity,
+             leafCount);
+      abort();
+    }
+  }
+}
+
+void testKeccakMerkleTree(void) {
+  static const unsigned char expectedSHA3[KeccakMerkleTree_nodeSize] = {
+      0x56, 0x9f, 0x87, 0xcd, 0x9b, 0x1c, 0xb4, 0xc3, 0x9d, 0xc4, 0xa5,
+      0x24, 0xe8, 0xd7, 0x7a, 0x1a, 0x08, 0x27, 0xb5, 0xe1, 0xd6, 0xe6,
+      0xee, 0x7b, 0x17, 0xf7, 0x79, 0xf7, 0x69, 0x7e, 0x3e, 0xe2};
+  static const unsigned char expectedSHAKE[KeccakMerkleTree_nodeSize] = {
+      0x28, 0xaf, 0x07, 0xb0, 0x85, 0xd4, 0x94, 0x81, 0xa0, 0x1b, 0x99,
+      0xf2, 0xa9, 0x21, 0x31, 0x23, 0x7c, 0xc8, 0x2c, 0xae, 0x88, 0x20,
+      0xc4, 0xb1, 0x40, 0x78, 0xd3, 0x53, 0xdc, 0x12, 0x8d, 0xcb};
+  static unsigned char leaves[maxLeafCount * maxLeafByteLen];
+  unsigned char workspace[maxLeafCount * KeccakMerkleTree_nodeSize];
+  unsigned char root[KeccakMerkleTree_nodeSize];
+  KeccakMerkleTree_Parameters parameters;
+  unsigned int j, k;
+
+  // Leaf j of 20 bytes is (7j + k) for k = 0..19
+  for (j = 0; j < maxLeafCount; j++)
+    for (k = 0; k < 20; k++)
+      leaves[j * 20 + k] = (unsigned char)(j * 7 + k);
+  parameters.leafDomain = 0x00;
+  parameters.nodeDomain = 0x01;
+  parameters.arity = 3;
+  parameters.delimitedSuffix = KeccakMerkleTree_SHA3_256;
+  KeccakMerkleTree_ComputeRoot(&parameters, leaves, 20, 10, workspace, root);
+  if (memcmp(root, expectedSHA3, sizeof(root)) != 0) {
+    printf("KeccakMerkleTree_ComputeRoot() with SHA3-256 differs!\n");
+    abort();
+  }
+  parameters.arity = 2;
+  parameters.delimitedSuffix = KeccakMerkleTree_SHAKE256;
+  KeccakMerkleTree_ComputeRoot(&parameters, leaves, 20, 13, workspace, root);
+  if (memcmp(root, expectedSHAKE, sizeof(root)) != 0) {
+    printf("KeccakMerkleTree_ComputeRoot() with SHAKE256 differs!\n");
+    abort();
+  }
+
+  for (j = 0; j < sizeof(leaves); j++)
+    leaves[j] = (unsigned char)(j * 13 + 5);
+  for (parameters.arity = 2; parameters.arity <= KeccakMerkleTree_maxArity;
+       parameters.arity *= 2) {
+    testMerkleTreeOne(&parameters, leaves, 20);
+    testMerkleTreeOne(&parameters, leaves, maxLeafByteLen);
+  }
+  parameters.arity = 3;
+  parameters.delimitedSuffix = KeccakMerkleTree_SHA3_256;
+  testMerkleTreeOne(&parameters, leaves, 135);
+
+  parameters.arity = KeccakMerkleTree_maxArity + 1;
+  if (KeccakMerkleTree_ComputeRoot(
+          &parameters, leaves, 20, 10, workspace, root) != FAIL) {
+    printf("KeccakMerkleTree_ComputeRoot() accepts an invalid arity!\n");
+    abort();
+  }
+}
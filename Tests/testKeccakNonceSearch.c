@@ -0,0 +1,128 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakNonceSearch.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define maxNonceCount 200
+
+// Hashes the prefix followed by the nonce with a copy of the hash instance.
+static void referenceDigest(const Keccak_HashInstance* prefixed,
+                            uint64_t nonce,
+                            unsigned int nonceByteLen,
+                            unsigned char* digest,
+                            unsigned int digestByteLen) {
+  Keccak_HashInstance hash = *prefixed;
+  unsigned char nonceBytes[8];
+  unsigned char output[200];
+  unsigned int j;
+
+  for (j = 0; j < nonceByteLen; j++)
+    nonceBytes[j] = (unsigned char)(nonce >> (8 * j));
+  Keccak_HashUpdate(&hash, nonceBytes, nonceByteLen * 8);
+  Keccak_HashFinal(&hash, output);
+  if (hash.fixedOutputLength == 0)
+    Keccak_HashSqueeze(&hash, output, digestByteLen * 8);
+  memcpy(digest, output, digestByteLen);
+}
+
+// Searches a range of nonces and compares with checking each of them.
+static void testNonceSearchOne(const Keccak_HashInstance* prefixed,
+                               unsigned int nonceByteLen,
+                               const unsigned char* target,
+                               unsigned int targetByteLen,
+                               uint64_t firstNonce,
+                               unsigned int nonceCount,
+                               unsigned int maxFoundCount) {
+  KeccakNonceSearch_Instance search;
+  uint64_t expected[maxNonceCount];
+  uint64_t found[maxNonceCount];
+  unsigned char digest[KeccakNonceSearch_maxTargetByteLen];
+  unsigned int expectedCount = 0, foundCount, i;
+
+  for (i = 0; (i < nonceCount) && (expectedCount < maxFoundCount); i++) {
+    referenceDigest(prefixed, firstNonce + i, nonceByteLen, digest, 64);
+    if (memcmp(digest, target, targetByteLen) <= 0)
+      expected[expectedCount++] = firstNonce + i;
+  }
+  if ((KeccakNonceSearch_Initialize(
+           &search, prefixed, nonceByteLen, target, targetByteLen) !=
+       SUCCESS) ||
+      (KeccakNonceSearch_Search(&search,
+                                firstNonce,
+                                nonceCount,
+                                found,
+                                maxFoundCount,
+                                &foundCount) != SUCCESS) ||
+      (foundCount != expectedCount) ||
+      (memcmp(found, expected, foundCount * sizeof(uint64_t)) != 0)) {
+    printf("KeccakNonceSearch_Search() differs!\n");
+    abort();
+  }
+}
+
+void testKeccakNonceSearch(void) {
+  unsigned char prefix[400];
+  unsigned char target[KeccakNonceSearch_maxTargetByteLen];
+  Keccak_HashInstance hash;
+  KeccakNonceSearch_Instance search;
+  unsigned int i;
+
+  for (i = 0; i < sizeof(prefix); i++)
+    prefix[i] = (unsigned char)(i * 11 + 3);
+
+  // About one nonce in eight meets a one-byte target
+  target[0] = 0x20;
+  Keccak_HashInitialize_SHA3_256(&hash);
+  Keccak_HashUpdate(&hash, prefix, 100 * 8);
+  testNonceSearchOne(&hash, 4, target, 1, 1000, maxNonceCount, maxNonceCount);
+  testNonceSearchOne(&hash, 4, target, 1, 1000, 199, 3);
+  testNonceSearchOne(&hash, 4, target, 1, 1000, 3, maxNonceCount);
+
+  // Prefix of exactly one block, with 12 rounds
+  Keccak_HashInitialize_TurboSHAKE128(&hash, 0x1F);
+  Keccak_HashUpdate(&hash, prefix, 168 * 8);
+  target[0] = 0x10;
+  target[1] = 0x00;
+  testNonceSearchOne(&hash, 8, target, 2, 0, maxNonceCount, maxNonceCount);
+
+  // Targets longer than a lane, equal to a digest or just below it
+  Keccak_HashInitialize_SHAKE256(&hash);
+  Keccak_HashUpdate(&hash, prefix, 301 * 8);
+  referenceDigest(&hash, 7, 2, target, 12);
+  testNonceSearchOne(&hash, 2, target, 12, 0, 16, maxNonceCount);
+  for (i = 11; target[i] == 0; i--)
+    target[i] = 0xFF;
+  target[i]--;
+  testNonceSearchOne(&hash, 2, target, 12, 0, 16, maxNonceCount);
+
+  // The nonce does not fit in the block
+  Keccak_HashInitialize_SHA3_256(&hash);
+  Keccak_HashUpdate(&hash, prefix, 133 * 8);
+  if (KeccakNonceSearch_Initialize(&search, &hash, 3, target, 1) != FAIL) {
+    printf("KeccakNonceSearch_Initialize() accepts a nonce too long!\n");
+    abort();
+  }
+
+  // The target is longer than the digest of SHA3-256
+  Keccak_HashInitialize_SHA3_256(&hash);
+  if (KeccakNonceSearch_Initialize(&search, &hash, 4, target, 33) != FAIL) {
+    printf("KeccakNonceSearch_Initialize() accepts a target too long!\n");
+    abort();
+  }
+}
@@ -0,0 +1,140 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KeccakPRG.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define outputByteLen 1000
+
+// Fetches outputByteLen bytes in requests of varying sizes.
+static void fetchInPieces(KeccakPRG_Instance* prg,
+                          unsigned char* output,
+                          unsigned int step) {
+  unsigned int offset, length;
+
+  for (offset = 0; offset < outputByteLen; offset += length) {
+    length = (offset * 13 + step) % 411 + 1;
+    if (length > outputByteLen - offset) length = outputByteLen - offset;
+    KeccakPRG_Fetch(prg, output + offset, length);
+  }
+}
+
+// Expected output of KeccakPRG as a sequence of duplexing calls, after the
+// given seed was fed (with ρ < seedByteLen < 2ρ).
+static void expectedOutput(unsigned int capacity,
+                           const unsigned char* seed,
+                           unsigned int seedByteLen,
+                           int forget,
+                           unsigned char* output) {
+  Keccak_DuplexInstance duplex;
+  unsigned int rate = 1600 - capacity;
+  unsigned int blockSize = (rate - 2) / 8;
+  unsigned char Z[KeccakF_width / 8];
+  unsigned int offset, length;
+
+  Keccak_DuplexInitialize(&duplex, rate, capacity);
+  Keccak_Duplexing(&duplex, seed, blockSize, Z, 0, 0x01);
+  Keccak_Duplexing(&duplex,
+                   seed + blockSize,
+                   seedByteLen - blockSize,
+                   Z,
+                   capacity / 8,
+                   0x01);
+  if (forget) {
+    // Overwriting with zeroes is XORing the current value
+    for (offset = 0; offset < capacity / 8; offset++)
+      KeccakF1600_StateXORBytesInLane(duplex.state,
+                                      offset / KeccakF_laneInBytes,
+                                      Z + offset,
+                                      offset % KeccakF_laneInBytes,
+                                      1);
+    Keccak_Duplexing(&duplex, Z, 0, Z, blockSize, 0x01);
+  } else
+    Keccak_DuplexingGetFurtherOutput(
+        &duplex, Z + capacity / 8, blockSize - capacity / 8);
+  for (offset = 0; offset < outputByteLen; offset += length) {
+    length = blockSize;
+    if (length > outputByteLen - offset) length = outputByteLen - offset;
+    if (offset > 0) Keccak_Duplexing(&duplex, Z, 0, Z, blockSize, 0x01);
+    memcpy(output + offset, Z, length);
+  }
+}
+
+static void testKeccakPRGOneCapacity(unsigned int capacity) {
+  KeccakPRG_Instance prg, prgCopy;
+  unsigned char seed[400];
+  unsigned char output[outputByteLen];
+  unsigned char outputInPieces[outputByteLen];
+  unsigned char expected[outputByteLen];
+  unsigned int blockSize = (1600 - capacity - 2) / 8;
+  unsigned int seedByteLen = blockSize + blockSize / 3 + 1;
+  unsigned int i;
+
+  for (i = 0; i < sizeof(seed); i++)
+    seed[i] = (unsigned char)(i * 7 + capacity);
+
+  // Seed given in three parts, output in one request or in pieces
+  KeccakPRG_Initialize(&prg, capacity);
+  KeccakPRG_Feed(&prg, seed, 1);
+  KeccakPRG_Feed(&prg, seed + 1, blockSize / 2);
+  KeccakPRG_Feed(
+      &prg, seed + 1 + blockSize / 2, seedByteLen - 1 - blockSize / 2);
+  prgCopy = prg;
+  expectedOutput(capacity, seed, seedByteLen, 0, expected);
+  KeccakPRG_Fetch(&prg, output, outputByteLen);
+  checkOutput("KeccakPRG, single request", output, expected, outputByteLen);
+  fetchInPieces(&prgCopy, outputInPieces, capacity);
+  checkOutput("KeccakPRG, several requests",
+              outputInPieces,
+              expected,
+              outputByteLen);
+
+  // Seed given as one block and a remainder, then made irreversible
+  KeccakPRG_Initialize(&prg, capacity);
+  KeccakPRG_Feed(&prg, seed, seedByteLen);
+  if (KeccakPRG_Forget(&prg) != SUCCESS) {
+    printf("KeccakPRG_Forget() failed!\n");
+    abort();
+  }
+  expectedOutput(capacity, seed, seedByteLen, 1, expected);
+  fetchInPieces(&prg, output, capacity + 1);
+  checkOutput("KeccakPRG, after forgetting", output, expected, outputByteLen);
+
+  // Reseeding in the middle of a block starts a new block
+  KeccakPRG_Initialize(&prg, capacity);
+  KeccakPRG_Feed(&prg, seed, blockSize);
+  KeccakPRG_Fetch(&prg, output, 10);
+  KeccakPRG_Feed(&prg, seed + blockSize, seedByteLen - blockSize);
+  expectedOutput(capacity, seed, seedByteLen, 0, expected);
+  KeccakPRG_Fetch(&prg, output, outputByteLen);
+  checkOutput("KeccakPRG, after reseeding", output, expected, outputByteLen);
+}
+
+void testKeccakPRG(void) {
+  KeccakPRG_Instance prg;
+
+  testKeccakPRGOneCapacity(256);
+  testKeccakPRGOneCapacity(512);
+  testKeccakPRGOneCapacity(792);
+
+  if ((KeccakPRG_Initialize(&prg, 800) != SUCCESS) ||
+      (KeccakPRG_Forget(&prg) != FAIL) ||
+      (KeccakPRG_Initialize(&prg, 254) != FAIL)) {
+    printf("KeccakPRG accepts invalid parameters!\n");
+    abort();
+  }
+}
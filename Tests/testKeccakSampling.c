@@ -0,0 +1,151 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakSampling.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define polynomialSize KeccakSampling_coefficientCount
+
+// Samples one polynomial uniformly mod q from a single SHAKE128 stream,
+// squeezed 3 bytes at a time.
+static void referenceUniform(int32_t* coefficients,
+                             const unsigned char* seed,
+                             unsigned int seedByteLen,
+                             uint32_t q) {
+  Keccak_HashInstance hash;
+  unsigned char b[3];
+  unsigned int count = 0;
+
+  Keccak_HashInitialize_SHAKE128(&hash);
+  Keccak_HashUpdate(&hash, seed, seedByteLen * 8);
+  Keccak_HashFinal(&hash, 0);
+  while (count < polynomialSize) {
+    Keccak_HashSqueeze(&hash, b, 3 * 8);
+    if (q <= 4096) {
+      uint32_t d1 = b[0] | ((uint32_t)(b[1] & 0x0F) << 8);
+      uint32_t d2 = (b[1] >> 4) | ((uint32_t)b[2] << 4);
+      if (d1 < q) coefficients[count++] = (int32_t)d1;
+      if ((d2 < q) && (count < polynomialSize))
+        coefficients[count++] = (int32_t)d2;
+    } else {
+      uint32_t t =
+          b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)(b[2] & 0x7F) << 16);
+      if (t < q) coefficients[count++] = (int32_t)t;
+    }
+  }
+}
+
+// Samples one polynomial from the centered binomial distribution, taking the
+// bits of SHAKE256 one at a time.
+static void referenceCenteredBinomial(int32_t* coefficients,
+                                      const unsigned char* seed,
+                                      unsigned int seedByteLen,
+                                      unsigned int eta) {
+  Keccak_HashInstance hash;
+  unsigned char bytes[64 * 3];
+  unsigned int i, k;
+
+  Keccak_HashInitialize_SHAKE256(&hash);
+  Keccak_HashUpdate(&hash, seed, seedByteLen * 8);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, bytes, 64 * eta * 8);
+  for (i = 0; i < polynomialSize; i++) {
+    int32_t a = 0, b = 0;
+    for (k = 0; k < eta; k++) {
+      unsigned int x = 2 * eta * i + k, y = x + eta;
+      a += (bytes[x / 8] >> (x % 8)) & 1;
+      b += (bytes[y / 8] >> (y % 8)) & 1;
+    }
+    coefficients[i] = a - b;
+  }
+}
+
+// Checks the four sampled polynomials against the single-stream reference,
+// and the first coefficients of the first one against known values.
+static void checkPolynomials(int32_t polynomials[4][polynomialSize],
+                             int32_t* expected,
+                             const int32_t* firstCoefficients,
+                             unsigned int firstCount,
+                             const char* synopsis) {
+  if ((memcmp(polynomials,
+              expected,
+              4 * polynomialSize * sizeof(int32_t)) != 0) ||
+      (memcmp(polynomials[0],
+              firstCoefficients,
+              firstCount * sizeof(int32_t)) != 0)) {
+    printf("%s differs!\n", synopsis);
+    abort();
+  }
+}
+
+void testKeccakSampling(void) {
+  static const int32_t firstKyber[4] = {2512, 1187, 75, 2259};
+  static const int32_t firstDilithium[4] = {4864464, 864331, 5396563, 3834796};
+  static const int32_t firstEta2[8] = {-1, 0, 1, 1, -2, 1, 0, 0};
+  static const int32_t firstEta3[8] = {0, 2, 1, 1, 1, 0, 3, 0};
+  unsigned char seedBytes[4][34];
+  const unsigned char* seeds[4];
+  int32_t polynomials[4][polynomialSize];
+  int32_t expected[4][polynomialSize];
+  int32_t* coefficients[4];
+  unsigned int i, j;
+
+  // Seeds ρ || i || 1 for the matrix expansion, ρ || i for the noise
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 32; j++)
+      seedBytes[i][j] = (unsigned char)j;
+    seedBytes[i][32] = (unsigned char)i;
+    seedBytes[i][33] = 1;
+    seeds[i] = seedBytes[i];
+    coefficients[i] = polynomials[i];
+  }
+
+  KeccakSampling_UniformTimes4(coefficients, seeds, 34, 3329);
+  for (i = 0; i < 4; i++)
+    referenceUniform(expected[i], seeds[i], 34, 3329);
+  checkPolynomials(
+      polynomials, expected[0], firstKyber, 4, "Uniform sampling mod 3329");
+
+  KeccakSampling_UniformTimes4(coefficients, seeds, 34, 8380417);
+  for (i = 0; i < 4; i++)
+    referenceUniform(expected[i], seeds[i], 34, 8380417);
+  checkPolynomials(polynomials,
+                   expected[0],
+                   firstDilithium,
+                   4,
+                   "Uniform sampling mod 8380417");
+
+  KeccakSampling_CenteredBinomialTimes4(coefficients, seeds, 33, 2);
+  for (i = 0; i < 4; i++)
+    referenceCenteredBinomial(expected[i], seeds[i], 33, 2);
+  checkPolynomials(
+      polynomials, expected[0], firstEta2, 8, "Centered binomial sampling");
+
+  KeccakSampling_CenteredBinomialTimes4(coefficients, seeds, 33, 3);
+  for (i = 0; i < 4; i++)
+    referenceCenteredBinomial(expected[i], seeds[i], 33, 3);
+  checkPolynomials(
+      polynomials, expected[0], firstEta3, 8, "Centered binomial sampling");
+
+  if ((KeccakSampling_CenteredBinomialTimes4(coefficients, seeds, 33, 4) !=
+       FAIL) ||
+      (KeccakSampling_UniformTimes4(coefficients, seeds, 136, 3329) != FAIL)) {
+    printf("KeccakSampling accepts invalid parameters!\n");
+    abort();
+  }
+}
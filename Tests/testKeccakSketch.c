@@ -0,0 +1,91 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+
+#include "Modes/KeccakSketch.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define keyCount 11
+#define indexCount 20
+
+// Derives the indexes of a key from SHAKE128 through a hash instance.
+static void referenceIndexes(const unsigned char* key,
+                             unsigned long long keyByteLen,
+                             const uint32_t* ranges,
+                             uint32_t* indexes) {
+  Keccak_HashInstance hash;
+  unsigned char output[4];
+  unsigned int i;
+
+  Keccak_HashInitialize_SHAKE128(&hash);
+  Keccak_HashUpdate(&hash, key, keyByteLen * 8);
+  Keccak_HashFinal(&hash, 0);
+  for (i = 0; i < indexCount; i++) {
+    uint64_t word;
+    Keccak_HashSqueeze(&hash, output, 32);
+    word = output[0] | ((uint64_t)output[1] << 8) |
+           ((uint64_t)output[2] << 16) | ((uint64_t)output[3] << 24);
+    indexes[i] = (uint32_t)((word * ranges[i]) >> 32);
+  }
+}
+
+void testKeccakSketch(void) {
+  static const uint32_t expectedABC[10] = {
+      175, 362, 718, 42955, 1659554720, 2, 317195450, 2, 11720, 0};
+  static const uint32_t rangesABC[10] = {
+      1000, 1000, 1000, 65536, 0x80000000, 7, 1000000000, 3, 12345, 1};
+  // A key of several blocks among the others, to break a group of four
+  static const unsigned long long keyByteLens[keyCount] = {
+      0, 1, 16, 167, 32, 500, 8, 9, 10, 11, 12};
+  static unsigned char keyBytes[keyCount][500];
+  const unsigned char* keys[keyCount];
+  uint32_t ranges[indexCount];
+  uint32_t indexes[keyCount][indexCount];
+  uint32_t expected[keyCount][indexCount];
+  unsigned int i, j;
+
+  KeccakSketch_Indexes(
+      (const unsigned char*)"abc", 3, rangesABC, 10, indexes[0]);
+  if (memcmp(indexes[0], expectedABC, sizeof(expectedABC)) != 0) {
+    printf("KeccakSketch_Indexes() differs!\n");
+    abort();
+  }
+
+  for (i = 0; i < indexCount; i++)
+    ranges[i] = 1000 + 977 * i;
+  for (i = 0; i < keyCount; i++) {
+    for (j = 0; j < keyByteLens[i]; j++)
+      keyBytes[i][j] = (unsigned char)(j * 5 + i);
+    keys[i] = keyBytes[i];
+    referenceIndexes(keys[i], keyByteLens[i], ranges, expected[i]);
+  }
+  KeccakSketch_IndexesBatch(
+      keys, keyByteLens, keyCount, ranges, indexCount, indexes[0]);
+  if (memcmp(indexes, expected, sizeof(indexes)) != 0) {
+    printf("KeccakSketch_IndexesBatch() differs!\n");
+    abort();
+  }
+
+  if (KeccakSketch_Indexes(keys[0],
+                           0,
+                           ranges,
+                           KeccakSketch_maxIndexCount + 1,
+                           indexes[0]) != FAIL) {
+    printf("KeccakSketch_Indexes() accepts too many indexes!\n");
+    abort();
+  }
+}
@@ -0,0 +1,149 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/Keyak.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The test vectors below are printed by scripts/testVectors/keyak.py, a
+// Python model of the Motorist mode whose Keccak-p is checked against
+// hashlib's SHA-3. ptn(n) is the pattern 00 01 02 .. F9 FA 00 01 ..
+// truncated to n bytes. Each session starts with K=ptn(16), N=ptn(12) and a
+// tag, wraps I=ptn(1000) with A=ptn(300), then I=ptn(20) without AD.
+// The model and Modes/Keyak.c were both written from the Keyak v2
+// specification, so these vectors do not replace the Lake Keyak and Ocean
+// Keyak KAT of the designers, which is not part of this tree yet. A vector
+// of that KAT for each instance belongs here once it is.
+
+typedef struct {
+  unsigned int pistonCount;
+  const char* startTag;
+  const char* lastCiphertextBytes;
+  const char* tag1;
+  const char* tag2;
+} KeyakTestVector;
+
+static const KeyakTestVector vectors[] = {
+    {1,
+     "\x41\x64\x4E\x38\x36\x7E\x76\x4A\x71\x1A\xD5\xAC\x09\xAA\x8D\xB2",
+     "\xC0\x13\xD6\x9F\x80\x7E\x92\x82\x12\xCB\x3B\x43\xB1\x65\xEF\xE0",
+     "\x68\xD6\x93\x46\xB5\x87\xC7\x8E\x4D\x54\xF8\x69\x96\xDB\xED\x9A",
+     "\x66\x9F\x93\x4F\x6E\x24\x12\xE7\xBC\xD5\x5B\x5B\xC6\x83\x24\xB2",
+    },
+    {2,
+     "\x0C\x54\x0A\xD2\x88\x00\x74\xFB\x05\x3A\x83\x73\x5C\xFE\xF6\x47",
+     "\xD5\x6F\x9D\x0E\xF1\x04\xE2\x65\x1C\x5B\x6C\xDD\x21\x00\xC1\x96",
+     "\x7F\x54\x98\x8E\x88\x1C\x21\x5D\x6B\xD2\x9B\xA4\x2D\x37\x0D\x2B",
+     "\xD8\xD1\x08\xE2\x25\x3E\x32\x08\x10\x8C\x87\xAF\x29\xFA\x62\x8B",
+    },
+    {4,
+     "\xC0\x5B\x34\x78\x9E\xA3\x26\x4C\xBE\x55\x34\xDD\xF3\x86\xD9\x45",
+     "\x6E\x05\x48\x8F\xEC\x70\xCF\x5E\x79\xF8\x36\xAE\x4C\x10\xF3\x79",
+     "\x0A\x66\x84\x43\xC3\xEF\xE3\x7C\x15\xBD\x9B\x5D\x4C\x54\x64\x34",
+     "\xAE\x4B\xC2\xC6\x53\x8D\x0C\x86\xE5\x90\xBC\xCF\x3F\x96\x94\xD7",
+    },
+    {8,
+     "\x86\x1D\xB2\x48\x37\xF5\x49\x67\xFD\xD3\x69\x03\xAD\x7E\xEE\xCF",
+     "\x4C\x6F\x26\x06\x3B\x64\x5A\x57\x73\x6F\x01\x7A\x2A\x9F\x0B\x04",
+     "\x52\xAE\x16\xCD\x88\x03\x34\x79\xFA\x55\xC6\xF4\x1C\x31\x12\xF9",
+     "\x1D\xB9\x5C\x94\x41\xF8\x5D\x04\xE7\x7D\x65\x28\x07\x03\x08\x02",
+    },
+};
+
+static void checkTag(const char* what,
+                     unsigned int pistonCount,
+                     const unsigned char* output,
+                     const char* expected) {
+  char text[64];
+
+  sprintf(text, "Keyak with %u piston(s), %s", pistonCount, what);
+  checkOutput(text, output, expected, Keyak_tagSize);
+}
+
+static void testKeyakSession(const KeyakTestVector* v) {
+  unsigned char key[16], nonce[12], AD[300];
+  unsigned char plaintext[1000], ciphertext[1000], buffer[1000];
+  unsigned char tag[Keyak_tagSize];
+  Keyak_Instance keyak;
+
+  ptn(key, sizeof(key));
+  ptn(nonce, sizeof(nonce));
+  ptn(AD, sizeof(AD));
+  ptn(plaintext, sizeof(plaintext));
+
+  Keyak_Initialize(&keyak, v->pistonCount, key, 16, nonce, 12, 1, tag, 0, 0);
+  checkTag("start tag", v->pistonCount, tag, v->startTag);
+  Keyak_Wrap(&keyak, plaintext, ciphertext, 1000, AD, 300, tag, 0, 0);
+  checkTag(
+      "ciphertext", v->pistonCount, ciphertext + 984, v->lastCiphertextBytes);
+  checkTag("tag of the first message", v->pistonCount, tag, v->tag1);
+  Keyak_Wrap(&keyak, plaintext, buffer, 20, AD, 0, tag, 0, 0);
+  checkTag("tag of the second message", v->pistonCount, tag, v->tag2);
+
+  // Unwrapping in place gives the plaintext back
+  memcpy(buffer, ciphertext, sizeof(buffer));
+  memcpy(tag, v->startTag, Keyak_tagSize);
+  if (Keyak_Initialize(
+          &keyak, v->pistonCount, key, 16, nonce, 12, 1, tag, 1, 0) !=
+      SUCCESS) {
+    printf("Keyak with %u piston(s): start tag rejected!\n", v->pistonCount);
+    abort();
+  }
+  memcpy(tag, v->tag1, Keyak_tagSize);
+  if ((Keyak_Wrap(&keyak, buffer, buffer, 1000, AD, 300, tag, 1, 0) !=
+       SUCCESS) ||
+      (memcmp(buffer, plaintext, sizeof(buffer)) != 0)) {
+    printf("Keyak with %u piston(s): unwrap failed!\n", v->pistonCount);
+    abort();
+  }
+
+  // A modified ciphertext is rejected and its output cleared
+  memcpy(buffer, ciphertext, sizeof(buffer));
+  buffer[500] ^= 0x01;
+  Keyak_Initialize(&keyak, v->pistonCount, key, 16, nonce, 12, 0, 0, 0, 0);
+  memcpy(tag, v->tag1, Keyak_tagSize);
+  if ((Keyak_Wrap(&keyak, buffer, buffer, 1000, AD, 300, tag, 1, 0) !=
+       FAIL) ||
+      (buffer[0] != 0) ||
+      (Keyak_Wrap(&keyak, buffer, buffer, 20, AD, 0, tag, 0, 0) != FAIL)) {
+    printf("Keyak with %u piston(s): forgery accepted!\n", v->pistonCount);
+    abort();
+  }
+}
+
+void testKeyak(void) {
+  unsigned char key[16], nonce[12], AD[300], plaintext[1000];
+  unsigned char ciphertext[1000], tag[Keyak_tagSize];
+  unsigned int i;
+  Keyak_Instance keyak;
+
+  for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+    testKeyakSession(&vectors[i]);
+
+  // Lake Keyak without a start tag
+  ptn(key, sizeof(key));
+  ptn(nonce, sizeof(nonce));
+  ptn(AD, sizeof(AD));
+  ptn(plaintext, sizeof(plaintext));
+  Keyak_Initialize(
+      &keyak, Keyak_pistonsLake, key, 16, nonce, 12, 0, 0, 0, 0);
+  Keyak_Wrap(&keyak, plaintext, ciphertext, 1000, AD, 300, tag, 0, 0);
+  checkTag("without a start tag",
+              Keyak_pistonsLake,
+              tag,
+              "\xE9\x3F\x40\x82\xD5\x27\x89\xE7"
+              "\x38\x57\x69\x23\x45\x8C\xF3\x8C");
+}
@@ -0,0 +1,79 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/Kravatte.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The test vectors below are printed by scripts/testVectors/kravatte.py, a
+// Python model of Kravatte whose Keccak-p is checked against hashlib's SHA-3.
+// ptn(n) is the pattern 00 01 02 .. F9 FA 00 01 .. truncated to n bytes. The
+// outputs of 1000 bytes are checked on their last 32 bytes.
+// The model and Modes/Kravatte.c were both written from the specification,
+// so these vectors do not replace the Kravatte test vectors of the
+// designers, which are not part of this tree yet. One of them, with
+// several blocks on input and on output so that rollc and rolle are
+// exercised, belongs here once they are.
+
+void testKravatte(void) {
+  unsigned char key[32];
+  unsigned char input[1000];
+  unsigned char output[1000];
+  unsigned char output2[1000];
+  Kravatte_Instance kv;
+
+  ptn(key, sizeof(key));
+  ptn(input, sizeof(input));
+
+  Kravatte(key, 16, 0, 0, output, 32);
+  checkOutput("Kravatte(K=ptn(16), M=empty)",
+              output,
+              "\x65\xC8\xA0\x2A\xA1\x09\xCA\xFF\x2A\x84\x6A\x46\xD6\x34\x6F\xF6"
+              "\x2F\xE0\xE4\x13\x58\xC8\xAD\x89\xF2\x4A\x2F\x1D\xF9\x99\xBA\x73",
+              32);
+
+  // Five blocks and the padding on input, five blocks on output
+  Kravatte(key, 32, input, 1000, output, 1000);
+  checkOutput("Kravatte(K=ptn(32), M=ptn(1000))",
+              output + 1000 - 32,
+              "\x09\xCF\x55\xC6\x16\xF7\x18\x55\x10\x2D\x1A\xC4\x12\x3D\x63\x5E"
+              "\x9F\x5F\x57\xD4\x4F\x67\x5D\x42\xBF\xA4\xAD\x47\x38\xEC\x0B\xE1",
+              32);
+
+  // Same, with the input and the output split at arbitrary positions
+  Kravatte_MaskDerivation(&kv, key, 32);
+  Kravatte_Compress(&kv, input, 1, 0);
+  Kravatte_Compress(&kv, input + 1, 399, 0);
+  Kravatte_Compress(&kv, input + 400, 600, 1);
+  Kravatte_Expand(&kv, output2, 7);
+  Kravatte_Expand(&kv, output2 + 7, 800);
+  Kravatte_Expand(&kv, output2 + 807, 193);
+  if (memcmp(output, output2, sizeof(output)) != 0) {
+    printf("Kravatte: incremental input or output differs!\n");
+    abort();
+  }
+
+  // A sequence of two strings
+  Kravatte_MaskDerivation(&kv, key, 32);
+  Kravatte_Compress(&kv, input, 200, 1);
+  Kravatte_Compress(&kv, input, 3, 1);
+  Kravatte_Expand(&kv, output, 1000);
+  checkOutput("Kravatte(K=ptn(32), M=ptn(3) o ptn(200))",
+              output + 1000 - 32,
+              "\x88\x93\xEF\x5D\x8C\x08\x63\x56\x4E\x8B\x72\xA5\xCB\x67\x79\x91"
+              "\x0D\xC0\x83\xF6\x39\x3F\x90\x33\x97\xEB\xB3\x50\x8E\x50\xC6\xDF",
+              32);
+}
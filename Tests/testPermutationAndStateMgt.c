@@ -15,6 +15,7 @@ http://creativecommons.org/publicdomain/zero/1.0/
 #include "Tests/tests.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 void accumulateBuffer(void* stateAccumulated, const unsigned char* buffer) {
@@ -144,6 +145,70 @@ void testPermutationAndStateMgt(void) {
         }
   }
 
+  // Checking KeccakF1600_StateExtractAndXORBytesInLane(),
+  // KeccakF1600_StateExtractAndXORLanes() and KeccakF1600_StateOverwrite*()
+  // against the extraction functions, without affecting the result
+  {
+    unsigned char stateCopy[KeccakF_width / 8];
+    unsigned char expected[KeccakF_width / 8 + 8];
+    unsigned char buffer[KeccakF_width / 8 + 8];
+    unsigned int i, lanePosition, offset, length, laneCount, alignment;
+
+    for (alignment = 0; alignment < 8; alignment++) {
+      for (lanePosition = 0; lanePosition < 25; lanePosition++)
+        for (offset = 0; offset < KeccakF_laneInBytes; offset++)
+          for (length = 0; length <= KeccakF_laneInBytes - offset; length++) {
+            for (i = 0; i < KeccakF_laneInBytes; i++)
+              buffer[i + alignment] = 0x5A + 7 * i + lanePosition;
+            KeccakF1600_StateExtractBytesInLane(
+                stateTest, lanePosition, expected, offset, length);
+            for (i = 0; i < length; i++)
+              expected[i] ^= buffer[i + alignment];
+            KeccakF1600_StateExtractAndXORBytesInLane(
+                stateTest, lanePosition, buffer + alignment, offset, length);
+            if (memcmp(buffer + alignment, expected, length) != 0) {
+              printf("KeccakF1600_StateExtractAndXORBytesInLane() failed!\n");
+              abort();
+            }
+            memcpy(stateCopy, stateTest, sizeof(stateCopy));
+            KeccakF1600_StateOverwriteBytesInLane(
+                stateCopy, lanePosition, buffer + alignment, offset, length);
+            KeccakF1600_StateExtractLanes(stateTest, expected, 25);
+            memcpy(expected + lanePosition * 8 + offset,
+                   buffer + alignment,
+                   length);
+            KeccakF1600_StateExtractLanes(stateCopy, buffer, 25);
+            if (memcmp(buffer, expected, KeccakF_width / 8) != 0) {
+              printf("KeccakF1600_StateOverwriteBytesInLane() failed!\n");
+              abort();
+            }
+          }
+      for (laneCount = 0; laneCount <= 25; laneCount++) {
+        for (i = 0; i < KeccakF_width / 8; i++)
+          buffer[i + alignment] = 0x1D + 3 * i + laneCount;
+        KeccakF1600_StateExtractLanes(stateTest, expected, laneCount);
+        for (i = 0; i < laneCount * 8; i++)
+          expected[i] ^= buffer[i + alignment];
+        KeccakF1600_StateExtractAndXORLanes(
+            stateTest, buffer + alignment, laneCount);
+        if (memcmp(buffer + alignment, expected, laneCount * 8) != 0) {
+          printf("KeccakF1600_StateExtractAndXORLanes() failed!\n");
+          abort();
+        }
+        memcpy(stateCopy, stateTest, sizeof(stateCopy));
+        KeccakF1600_StateOverwriteLanes(
+            stateCopy, buffer + alignment, laneCount);
+        KeccakF1600_StateExtractLanes(stateTest, expected, 25);
+        memcpy(expected, buffer + alignment, laneCount * 8);
+        KeccakF1600_StateExtractLanes(stateCopy, buffer, 25);
+        if (memcmp(buffer, expected, KeccakF_width / 8) != 0) {
+          printf("KeccakF1600_StateOverwriteLanes() failed!\n");
+          abort();
+        }
+      }
+    }
+  }
+
   // Outputting the result
   {
     unsigned char buffer[KeccakF_width / 8];
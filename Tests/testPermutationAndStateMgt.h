@@ -10,7 +10,7 @@ To the extent possible under law, the implementer has waived all copyright
 and related or neighboring rights to the source code in this file.
 http://creativecommons.org/publicdomain/zero/1.0/
 */
-#ifndef TEST_DUPLEX_H
-#define TEST_DUPLEX_H
+#ifndef TEST_PERMUTATION_AND_STATE_MGT_H
+#define TEST_PERMUTATION_AND_STATE_MGT_H
 void testPermutationAndStateMgt(void);
 #endif
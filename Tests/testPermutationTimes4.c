@@ -0,0 +1,112 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "KeccakF-1600/KeccakF-1600-interface.h"
+#include "KeccakF-1600/KeccakF-1600-times4-interface.h"
+#include "Constructions/KeccakSponge.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define stride 400
+
+// Checks the KeccakF1600times4_* functions against four independent states
+// processed by the single-state functions.
+void testPermutationTimes4(void) {
+  ALIGN unsigned char states[KeccakF1600times4_statesSizeInBytes];
+  ALIGN unsigned char reference[4][KeccakF_width / 8];
+  unsigned char data[4 * stride];
+  unsigned char bytes[KeccakF_width / 8];
+  unsigned char output[4 * stride];
+  unsigned char expected[4 * stride];
+  unsigned long long absorbed;
+  unsigned int i, j;
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = (unsigned char)(i * 7 + (i >> 8));
+
+  KeccakF1600_Initialize();
+  KeccakF1600times4_StateInitializeAll(states);
+  absorbed =
+      KeccakF1600times4_StateAbsorbBlocksAll(states, 21, data, stride, stride);
+  if (absorbed != 2 * 168) {
+    printf("KeccakF1600times4_StateAbsorbBlocksAll: wrong length!\n");
+    abort();
+  }
+  KeccakF1600times4_StateXORLanesAll(states, data + 3, 25, stride);
+  for (i = 0; i < 4; i++)
+    KeccakF1600times4_StateXORBytes(states, i, data + i, 5 + i, 150 - i);
+  KeccakF1600times4_StatePermuteAll(states);
+  KeccakF1600times4_StateExtractLanesAll(states, output, 17, stride);
+  for (i = 0; i < 4; i++)
+    KeccakF1600times4_StateExtractBytes(
+        states, i, output + i * stride + 136, 136 + i, 64 - i);
+
+  for (i = 0; i < 4; i++) {
+    KeccakF1600_StateInitialize(reference[i]);
+    for (j = 0; j < 2; j++) {
+      KeccakF1600_StateXORLanes(reference[i], data + i * stride + j * 168, 21);
+      KeccakF1600_StatePermute(reference[i]);
+    }
+    KeccakF1600_StateXORLanes(reference[i], data + i * stride + 3, 25);
+    memset(bytes, 0, sizeof(bytes));
+    memcpy(bytes + 5 + i, data + i, 150 - i);
+    KeccakF1600_StateXORLanes(reference[i], bytes, 25);
+    KeccakF1600_StatePermute(reference[i]);
+    KeccakF1600_StateExtractLanes(reference[i], bytes, 25);
+    memcpy(expected + i * stride, bytes, 136);
+    memcpy(expected + i * stride + 136, bytes + 136 + i, 64 - i);
+    if (memcmp(output + i * stride, expected + i * stride, 200 - i) != 0) {
+      printf("KeccakF1600times4: instance %u differs from KeccakF1600!\n", i);
+      abort();
+    }
+  }
+
+  // Keccak-p[1600, 12], continuing from the states above
+  KeccakP1600times4_StateAbsorbBlocksAll12rounds(
+      states, 17, data, stride, stride);
+  KeccakP1600times4_StatePermuteAll12rounds(states);
+  KeccakF1600times4_StateExtractLanesAll(states, output, 25, stride);
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 2; j++) {
+      KeccakF1600_StateXORLanes(reference[i], data + i * stride + j * 136, 17);
+      KeccakP1600_StatePermute12rounds(reference[i]);
+    }
+    KeccakP1600_StatePermute12rounds(reference[i]);
+    KeccakF1600_StateExtractLanes(reference[i], expected + i * stride, 25);
+    if (memcmp(output + i * stride, expected + i * stride, 200) != 0) {
+      printf("KeccakP1600times4: instance %u differs from KeccakP1600!\n", i);
+      abort();
+    }
+  }
+
+  // Keccak-p[1600, 14], continuing from the states above
+  KeccakP1600times4_StateAbsorbBlocksAll14rounds(
+      states, 17, data, stride, stride);
+  KeccakP1600times4_StatePermuteAll14rounds(states);
+  KeccakF1600times4_StateExtractLanesAll(states, output, 25, stride);
+  for (i = 0; i < 4; i++) {
+    for (j = 0; j < 2; j++) {
+      KeccakF1600_StateXORLanes(reference[i], data + i * stride + j * 136, 17);
+      KeccakP1600_StatePermute14rounds(reference[i]);
+    }
+    KeccakP1600_StatePermute14rounds(reference[i]);
+    KeccakF1600_StateExtractLanes(reference[i], expected + i * stride, 25);
+    if (memcmp(output + i * stride, expected + i * stride, 200) != 0) {
+      printf("KeccakP1600times4: instance %u differs from KeccakP1600!\n", i);
+      abort();
+    }
+  }
+}
@@ -0,0 +1,130 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KeccakPrefixCache.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Hashes prefix || message with SHA3-256 (or SHAKE128 if shake is set),
+// using the cache for the prefix if given.
+static void hashWithPrefix(Keccak_PrefixCache* cache,
+                           int shake,
+                           const unsigned char* prefix,
+                           unsigned int prefixByteLen,
+                           const unsigned char* message,
+                           unsigned int messageByteLen,
+                           unsigned char* output) {
+  Keccak_HashInstance hash;
+
+  if (shake)
+    Keccak_HashInitialize_SHAKE128(&hash);
+  else
+    Keccak_HashInitialize_SHA3_256(&hash);
+  if (cache != NULL)
+    Keccak_PrefixCacheAbsorb(cache, &hash, prefix, prefixByteLen);
+  else
+    Keccak_HashUpdate(&hash, prefix, prefixByteLen * 8);
+  Keccak_HashUpdate(&hash, message, messageByteLen * 8);
+  Keccak_HashFinal(&hash, output);
+  if (shake) Keccak_HashSqueeze(&hash, output, 256);
+}
+
+static void checkCounts(const Keccak_PrefixCache* cache,
+                        unsigned long long hits,
+                        unsigned long long misses) {
+  if ((cache->hits != hits) || (cache->misses != misses)) {
+    printf("Prefix cache: %llu hits and %llu misses, not %llu and %llu!\n",
+           cache->hits,
+           cache->misses,
+           hits,
+           misses);
+    abort();
+  }
+}
+
+void testPrefixCache(void) {
+  Keccak_PrefixCache cache;
+  unsigned char prefixes[Keccak_PrefixCache_entryCount + 2][136];
+  unsigned char longPrefix[Keccak_PrefixCache_maxPrefixByteLen + 1];
+  unsigned char message[100];
+  unsigned char output[32];
+  unsigned char expected[32];
+  unsigned int p, i, round;
+
+  for (p = 0; p < Keccak_PrefixCache_entryCount + 2; p++)
+    for (i = 0; i < sizeof(prefixes[p]); i++)
+      prefixes[p][i] = (unsigned char)(p * 31 + i);
+  for (i = 0; i < sizeof(longPrefix); i++)
+    longPrefix[i] = (unsigned char)(i * 5);
+  for (i = 0; i < sizeof(message); i++)
+    message[i] = (unsigned char)(i * 3);
+
+  Keccak_PrefixCacheInitialize(&cache);
+  // Prefixes of various lengths, including a whole SHA3-256 block, each
+  // used once by both functions, then again
+  for (round = 0; round < 2; round++)
+    for (p = 0; p < Keccak_PrefixCache_entryCount / 2; p++) {
+      unsigned int prefixByteLen = 136 - 40 * (p % 2);
+      int shake;
+      for (shake = 0; shake < 2; shake++) {
+        hashWithPrefix(
+            0, shake, prefixes[p], prefixByteLen, message, p + 7, expected);
+        hashWithPrefix(
+            &cache, shake, prefixes[p], prefixByteLen, message, p + 7, output);
+        if (memcmp(output, expected, sizeof(output)) != 0) {
+          printf("Prefix cache differs!\n");
+          abort();
+        }
+      }
+    }
+  checkCounts(
+      &cache, Keccak_PrefixCache_entryCount, Keccak_PrefixCache_entryCount);
+
+  // Two new prefixes evict the two least recently used entries
+  hashWithPrefix(&cache, 0, prefixes[8], 136, message, 1, output);
+  hashWithPrefix(&cache, 0, prefixes[9], 136, message, 1, output);
+  checkCounts(
+      &cache, Keccak_PrefixCache_entryCount, Keccak_PrefixCache_entryCount + 2);
+  hashWithPrefix(&cache, 1, prefixes[0], 136, message, 1, output);
+  hashWithPrefix(&cache, 0, prefixes[0], 136, message, 1, output);
+  checkCounts(
+      &cache, Keccak_PrefixCache_entryCount, Keccak_PrefixCache_entryCount + 4);
+  hashWithPrefix(&cache, 0, prefixes[9], 136, message, 1, output);
+  hashWithPrefix(&cache, 1, prefixes[3], 96, message, 1, output);
+  checkCounts(&cache,
+              Keccak_PrefixCache_entryCount + 2,
+              Keccak_PrefixCache_entryCount + 4);
+
+  // Prefixes that are too long are absorbed without being cached
+  for (round = 0; round < 2; round++) {
+    hashWithPrefix(
+        &cache, 0, longPrefix, sizeof(longPrefix), message, 9, output);
+    hashWithPrefix(0, 0, longPrefix, sizeof(longPrefix), message, 9, expected);
+    if (memcmp(output, expected, sizeof(output)) != 0) {
+      printf("Prefix cache differs for a long prefix!\n");
+      abort();
+    }
+  }
+  checkCounts(&cache,
+              Keccak_PrefixCache_entryCount + 2,
+              Keccak_PrefixCache_entryCount + 6);
+
+  Keccak_PrefixCacheClear(&cache);
+  hashWithPrefix(&cache, 0, prefixes[9], 136, message, 1, output);
+  checkCounts(&cache,
+              Keccak_PrefixCache_entryCount + 2,
+              Keccak_PrefixCache_entryCount + 7);
+}
@@ -0,0 +1,217 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/SP800-185.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The sample values below are from the NIST SP 800-185 examples.
+
+static void testCSHAKE(void) {
+  const BitSequence* S = (const BitSequence*)"Email Signature";
+  unsigned char X[200];
+  unsigned char output[64];
+  cSHAKE_Instance csi;
+  unsigned int i;
+
+  for (i = 0; i < sizeof(X); i++)
+    X[i] = (unsigned char)i;
+
+  cSHAKE128(X, 4 * 8, output, 256, 0, 0, S, 15 * 8);
+  checkOutput("cSHAKE128 sample #1",
+              output,
+              "\xC1\xC3\x69\x25\xB6\x40\x9A\x04\xF1\xB5\x04\xFC\xBC\xA9\xD8\x2B"
+              "\x40\x17\x27\x7C\xB5\xED\x2B\x20\x65\xFC\x1D\x38\x14\xD5\xAA\xF5",
+              32);
+  cSHAKE128(X, 200 * 8, output, 256, 0, 0, S, 15 * 8);
+  checkOutput("cSHAKE128 sample #2",
+              output,
+              "\xC5\x22\x1D\x50\xE4\xF8\x22\xD9\x6A\x2E\x88\x81\xA9\x61\x42\x0F"
+              "\x29\x4B\x7B\x24\xFE\x3D\x20\x94\xBA\xED\x2C\x65\x24\xCC\x16\x6B",
+              32);
+  cSHAKE256(X, 4 * 8, output, 512, 0, 0, S, 15 * 8);
+  checkOutput("cSHAKE256 sample #3",
+              output,
+              "\xD0\x08\x82\x8E\x2B\x80\xAC\x9D\x22\x18\xFF\xEE\x1D\x07\x0C\x48"
+              "\xB8\xE4\xC8\x7B\xFF\x32\xC9\x69\x9D\x5B\x68\x96\xEE\xE0\xED\xD1"
+              "\x64\x02\x0E\x2B\xE0\x56\x08\x58\xD9\xC0\x0C\x03\x7E\x34\xA9\x69"
+              "\x37\xC5\x61\xA7\x4C\x41\x2B\xB4\xC7\x46\x46\x95\x27\x28\x1C\x8C",
+              64);
+  cSHAKE256(X, 200 * 8, output, 512, 0, 0, S, 15 * 8);
+  checkOutput("cSHAKE256 sample #4",
+              output,
+              "\x07\xDC\x27\xB1\x1E\x51\xFB\xAC\x75\xBC\x7B\x3C\x1D\x98\x3E\x8B"
+              "\x4B\x85\xFB\x1D\xEF\xAF\x21\x89\x12\xAC\x86\x43\x02\x73\x09\x17"
+              "\x27\xF4\x2B\x17\xED\x1D\xF6\x3E\x8E\xC1\x18\xF0\x4B\x23\x63\x3C"
+              "\x1D\xFB\x15\x74\xC8\xFB\x55\xCB\x45\xDA\x8E\x25\xAF\xB0\x92\xBB",
+              64);
+
+  // An output length that the instance cannot hold is rejected
+  if (cSHAKE128_Initialize(&csi, (DataLength)1 << 40, 0, 0, S, 15 * 8) !=
+      FAIL) {
+    printf("cSHAKE128 accepts a truncated output length!\n");
+    abort();
+  }
+}
+
+static void testKMAC(void) {
+  const BitSequence* S = (const BitSequence*)"My Tagged Application";
+  unsigned char K[32];
+  unsigned char X[200];
+  unsigned char output[64];
+  KMAC_KeyInstance key;
+  KMAC_Instance kmac;
+  unsigned int i;
+
+  for (i = 0; i < sizeof(K); i++)
+    K[i] = (unsigned char)(0x40 + i);
+  for (i = 0; i < sizeof(X); i++)
+    X[i] = (unsigned char)i;
+
+  KMAC128(K, 32 * 8, X, 4 * 8, output, 256, 0, 0);
+  checkOutput("KMAC128 sample #1",
+              output,
+              "\xE5\x78\x0B\x0D\x3E\xA6\xF7\xD3\xA4\x29\xC5\x70\x6A\xA4\x3A\x00"
+              "\xFA\xDB\xD7\xD4\x96\x28\x83\x9E\x31\x87\x24\x3F\x45\x6E\xE1\x4E",
+              32);
+  KMAC128(K, 32 * 8, X, 4 * 8, output, 256, S, 21 * 8);
+  checkOutput("KMAC128 sample #2",
+              output,
+              "\x3B\x1F\xBA\x96\x3C\xD8\xB0\xB5\x9E\x8C\x1A\x6D\x71\x88\x8B\x71"
+              "\x43\x65\x1A\xF8\xBA\x0A\x70\x70\xC0\x97\x9E\x28\x11\x32\x4A\xA5",
+              32);
+  KMAC128(K, 32 * 8, X, 200 * 8, output, 256, S, 21 * 8);
+  checkOutput("KMAC128 sample #3",
+              output,
+              "\x1F\x5B\x4E\x6C\xCA\x02\x20\x9E\x0D\xCB\x5C\xA6\x35\xB8\x9A\x15"
+              "\xE2\x71\xEC\xC7\x60\x07\x1D\xFD\x80\x5F\xAA\x38\xF9\x72\x92\x30",
+              32);
+  KMAC256(K, 32 * 8, X, 4 * 8, output, 512, S, 21 * 8);
+  checkOutput("KMAC256 sample #4",
+              output,
+              "\x20\xC5\x70\xC3\x13\x46\xF7\x03\xC9\xAC\x36\xC6\x1C\x03\xCB\x64"
+              "\xC3\x97\x0D\x0C\xFC\x78\x7E\x9B\x79\x59\x9D\x27\x3A\x68\xD2\xF7"
+              "\xF6\x9D\x4C\xC3\xDE\x9D\x10\x4A\x35\x16\x89\xF2\x7C\xF6\xF5\x95"
+              "\x1F\x01\x03\xF3\x3F\x4F\x24\x87\x10\x24\xD9\xC2\x77\x73\xA8\xDD",
+              64);
+  KMAC256(K, 32 * 8, X, 200 * 8, output, 512, 0, 0);
+  checkOutput("KMAC256 sample #5",
+              output,
+              "\x75\x35\x8C\xF3\x9E\x41\x49\x4E\x94\x97\x07\x92\x7C\xEE\x0A\xF2"
+              "\x0A\x3F\xF5\x53\x90\x4C\x86\xB0\x8F\x21\xCC\x41\x4B\xCF\xD6\x91"
+              "\x58\x9D\x27\xCF\x5E\x15\x36\x9C\xBB\xFF\x8B\x9A\x4C\x2E\xB1\x78"
+              "\x00\x85\x5D\x02\x35\xFF\x63\x5D\xA8\x25\x33\xEC\x6B\x75\x9B\x69",
+              64);
+
+  // The same key instance must serve several messages unchanged.
+  KMAC256_KeyInitialize(&key, K, 32 * 8, S, 21 * 8);
+  for (i = 0; i < 2; i++) {
+    KMAC_WithKey(&key, X, 200 * 8, output, 512);
+    checkOutput(
+        "KMAC256 sample #6",
+        output,
+        "\xB5\x86\x18\xF7\x1F\x92\xE1\xD5\x6C\x1B\x8C\x55\xDD\xD7\xCD\x18"
+        "\x8B\x97\xB4\xCA\x4D\x99\x83\x1E\xB2\x69\x9A\x83\x7D\xA2\xE4\xD9"
+        "\x70\xFB\xAC\xFD\xE5\x00\x33\xAE\xA5\x85\xF1\xA2\x70\x85\x10\xC3"
+        "\x2D\x07\x88\x08\x01\xBD\x18\x28\x98\xFE\x47\x68\x76\xFC\x89\x65",
+        64);
+  }
+
+  // KMACXOF, with the input given in pieces and the output squeezed in two
+  KMAC128_KeyInitialize(&key, K, 32 * 8, S, 21 * 8);
+  KMAC_Initialize(&kmac, &key, 0);
+  KMAC_Update(&kmac, X, 1 * 8);
+  KMAC_Update(&kmac, X + 1, 3 * 8);
+  KMAC_Final(&kmac, 0);
+  KMAC_Squeeze(&kmac, output, 5 * 8);
+  KMAC_Squeeze(&kmac, output + 5, 27 * 8);
+  checkOutput("KMACXOF128 sample #2",
+              output,
+              "\x31\xA4\x45\x27\xB4\xED\x9F\x5C\x61\x01\xD1\x1D\xE6\xD2\x6F\x06"
+              "\x20\xAA\x5C\x34\x1D\xEF\x41\x29\x96\x57\xFE\x9D\xF1\xA3\xB1\x6C",
+              32);
+
+  if (KMAC_Initialize(&kmac, &key, (DataLength)1 << 40) != FAIL) {
+    printf("KMAC accepts a truncated output length!\n");
+    abort();
+  }
+}
+
+static void testParallelHash(void) {
+  const BitSequence* S = (const BitSequence*)"Parallel Data";
+  unsigned char X[3000];
+  unsigned char output[64];
+  unsigned char chainingValues[22 * 64];
+  ParallelHash_Instance ph;
+  unsigned int i;
+
+  for (i = 0; i < 24; i++)
+    X[i] = (unsigned char)((i / 8) * 0x10 + (i % 8));
+
+  ParallelHash128(X, 24 * 8, 8, output, 256, 0, 0);
+  checkOutput("ParallelHash128 sample #1",
+              output,
+              "\xBA\x8D\xC1\xD1\xD9\x79\x33\x1D\x3F\x81\x36\x03\xC6\x7F\x72\x60"
+              "\x9A\xB5\xE4\x4B\x94\xA0\xB8\xF9\xAF\x46\x51\x44\x54\xA2\xB4\xF5",
+              32);
+  ParallelHash128(X, 24 * 8, 8, output, 256, S, 13 * 8);
+  checkOutput("ParallelHash128 sample #2",
+              output,
+              "\xFC\x48\x4D\xCB\x3F\x84\xDC\xEE\xDC\x35\x34\x38\x15\x1B\xEE\x58"
+              "\x15\x7D\x6E\xFE\xD0\x44\x5A\x81\xF1\x65\xE4\x95\x79\x5B\x72\x06",
+              32);
+  ParallelHash256(X, 24 * 8, 8, output, 512, S, 13 * 8);
+  checkOutput("ParallelHash256 sample #5",
+              output,
+              "\xCD\xF1\x52\x89\xB5\x4F\x62\x12\xB4\xBC\x27\x05\x28\xB4\x95\x26"
+              "\x00\x6D\xD9\xB5\x4E\x2B\x6A\xDD\x1E\xF6\x90\x0D\xDA\x39\x63\xBB"
+              "\x33\xA7\x24\x91\xF2\x36\x96\x9C\xA8\xAF\xAE\xA2\x9C\x68\x2D\x47"
+              "\xA3\x93\xC0\x65\xB3\x8E\x29\xFA\xE6\x51\xA2\x09\x1C\x83\x31\x10",
+              64);
+
+  // Enough leaves to go through the parallel path, given in odd pieces
+  ptn(X, sizeof(X));
+  ParallelHash128_Initialize(&ph, 200, 256, 0, 0);
+  ParallelHash_Update(&ph, X, 7 * 8);
+  ParallelHash_Update(&ph, X + 7, 1500 * 8);
+  ParallelHash_Update(&ph, X + 1507, 1493 * 8);
+  ParallelHash_Final(&ph, output);
+  checkOutput("ParallelHash128 with 15 leaves",
+              output,
+              "\xCF\x0E\xE1\x60\x28\x42\xAE\x9F\x92\x62\x1A\xDC\xB9\x87\x65\x0B"
+              "\x15\x58\x15\x53\x78\x78\x4F\xDF\x7D\xA2\x8C\x3B\xF7\x6D\x93\x0D",
+              32);
+
+  // Leaves of exactly one block, hashed outside the instance
+  ParallelHash256_Initialize(&ph, 136, 0, 0, 0);
+  ParallelHash_HashLeaves(&ph, X, 11, chainingValues);
+  ParallelHash_HashLeaves(&ph, X + 11 * 136, 11, chainingValues + 11 * 64);
+  ParallelHash_UpdateChainingValues(&ph, chainingValues, 22);
+  ParallelHash_Update(&ph, X + 22 * 136, (3000 - 22 * 136) * 8);
+  ParallelHash_Final(&ph, 0);
+  ParallelHash_Squeeze(&ph, output, 32 * 8);
+  checkOutput("ParallelHashXOF256 with 23 leaves",
+              output,
+              "\xE5\x92\xAC\xFF\x14\x30\x28\xCD\x4F\x47\x5B\xFC\x59\x86\x26\x77"
+              "\x95\xB0\x1D\x17\x42\x76\xE5\xFA\xF8\xF3\x3B\x8A\x41\xAC\xCB\xA5",
+              32);
+}
+
+void testSP800_185(void) {
+  testCSHAKE();
+  testKMAC();
+  testParallelHash();
+}
@@ -27,9 +27,10 @@ void testSponge(FILE* f,
   unsigned char input[inputByteSize];
   unsigned char output[outputByteSize];
   unsigned char acc[outputByteSize];
+  unsigned char outputXOR[outputByteSize];
   unsigned int inputBitLength, offset, size;
   int result;
-  Keccak_SpongeInstance sponge;
+  Keccak_SpongeInstance sponge, spongeXOR;
 
   // Acumulated test vector
   memset(acc, 0x00, sizeof(acc));
@@ -72,6 +73,16 @@ void testSponge(FILE* f,
           &sponge,
           input[inputByteLengthCeiling - 1] | (1 << (inputBitLength % 8)));
 
+    // Same output, XORed into a buffer in chunks of varying sizes
+    spongeXOR = sponge;
+    for (i = 0; i < outputByteSize; i++)
+      outputXOR[i] = (unsigned char)(0x3B * i + inputBitLength);
+    for (offset = 0; offset < outputByteSize; offset += size) {
+      size = (offset * 7 + inputBitLength) % 211 + 1;
+      if (size > (outputByteSize - offset)) size = outputByteSize - offset;
+      Keccak_SpongeSqueezeXOR(&spongeXOR, outputXOR + offset, size);
+    }
+
     if (usingQueue) {
       unsigned char filler = 0xAA + inputBitLength;
       memset(output, filler, sizeof(output));
@@ -100,8 +111,14 @@ void testSponge(FILE* f,
     } else
       result = Keccak_SpongeSqueeze(&sponge, output, outputByteSize);
 
-    for (i = 0; i < outputByteSize; i++)
+    for (i = 0; i < outputByteSize; i++) {
       acc[i] ^= output[i];
+      if ((outputXOR[i] ^ output[i]) !=
+          (unsigned char)(0x3B * i + inputBitLength)) {
+        printf("Keccak_SpongeSqueezeXOR() differs!\n");
+        abort();
+      }
+    }
   }
 
   fprintf(f, "Keccak[r=%d, c=%d]: ", rate, capacity);
@@ -133,3 +150,64 @@ void testSpongeWithoutQueue() {
     testSponge(f, rate, 1600 - rate, 0);
   fclose(f);
 }
+
+// Checks that a snapshot taken in the middle of absorbing or squeezing
+// resumes to the same output, and that its format does not depend on the
+// implementation of Keccak-f[1600].
+void testSpongeSerialization(void) {
+  Keccak_SpongeInstance sponge, resumed;
+  unsigned char input[300];
+  unsigned char snapshot[Keccak_SpongeSerializedByteLen];
+  unsigned char digest[16];
+  unsigned char output[100];
+  unsigned char outputResumed[100];
+  unsigned int cut, length;
+
+  ptn(input, sizeof(input));
+
+  // SHAKE128 state after 200 bytes, checked through the SHAKE128 digest of
+  // its snapshot, computed with Python's hashlib
+  Keccak_SpongeInitialize(&sponge, 1344, 256);
+  Keccak_SpongeAbsorb(&sponge, input, 200);
+  Keccak_SpongeSerialize(&sponge, snapshot);
+  Keccak_SpongeInitialize(&resumed, 1344, 256);
+  Keccak_SpongeAbsorb(&resumed, snapshot, sizeof(snapshot));
+  Keccak_SpongeAbsorbLastFewBits(&resumed, 0x1F);
+  Keccak_SpongeSqueeze(&resumed, digest, sizeof(digest));
+  if (memcmp(digest,
+             "\x87\xb9\xd7\xec\x56\x08\x0f\xcd\x23\x7f\xda\x22\x8f\xd5\xab\x36",
+             sizeof(digest)) != 0) {
+    printf("Keccak_SpongeSerialize() differs!\n");
+    abort();
+  }
+
+  for (cut = 0; cut < sizeof(input) + sizeof(output); cut += 37) {
+    Keccak_SpongeInitializeWithRounds(&sponge, 1088, 512, 12 + 12 * (cut % 2));
+    if (cut < sizeof(input)) {
+      Keccak_SpongeAbsorb(&sponge, input, cut);
+      Keccak_SpongeSerialize(&sponge, snapshot);
+      Keccak_SpongeDeserialize(&resumed, snapshot);
+      Keccak_SpongeAbsorb(&sponge, input + cut, sizeof(input) - cut);
+      Keccak_SpongeAbsorb(&resumed, input + cut, sizeof(input) - cut);
+      length = sizeof(output);
+    } else {
+      Keccak_SpongeAbsorb(&sponge, input, sizeof(input));
+      Keccak_SpongeSqueeze(&sponge, output, cut - sizeof(input));
+      Keccak_SpongeSerialize(&sponge, snapshot);
+      Keccak_SpongeDeserialize(&resumed, snapshot);
+      length = sizeof(output) - (cut - sizeof(input));
+    }
+    Keccak_SpongeSqueeze(&sponge, output, length);
+    Keccak_SpongeSqueeze(&resumed, outputResumed, length);
+    if (memcmp(output, outputResumed, length) != 0) {
+      printf("Keccak_SpongeDeserialize() does not resume the same!\n");
+      abort();
+    }
+  }
+
+  snapshot[0] = 2;
+  if (Keccak_SpongeDeserialize(&resumed, snapshot) == 0) {
+    printf("Keccak_SpongeDeserialize() accepts an unknown format!\n");
+    abort();
+  }
+}
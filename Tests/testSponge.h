@@ -14,4 +14,5 @@ http://creativecommons.org/publicdomain/zero/1.0/
 #define TEST_SPONGE_H
 void testSpongeWithQueue(void);
 void testSpongeWithoutQueue(void);
+void testSpongeSerialization(void);
 #endif
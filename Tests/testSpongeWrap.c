@@ -0,0 +1,100 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/SpongeWrap.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The test vectors below are printed by scripts/testVectors/spongeWrap.py, a
+// Python model of SpongeWrap whose duplex is checked against hashlib's SHA-3
+// and SHAKE128. ptn(n) is the pattern 00 01 02 .. F9 FA 00 01 .. truncated to
+// n bytes. Long outputs are checked on their last 16 bytes.
+
+void testSpongeWrap(void) {
+  unsigned char key[200], AD[300], plaintext[500];
+  unsigned char ciphertext[500], buffer[500], tag[200];
+  SpongeWrap_Instance instance;
+
+  ptn(key, sizeof(key));
+  ptn(AD, sizeof(AD));
+  ptn(plaintext, sizeof(plaintext));
+
+  // r=1344, with a message of several blocks and a partial last block
+  SpongeWrap_Initialize(&instance, 1344, 256, key, 16);
+  SpongeWrap_Wrap(&instance, AD, 30, plaintext, ciphertext, 500, tag, 16);
+  checkOutput("SpongeWrap(r=1344, K=ptn(16), A=ptn(30), B=ptn(500)) C",
+              ciphertext + 500 - 16,
+              "\x0F\x88\x93\x5B\x75\xE4\xBC\x79"
+              "\xB8\x76\x9A\xA2\xFC\xFF\x32\xAD",
+              16);
+  checkOutput("SpongeWrap(r=1344, K=ptn(16), A=ptn(30), B=ptn(500)) T",
+              tag,
+              "\xB9\x00\x9D\x62\xF6\x59\x54\x52"
+              "\x49\x5A\xBA\x22\xE0\xD9\xCF\x88",
+              16);
+
+  // Same session, empty A and B, tag longer than a block
+  SpongeWrap_Wrap(&instance, AD, 0, plaintext, buffer, 0, tag, 200);
+  checkOutput("SpongeWrap(r=1344, A=empty, B=empty) T",
+              tag + 200 - 16,
+              "\x80\x3E\x35\x5B\x20\x30\xD4\xFE"
+              "\x81\x43\x61\xEA\xC9\xB2\x96\x93",
+              16);
+
+  // r=1088, with a key and an AD of several blocks and exactly one block of
+  // message
+  SpongeWrap_Initialize(&instance, 1088, 512, key, 200);
+  SpongeWrap_Wrap(&instance, AD, 300, plaintext, ciphertext, 135, tag, 16);
+  checkOutput("SpongeWrap(r=1088, K=ptn(200), A=ptn(300), B=ptn(135)) C",
+              ciphertext + 135 - 16,
+              "\xD4\x4A\x39\x01\x7E\x04\xBA\x81"
+              "\x7D\xFD\xDB\x6E\xAD\x75\x4C\x38",
+              16);
+  checkOutput("SpongeWrap(r=1088, K=ptn(200), A=ptn(300), B=ptn(135)) T",
+              tag,
+              "\xCC\xBE\x37\xD9\x27\x4A\xF6\xE8"
+              "\x1E\x2C\x8F\xD3\x5A\x34\x4E\xEF",
+              16);
+
+  // Wrapping and unwrapping in place
+  memcpy(buffer, plaintext, sizeof(buffer));
+  SpongeWrap_Initialize(&instance, 1344, 256, key, 16);
+  SpongeWrap_Wrap(&instance, AD, 30, buffer, buffer, 500, tag, 16);
+  SpongeWrap_Initialize(&instance, 1344, 256, key, 16);
+  SpongeWrap_Wrap(&instance, AD, 30, plaintext, ciphertext, 500, tag, 16);
+  if (memcmp(buffer, ciphertext, sizeof(buffer)) != 0) {
+    printf("SpongeWrap: wrapping in place differs!\n");
+    abort();
+  }
+  SpongeWrap_Initialize(&instance, 1344, 256, key, 16);
+  if ((SpongeWrap_Unwrap(&instance, AD, 30, buffer, buffer, 500, tag, 16) !=
+       SUCCESS) ||
+      (memcmp(buffer, plaintext, sizeof(buffer)) != 0)) {
+    printf("SpongeWrap: unwrapping in place failed!\n");
+    abort();
+  }
+
+  // A modified ciphertext is rejected and its output cleared
+  memcpy(buffer, ciphertext, sizeof(buffer));
+  buffer[200] ^= 0x80;
+  SpongeWrap_Initialize(&instance, 1344, 256, key, 16);
+  if ((SpongeWrap_Unwrap(&instance, AD, 30, buffer, buffer, 500, tag, 16) !=
+       FAIL) ||
+      (buffer[0] != 0)) {
+    printf("SpongeWrap: forgery accepted!\n");
+    abort();
+  }
+}
@@ -0,0 +1,173 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/Strobe.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The expected values below are printed by scripts/testVectors/strobe.py, a
+// Python model of STROBE that also gives the conformance values of the
+// Merlin library. ptn(n) is the pattern 00 01 02 .. F9 FA 00 01 .. truncated
+// to n bytes.
+
+static void checkSuccess(const char* what, HashReturn result) {
+  if (result != SUCCESS) {
+    printf("STROBE fails (%s)!\n", what);
+    abort();
+  }
+}
+
+static void testStrobeConformance(void) {
+  Strobe_Instance strobe;
+  unsigned char message[1024];
+  unsigned char prf[32];
+
+  memset(message, 99, sizeof(message));
+  Strobe_Initialize(&strobe,
+                    128,
+                    (const unsigned char*)"Conformance Test Protocol",
+                    25);
+  Strobe_Operate(
+      &strobe, Strobe_AD | Strobe_flagM, (const unsigned char*)"ms", 0, 2, 0);
+  Strobe_Operate(
+      &strobe, Strobe_AD | Strobe_flagM, (const unsigned char*)"g", 0, 1, 1);
+  Strobe_Operate(&strobe, Strobe_AD, message, 0, sizeof(message), 0);
+  Strobe_Operate(
+      &strobe, Strobe_AD | Strobe_flagM, (const unsigned char*)"prf", 0, 3, 0);
+  Strobe_Operate(&strobe, Strobe_PRF, 0, prf, sizeof(prf), 0);
+  checkOutput("STROBE PRF",
+              prf,
+              "\xB4\x8E\x64\x5C\xA1\x7C\x66\x7F\xD5\x20\x6B\xA5\x7A\x6A\x22\x8D"
+              "\x72\xD8\xE1\x90\x38\x14\xD3\xF1\x7F\x62\x29\x96\xD7\xCF\xEF\xB0",
+              sizeof(prf));
+  Strobe_Operate(
+      &strobe, Strobe_AD | Strobe_flagM, (const unsigned char*)"key", 0, 3, 0);
+  Strobe_Operate(&strobe, Strobe_KEY, prf, 0, sizeof(prf), 0);
+  Strobe_Operate(
+      &strobe, Strobe_AD | Strobe_flagM, (const unsigned char*)"prf", 0, 3, 0);
+  Strobe_Operate(&strobe, Strobe_PRF, 0, prf, sizeof(prf), 0);
+  checkOutput("STROBE PRF after KEY",
+              prf,
+              "\x07\xE4\x5C\xCE\x80\x78\xCE\xE2\x59\xE3\xE3\x75\xBB\x85\xD7\x56"
+              "\x10\xE2\xD1\xE1\x20\x1C\x5F\x64\x50\x45\xA1\x94\xED\xD4\x9F\xF8",
+              sizeof(prf));
+}
+
+// The initiator sends an encrypted message and a MAC, the responder
+// receives them, possibly in pieces, and both derive the same challenge.
+static void testStrobeSession(void) {
+  Strobe_Instance initiator, responder;
+  unsigned char key[32];
+  unsigned char plaintext[300];
+  unsigned char ciphertext[300];
+  unsigned char decrypted[300];
+  unsigned char clear[7];
+  unsigned char MAC[16];
+  unsigned char zeroes[10];
+  unsigned char challenge[32];
+  unsigned char challengeResponder[32];
+  const unsigned char* protocol = (const unsigned char*)"Transcript test";
+  unsigned int offset;
+
+  ptn(key, sizeof(key));
+  ptn(plaintext, sizeof(plaintext));
+  ptn(clear, sizeof(clear));
+  memset(zeroes, 0, sizeof(zeroes));
+  Strobe_Initialize(&initiator, 256, protocol, 15);
+  Strobe_Initialize(&responder, 256, protocol, 15);
+  Strobe_Operate(&initiator, Strobe_KEY, key, 0, sizeof(key), 0);
+  Strobe_Operate(&responder, Strobe_KEY, key, 0, sizeof(key), 0);
+
+  Strobe_Operate(&initiator,
+                 Strobe_AD | Strobe_flagM,
+                 (const unsigned char*)"msg",
+                 0,
+                 3,
+                 0);
+  Strobe_Operate(&initiator,
+                 Strobe_sendENC,
+                 plaintext,
+                 ciphertext,
+                 sizeof(plaintext),
+                 0);
+  checkOutput("STROBE sendENC",
+              ciphertext + sizeof(ciphertext) - 16,
+              "\x9C\x58\xDA\x3E\x8C\x8B\x5B\x0E\xF9\xCF\xD3\xC1\x2E\x00\x67\x97",
+              16);
+  Strobe_Operate(&initiator, Strobe_sendCLR, clear, 0, sizeof(clear), 0);
+  Strobe_Operate(&initiator, Strobe_sendMAC, 0, MAC, sizeof(MAC), 0);
+  checkOutput("STROBE sendMAC",
+              MAC,
+              "\xB4\xA2\x92\xD5\x05\x4D\x82\x47\x31\x87\xF8\xAB\x90\xA8\x70\x24",
+              sizeof(MAC));
+  Strobe_Operate(&initiator, Strobe_RATCHET, 0, 0, sizeof(zeroes), 0);
+  Strobe_Operate(&initiator, Strobe_PRF, 0, challenge, sizeof(challenge), 0);
+  checkOutput("STROBE PRF",
+              challenge,
+              "\xA6\xE9\x38\xB0\x5A\xB9\xE2\xBF\x3F\x38\xD7\x5C\x3B\xEE\x13\x39"
+              "\xA1\xE6\x41\xF7\xA2\x51\x73\x06\xF3\xFA\x69\xA6\x87\x51\xA4\x01",
+              sizeof(challenge));
+
+  Strobe_Operate(&responder,
+                 Strobe_AD | Strobe_flagM,
+                 (const unsigned char*)"msg",
+                 0,
+                 3,
+                 0);
+  memcpy(decrypted, ciphertext, sizeof(ciphertext));
+  for (offset = 0; offset < sizeof(decrypted); offset += 60)
+    Strobe_Operate(&responder,
+                   Strobe_recvENC,
+                   decrypted + offset,
+                   decrypted + offset,
+                   60,
+                   offset > 0);
+  if (memcmp(decrypted, plaintext, sizeof(plaintext)) != 0) {
+    printf("STROBE recvENC differs!\n");
+    abort();
+  }
+  Strobe_Operate(&responder, Strobe_recvCLR, clear, 0, 3, 0);
+  Strobe_Operate(&responder, Strobe_recvCLR, clear + 3, 0, 4, 1);
+  checkSuccess(
+      "recvMAC",
+      Strobe_Operate(&responder, Strobe_recvMAC, MAC, 0, sizeof(MAC), 0));
+  Strobe_Operate(&responder, Strobe_RATCHET, 0, 0, sizeof(zeroes), 0);
+  Strobe_Operate(&responder,
+                 Strobe_PRF,
+                 0,
+                 challengeResponder,
+                 sizeof(challengeResponder),
+                 0);
+  if (memcmp(challenge, challengeResponder, sizeof(challenge)) != 0) {
+    printf("STROBE transcripts differ!\n");
+    abort();
+  }
+
+  // A wrong MAC, or continuing a different operation, is rejected
+  MAC[5] ^= 0x10;
+  if ((Strobe_Operate(&responder, Strobe_recvMAC, MAC, 0, sizeof(MAC), 0) !=
+       FAIL) ||
+      (Strobe_Operate(&responder, Strobe_AD, MAC, 0, sizeof(MAC), 1) !=
+       FAIL)) {
+    printf("STROBE accepts invalid input!\n");
+    abort();
+  }
+}
+
+void testStrobe(void) {
+  testStrobeConformance();
+  testStrobeSession();
+}
@@ -0,0 +1,96 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Modes/KeccakHash.h"
+#include "Tests/tests.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The test vectors below are from the TurboSHAKE specification, with ptn(n)
+// the pattern 00 01 02 .. F9 FA 00 01 .. truncated to n bytes.
+
+void testTurboSHAKE(void) {
+  unsigned char M[4913];
+  unsigned char output[64];
+  unsigned char skipped[10000];
+  Keccak_HashInstance hash;
+
+  ptn(M, sizeof(M));
+
+  Keccak_HashInitialize_TurboSHAKE128(&hash, 0x1F);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, output, 32 * 8);
+  checkOutput("TurboSHAKE128(M=empty, D=1F)",
+              output,
+              "\x1E\x41\x5F\x1C\x59\x83\xAF\xF2\x16\x92\x17\x27\x7D\x17\xBB\x53"
+              "\x8C\xD9\x45\xA3\x97\xDD\xEC\x54\x1F\x1C\xE4\x1A\xF2\xC1\xB7\x4C",
+              32);
+
+  Keccak_HashInitialize_TurboSHAKE128(&hash, 0x1F);
+  Keccak_HashUpdate(&hash, M, 289 * 8);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, output, 32 * 8);
+  checkOutput("TurboSHAKE128(M=ptn(17^2), D=1F)",
+              output,
+              "\x96\xC7\x7C\x27\x9E\x01\x26\xF7\xFC\x07\xC9\xB0\x7F\x5C\xDA\xE1"
+              "\xE0\xBE\x60\xBD\xBE\x10\x62\x00\x40\xE7\x5D\x72\x23\xA6\x24\xD2",
+              32);
+
+  memset(M, 0xFF, 3);
+  Keccak_HashInitialize_TurboSHAKE128(&hash, 0x01);
+  Keccak_HashUpdate(&hash, M, 3 * 8);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, output, 32 * 8);
+  checkOutput("TurboSHAKE128(M=FF FF FF, D=01)",
+              output,
+              "\xBF\x32\x3F\x94\x04\x94\xE8\x8E\xE1\xC5\x40\xFE\x66\x0B\xE8\xA0"
+              "\xC9\x3F\x43\xD1\x5E\xC0\x06\x99\x84\x62\xFA\x99\x4E\xED\x5D\xAB",
+              32);
+
+  Keccak_HashInitialize_TurboSHAKE256(&hash, 0x1F);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, output, 64 * 8);
+  checkOutput("TurboSHAKE256(M=empty, D=1F)",
+              output,
+              "\x36\x7A\x32\x9D\xAF\xEA\x87\x1C\x78\x02\xEC\x67\xF9\x05\xAE\x13"
+              "\xC5\x76\x95\xDC\x2C\x66\x63\xC6\x10\x35\xF5\x9A\x18\xF8\xE7\xDB"
+              "\x11\xED\xC0\xE1\x2E\x91\xEA\x60\xEB\x6B\x32\xDF\x06\xDD\x7F\x00"
+              "\x2F\xBA\xFA\xBB\x6E\x13\xEC\x1C\xC2\x0D\x99\x55\x47\x60\x0D\xB0",
+              64);
+
+  // Whole input and output blocks, through the fast lanes of the sponge
+  ptn(M, sizeof(M));
+  Keccak_HashInitialize_TurboSHAKE256(&hash, 0x1F);
+  Keccak_HashUpdate(&hash, M, 4913 * 8);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, skipped, 10000 * 8);
+  Keccak_HashSqueeze(&hash, output, 32 * 8);
+  checkOutput("TurboSHAKE256(M=ptn(17^3), D=1F), 10032 bytes",
+              output,
+              "\xF8\x04\x3C\x00\x33\xD8\xA6\x2A\x18\x01\x54\x66\x6E\xFC\x82\x3C"
+              "\x20\x73\xB9\xE8\x82\xE0\xC8\xD4\x87\x53\x59\x09\x1D\x78\x8E\x0B",
+              32);
+
+  memset(M, 0xFF, 7);
+  Keccak_HashInitialize_TurboSHAKE256(&hash, 0x0B);
+  Keccak_HashUpdate(&hash, M, 7 * 8);
+  Keccak_HashFinal(&hash, 0);
+  Keccak_HashSqueeze(&hash, output, 32 * 8);
+  checkOutput("TurboSHAKE256(M=7 bytes 0xFF, D=0B)",
+              output,
+              "\xBB\x36\x76\x49\x51\xEC\x97\xE9\xD8\x5F\x7E\xE9\xA6\x7A\x77\x18"
+              "\xFC\x00\x5C\xF4\x25\x56\xBE\x79\xCE\x12\xC0\xBD\xE5\x0E\x57\x36",
+              32);
+}
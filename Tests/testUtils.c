@@ -0,0 +1,35 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include "Tests/testUtils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void ptn(unsigned char* data, unsigned int length) {
+  unsigned int i;
+
+  for (i = 0; i < length; i++)
+    data[i] = (unsigned char)(i % 251);
+}
+
+void checkOutput(const char* text,
+                 const unsigned char* output,
+                 const void* expected,
+                 unsigned int length) {
+  if (memcmp(output, expected, length) != 0) {
+    printf("%s: wrong output!\n", text);
+    abort();
+  }
+}
@@ -0,0 +1,28 @@
+/*
+The Keccak sponge function, designed by Guido Bertoni, Joan Daemen,
+Michaël Peeters and Gilles Van Assche. For more information, feedback or
+questions, please refer to our website: http://keccak.noekeon.org/
+
+Implementation by the designers,
+hereby denoted as "the implementer".
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+/** Fills data with the pattern 00 01 02 .. F9 FA 00 01 .., called ptn(n) in
+  * the descriptions of the test vectors.
+  */
+void ptn(unsigned char* data, unsigned int length);
+
+/** Aborts after printing "<text>: wrong output!" if the first @a length bytes
+  * of @a output differ from those of @a expected.
+  */
+void checkOutput(const char* text,
+                 const unsigned char* output,
+                 const void* expected,
+                 unsigned int length);
+#endif
@@ -1,6 +1,26 @@
 #include "Tests/displayIntermediateValues.h"
+#include "Tests/dotiming.h"
 #include "Tests/genKAT.h"
+#include "Tests/testHMAC-SHA3.h"
+#include "Tests/testKangarooTwelve.h"
+#include "Tests/testKeccakHash.h"
+#include "Tests/testKeccakHashChain.h"
+#include "Tests/testKeccakHashToField.h"
+#include "Tests/testKeccakMerkleTree.h"
+#include "Tests/testKeccakNonceSearch.h"
+#include "Tests/testKeccakPRG.h"
+#include "Tests/testKeccakSampling.h"
+#include "Tests/testKeccakSketch.h"
+#include "Tests/testKeyak.h"
+#include "Tests/testKravatte.h"
 #include "Tests/testDuplex.h"
 #include "Tests/testPermutationAndStateMgt.h"
+#include "Tests/testPermutationTimes4.h"
+#include "Tests/testPrefixCache.h"
+#include "Tests/testSP800-185.h"
 #include "Tests/testSponge.h"
+#include "Tests/testSpongeWrap.h"
+#include "Tests/testStrobe.h"
+#include "Tests/testTurboSHAKE.h"
+#include "Tests/testUtils.h"
 #include "Tests/timing.h"
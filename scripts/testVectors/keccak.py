@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+#
+# A plain model of Keccak-p[1600, nr], shared by the scripts that print the
+# expected values of the tests in Tests/. Running this file checks the model
+# against the SHA-3 and SHAKE functions of Python's hashlib.
+
+import hashlib
+
+ROUND_CONSTANTS = [
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808A,
+    0x8000000080008000, 0x000000000000808B, 0x0000000080000001,
+    0x8000000080008081, 0x8000000000008009, 0x000000000000008A,
+    0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+    0x000000008000808B, 0x800000000000008B, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+    0x000000000000800A, 0x800000008000000A, 0x8000000080008081,
+    0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+]
+
+# ROTATION_OFFSETS[x][y] for the lane at (x, y)
+ROTATION_OFFSETS = [
+    [0, 36, 3, 41, 18],
+    [1, 44, 10, 45, 2],
+    [62, 6, 43, 15, 61],
+    [28, 55, 25, 21, 56],
+    [27, 20, 39, 8, 14],
+]
+
+MASK64 = (1 << 64) - 1
+
+
+def rol64(x, n):
+    n %= 64
+    return ((x << n) | (x >> (64 - n))) & MASK64
+
+
+def bytes_to_lanes(state):
+    return [int.from_bytes(state[8 * i:8 * i + 8], 'little')
+            for i in range(25)]
+
+
+def lanes_to_bytes(lanes):
+    return b''.join(lane.to_bytes(8, 'little') for lane in lanes)
+
+
+def keccak_p(state, rounds=24):
+    """Applies the last `rounds` rounds of Keccak-f[1600] to 200 bytes."""
+    lanes = bytes_to_lanes(state)
+    A = [[lanes[x + 5 * y] for y in range(5)] for x in range(5)]
+    for r in range(24 - rounds, 24):
+        C = [A[x][0] ^ A[x][1] ^ A[x][2] ^ A[x][3] ^ A[x][4]
+             for x in range(5)]
+        D = [C[(x - 1) % 5] ^ rol64(C[(x + 1) % 5], 1) for x in range(5)]
+        B = [[0] * 5 for _ in range(5)]
+        for x in range(5):
+            for y in range(5):
+                B[y][(2 * x + 3 * y) % 5] = rol64(A[x][y] ^ D[x],
+                                                  ROTATION_OFFSETS[x][y])
+        A = [[B[x][y] ^ (~B[(x + 1) % 5][y] & B[(x + 2) % 5][y])
+              for y in range(5)] for x in range(5)]
+        A[0][0] ^= ROUND_CONSTANTS[r]
+    return lanes_to_bytes([A[i % 5][i // 5] for i in range(25)])
+
+
+def sponge(rate, message, suffix, length, rounds=24):
+    """Sponge on Keccak-p with the pad10*1 rule, `rate` given in bytes and
+    the delimited `suffix` appended to the message."""
+    padded = bytearray(message) + bytes([suffix])
+    padded += bytes(-len(padded) % rate)
+    padded[-1] |= 0x80
+    state = bytes(200)
+    for i in range(0, len(padded), rate):
+        state = keccak_p(xor(state, padded[i:i + rate]), rounds)
+    output = b''
+    while len(output) < length:
+        output += state[:rate]
+        state = keccak_p(state, rounds)
+    return output[:length]
+
+
+def xor(a, b):
+    """XORs b into the first bytes of a."""
+    return bytes(x ^ y for x, y in zip(a, b)) + bytes(a[len(b):])
+
+
+def ptn(length):
+    """The pattern 00 01 02 .. F9 FA 00 01 .. truncated to length bytes, as
+    built by ptn() in Tests/."""
+    return bytes(i % 251 for i in range(length))
+
+
+def c_string(data, indent, per_line=16):
+    """Formats data as adjacent C string literals of \\x escapes."""
+    return '\n'.join(
+        indent + '"' + ''.join('\\x%02X' % b for b in data[i:i + per_line]) +
+        '"' for i in range(0, len(data), per_line))
+
+
+def self_check():
+    message = ptn(1000)
+    assert sponge(136, message, 0x06, 32) == hashlib.sha3_256(message).digest()
+    assert sponge(72, message, 0x06, 64) == hashlib.sha3_512(message).digest()
+    assert (sponge(168, message, 0x1F, 400) ==
+            hashlib.shake_128(message).digest(400))
+    assert sponge(136, b'', 0x1F, 300) == hashlib.shake_256(b'').digest(300)
+
+
+self_check()
+
+if __name__ == '__main__':
+    print('Keccak-p model agrees with hashlib')
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# Prints the expected values of Tests/testKeyak.c, computed with a model of
+# Keyak v2 written from its specification: the Motorist mode on 1 to 8
+# pistons of Keccak-p[1600, 12].
+
+from keccak import c_string, keccak_p, ptn
+
+R_S = 168  # rate of the squeezing phase in bytes
+R_A = 192  # rate of the absorbing phase in bytes
+EOM = R_A
+CRYPT_END = R_A + 1
+INJECT_START = R_A + 2
+INJECT_END = R_A + 3
+TAG_SIZE = 16
+KNOT_TAG_SIZE = 32
+
+
+class Stream:
+    def __init__(self, data):
+        self.data = bytes(data)
+        self.position = 0
+
+    def remaining(self):
+        return len(self.data) - self.position
+
+    def next(self):
+        self.position += 1
+        return self.data[self.position - 1]
+
+
+class Piston:
+    def __init__(self):
+        self.state = bytearray(200)
+
+    def crypt(self, input, output, offset, unwrap):
+        while input.remaining() and offset < R_S:
+            x = input.next()
+            y = self.state[offset] ^ x
+            output.append(y)
+            self.state[offset] = x if unwrap else y
+            offset += 1
+        self.state[CRYPT_END] ^= offset
+
+    def inject(self, input, crypting):
+        offset = R_S if crypting else 0
+        self.state[INJECT_START] ^= offset
+        while input.remaining() and offset < R_A:
+            self.state[offset] ^= input.next()
+            offset += 1
+        self.state[INJECT_END] ^= offset
+
+    def spark(self, eom, tag_length):
+        if eom:
+            self.state[EOM] ^= 0xFF if tag_length == 0 else tag_length
+        self.state = bytearray(keccak_p(bytes(self.state), 12))
+
+
+class Keyak:
+    def __init__(self, piston_count, key, nonce, tag_flag=True,
+                 forget=False):
+        self.pistons = [Piston() for _ in range(piston_count)]
+        self.offsets = [0] * piston_count
+        suv = (bytes([40]) + key + b'\x01').ljust(40, b'\0') + nonce
+        self.collective(suv, True)
+        if forget:
+            self.knot()
+        self.start_tag = self.tags(
+            [TAG_SIZE if tag_flag else 0] + [0] * (piston_count - 1))
+
+    def spark(self, eom, tag_lengths):
+        for piston, length in zip(self.pistons, tag_lengths):
+            piston.spark(eom, length)
+        self.offsets = list(tag_lengths)
+
+    def tags(self, tag_lengths):
+        self.spark(True, tag_lengths)
+        return b''.join(bytes(piston.state[:length])
+                        for piston, length in zip(self.pistons, tag_lengths))
+
+    def collective(self, data, diversify):
+        count = len(self.pistons)
+        inputs = [Stream(data + (bytes([count, i]) if diversify else b''))
+                  for i in range(count)]
+        while inputs[0].remaining():
+            for piston, input in zip(self.pistons, inputs):
+                piston.inject(input, False)
+            if inputs[0].remaining():
+                self.spark(False, [0] * count)
+        self.offsets = [0] * count
+
+    def knot(self):
+        self.collective(self.tags([KNOT_TAG_SIZE] * len(self.pistons)), False)
+
+    def wrap(self, plaintext, ad, forget=False):
+        """Returns the ciphertext and the tag of a message."""
+        count = len(self.pistons)
+        input = Stream(plaintext)
+        ad = Stream(ad)
+        output = bytearray()
+        while input.remaining() or ad.remaining():
+            crypting = input.remaining() > 0
+            if crypting:
+                for piston, offset in zip(self.pistons, self.offsets):
+                    piston.crypt(input, output, offset, False)
+            for piston in self.pistons:
+                piston.inject(ad, crypting)
+            if input.remaining() or ad.remaining():
+                self.spark(False, [0] * count)
+        if count > 1 or forget:
+            self.knot()
+        return bytes(output), self.tags([TAG_SIZE] + [0] * (count - 1))
+
+
+def show(title, data):
+    print('// ' + title)
+    print(c_string(data, '     '))
+
+
+if __name__ == '__main__':
+    for piston_count in (1, 2, 4, 8):
+        keyak = Keyak(piston_count, ptn(16), ptn(12))
+        ciphertext, tag1 = keyak.wrap(ptn(1000), ptn(300))
+        _, tag2 = keyak.wrap(ptn(20), b'')
+        print('// %d piston(s)' % piston_count)
+        show('start tag', keyak.start_tag)
+        show('last 16 bytes of the ciphertext', ciphertext[-16:])
+        show('tag of the first message', tag1)
+        show('tag of the second message', tag2)
+
+    show('Lake Keyak without a start tag',
+         Keyak(1, ptn(16), ptn(12), False).wrap(ptn(1000), ptn(300))[1])
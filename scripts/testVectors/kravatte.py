@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+#
+# Prints the expected values of Tests/testKravatte.c, computed with a model
+# of Kravatte written from its specification, the Farfalle construction on
+# Keccak-p[1600, 6] with the rollc and rolle rolling functions.
+
+from keccak import MASK64, bytes_to_lanes, c_string, keccak_p, lanes_to_bytes
+from keccak import ptn, rol64, xor
+
+WIDTH = 200
+
+
+def roll_c(k):
+    lanes = bytes_to_lanes(k)
+    x = lanes[20:25]
+    x0 = rol64(x[0], 7) ^ x[1] ^ (x[1] >> 3)
+    return lanes_to_bytes(lanes[:20] + x[1:] + [x0])
+
+
+def roll_e(y):
+    lanes = bytes_to_lanes(y)
+    x = lanes[15:25]
+    x0 = rol64(x[0], 7) ^ rol64(x[1], 18) ^ (x[2] & (x[1] >> 1))
+    return lanes_to_bytes(lanes[:15] + x[1:] + [x0 & MASK64])
+
+
+def pad(data):
+    """Appends the 10* padding up to a multiple of the width."""
+    data += b'\x01'
+    return data + bytes(-len(data) % WIDTH)
+
+
+def kravatte(key, strings, length):
+    """Kravatte(K)(strings), with the strings in the order they are
+    compressed, and `length` output bytes."""
+    mask = keccak_p(pad(key), 6)
+    x = bytes(WIDTH)
+    for string in strings:
+        blocks = pad(string)
+        for i in range(0, len(blocks), WIDTH):
+            x = xor(x, keccak_p(xor(blocks[i:i + WIDTH], mask), 6))
+            mask = roll_c(mask)
+        mask = roll_c(mask)
+    y = keccak_p(x, 6)
+    output = b''
+    while len(output) < length:
+        output += xor(keccak_p(y, 6), mask)
+        y = roll_e(y)
+    return output[:length]
+
+
+def show(title, data):
+    print('// ' + title)
+    print(c_string(data, '    '))
+
+
+if __name__ == '__main__':
+    show('Kravatte(K=ptn(16), M=empty)', kravatte(ptn(16), [b''], 32))
+    show('Kravatte(K=ptn(32), M=ptn(1000)), last 32 bytes of 1000',
+         kravatte(ptn(32), [ptn(1000)], 1000)[-32:])
+    show('Kravatte(K=ptn(32), M=ptn(3) o ptn(200)), last 32 bytes of 1000',
+         kravatte(ptn(32), [ptn(200), ptn(3)], 1000)[-32:])
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+#
+# Prints the expected values of Tests/testSpongeWrap.c, computed with a model
+# of SpongeWrap on the Keccak[r, c] duplex construction, written from the
+# duplex paper. The first duplexing call on a fresh state is SHA-3 when given
+# the SHA-3 suffix, which checks the duplex model against hashlib.
+
+import hashlib
+
+from keccak import c_string, keccak_p, ptn, xor
+
+
+class Duplex:
+    def __init__(self, rate):
+        self.rate = rate  # in bits, a multiple of 8
+        self.state = bytes(200)
+
+    def duplexing(self, sigma, delimited_suffix, length):
+        """Absorbs sigma followed by the delimited suffix and the pad10*1
+        rule, then returns the first `length` bytes of the state."""
+        block = bytearray(sigma) + bytes([delimited_suffix])
+        block += bytes(self.rate // 8 - len(block))
+        block[-1] ^= 0x80
+        self.state = keccak_p(xor(self.state, block))
+        return self.state[:length]
+
+
+def blocks(data, block_size):
+    """Splits data into blocks, with at least one (empty) block."""
+    if not data:
+        return [b'']
+    return [data[i:i + block_size] for i in range(0, len(data), block_size)]
+
+
+class SpongeWrap:
+    def __init__(self, rate, key):
+        self.duplex = Duplex(rate)
+        self.block_size = (rate - 3) // 8
+        key_blocks = blocks(key, self.block_size)
+        for block in key_blocks[:-1]:
+            self.duplex.duplexing(block, 0x03, 0)
+        self.duplex.duplexing(key_blocks[-1], 0x02, 0)
+
+    def wrap(self, ad, plaintext, tag_length):
+        """Returns the ciphertext and the tag of a message."""
+        ad_blocks = blocks(ad, self.block_size)
+        plaintext_blocks = blocks(plaintext, self.block_size)
+        for block in ad_blocks[:-1]:
+            self.duplex.duplexing(block, 0x02, 0)
+        last = ad_blocks[-1]
+        ciphertext = b''
+        for block in plaintext_blocks:
+            key_stream = self.duplex.duplexing(last, 0x03, len(block))
+            ciphertext += xor(block, key_stream)
+            last = block
+        tag = self.duplex.duplexing(last, 0x02, self.block_size)
+        while len(tag) < tag_length:
+            tag += self.duplex.duplexing(b'', 0x02, self.block_size)
+        return ciphertext, tag[:tag_length]
+
+
+def self_check():
+    message = ptn(100)
+    assert (Duplex(1088).duplexing(message, 0x06, 32) ==
+            hashlib.sha3_256(message).digest())
+    assert (Duplex(1344).duplexing(message, 0x1F, 168) ==
+            hashlib.shake_128(message).digest(168))
+
+
+def show(title, data):
+    print('// ' + title)
+    print(c_string(data, '              ', 8))
+
+
+if __name__ == '__main__':
+    self_check()
+
+    wrap = SpongeWrap(1344, ptn(16))
+    ciphertext, tag = wrap.wrap(ptn(30), ptn(500), 16)
+    show('r=1344, K=ptn(16), A=ptn(30), B=ptn(500): last 16 bytes of C',
+         ciphertext[-16:])
+    show('r=1344, K=ptn(16), A=ptn(30), B=ptn(500): T', tag)
+    _, tag = wrap.wrap(b'', b'', 200)
+    show('Same session, A=empty, B=empty: last 16 bytes of a 200-byte T',
+         tag[-16:])
+
+    wrap = SpongeWrap(1088, ptn(200))
+    ciphertext, tag = wrap.wrap(ptn(300), ptn(135), 16)
+    show('r=1088, K=ptn(200), A=ptn(300), B=ptn(135): last 16 bytes of C',
+         ciphertext[-16:])
+    show('r=1088, K=ptn(200), A=ptn(300), B=ptn(135): T', tag)
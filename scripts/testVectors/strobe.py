@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Prints the expected values of Tests/testStrobe.c, computed with a model of
+# STROBE v1.0.2 on Keccak-f[1600] written from its specification. The first
+# two values are also the conformance values of the Merlin library.
+
+from keccak import c_string, keccak_p, ptn
+
+FLAG_I, FLAG_A, FLAG_C, FLAG_T, FLAG_M, FLAG_K = 1, 2, 4, 8, 16, 32
+
+AD = FLAG_A
+KEY = FLAG_A | FLAG_C
+PRF = FLAG_I | FLAG_A | FLAG_C
+SEND_CLR = FLAG_A | FLAG_T
+SEND_ENC = FLAG_A | FLAG_C | FLAG_T
+SEND_MAC = FLAG_C | FLAG_T
+RATCHET = FLAG_C
+
+
+class Strobe:
+    def __init__(self, protocol, security=128):
+        self.rate = 200 - security // 4 - 2
+        state = bytearray(200)
+        state[0:6] = bytes([1, self.rate + 2, 1, 0, 1, 96])
+        state[6:18] = b'STROBEv1.0.2'
+        self.state = bytearray(keccak_p(bytes(state)))
+        self.position = 0
+        self.begin = 0
+        self.flags = 0
+        self.initiator = None
+        self.operate(FLAG_M | AD, protocol)
+
+    def run_f(self):
+        self.state[self.position] ^= self.begin
+        self.state[self.position + 1] ^= 0x04
+        self.state[self.rate + 1] ^= 0x80
+        self.state = bytearray(keccak_p(bytes(self.state)))
+        self.position = 0
+        self.begin = 0
+
+    def duplex(self, data, c_before, c_after, force_f=False):
+        data = bytearray(data)
+        for i in range(len(data)):
+            if c_before:
+                data[i] ^= self.state[self.position]
+            self.state[self.position] ^= data[i]
+            if c_after:
+                data[i] = self.state[self.position]
+            self.position += 1
+            if self.position == self.rate:
+                self.run_f()
+        if force_f and self.position != 0:
+            self.run_f()
+        return bytes(data)
+
+    def operate(self, flags, data, more=False):
+        """Returns the output of the operation, or its input for those
+        without output."""
+        if more:
+            assert flags == self.flags
+        else:
+            adjusted = flags
+            if flags & FLAG_T:
+                if self.initiator is None:
+                    self.initiator = flags & FLAG_I
+                adjusted ^= self.initiator
+            old_begin = self.begin
+            self.begin = self.position + 1
+            self.flags = flags
+            self.duplex(bytes([old_begin, adjusted]), False, False,
+                        (flags & (FLAG_C | FLAG_K)) != 0)
+        c_after = (flags & (FLAG_C | FLAG_I | FLAG_T)) == (FLAG_C | FLAG_T)
+        c_before = bool(flags & FLAG_C) and not c_after
+        return self.duplex(data, c_before, c_after)
+
+
+def show(title, data):
+    print('// ' + title)
+    print(c_string(data, '              '))
+
+
+if __name__ == '__main__':
+    strobe = Strobe(b'Conformance Test Protocol')
+    strobe.operate(FLAG_M | AD, b'ms')
+    strobe.operate(FLAG_M | AD, b'g', True)
+    strobe.operate(AD, bytes([99]) * 1024)
+    strobe.operate(FLAG_M | AD, b'prf')
+    prf = strobe.operate(PRF, bytes(32))
+    show('PRF', prf)
+    strobe.operate(FLAG_M | AD, b'key')
+    strobe.operate(KEY, prf)
+    strobe.operate(FLAG_M | AD, b'prf')
+    show('PRF after KEY', strobe.operate(PRF, bytes(32)))
+
+    strobe = Strobe(b'Transcript test', 256)
+    strobe.operate(KEY, ptn(32))
+    strobe.operate(FLAG_M | AD, b'msg')
+    show('sendENC, last 16 bytes', strobe.operate(SEND_ENC, ptn(300))[-16:])
+    strobe.operate(SEND_CLR, ptn(7))
+    show('sendMAC', strobe.operate(SEND_MAC, bytes(16)))
+    strobe.operate(RATCHET, bytes(10))
+    show('PRF', strobe.operate(PRF, bytes(32)))